@@ -4794,6 +4794,15 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		bo = new BoolOption (
+				"graph-work-stealing",
+				_("Use per-thread work queues for signal processing"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_work_stealing),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_work_stealing)
+				);
+		set_tooltip (bo->tip_widget(), _("When enabled, each DSP thread keeps the routes that it activates in a local queue and idle threads steal work from busy ones. This can reduce contention in large sessions on many-core systems."));
+		add_option (_("Performance"), bo);
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -4906,6 +4915,24 @@ These settings will only take effect after %1 is restarted.\n\
 
 	add_option (_("Performance"), new BufferingOptions (_rc_config));
 
+	if (hwcpus > 1) {
+		ComboOption<uint32_t>* bio = new ComboOption<uint32_t> (
+				"butler-io-threads",
+				_("Disk I/O threads"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_butler_io_threads),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_butler_io_threads)
+				);
+
+		bio->add (0, _("single thread"));
+		for (uint32_t i = 2; i <= 16; i *= 2) {
+			bio->add (i, string_compose (P_("%1 thread", "%1 threads", i), i));
+		}
+
+		set_tooltip (bio->tip_widget(), _("Number of threads used to concurrently read and write track data. Multiple threads can help to saturate fast storage (e.g. NVMe) with large sessions."));
+		bio->set_note (_("This setting will only take effect when the session is reloaded."));
+		add_option (_("Performance"), bio);
+	}
+
 	/* Image cache size */
 	add_option (_("Performance"), new OptionEditorHeading (_("Memory Usage")));
 
@@ -4974,6 +5001,18 @@ These settings will only take effect after %1 is restarted.\n\
 	                                   "or a regular MIDI device capable of sending sequential note numbers (like a typical keyboard)"));
 	add_option (_("Triggering"), dtip);
 
+	SpinOption<uint32_t>* cmt = new SpinOption<uint32_t> (
+		     "clip-mmap-threshold",
+		     _("Memory-map clips longer than (seconds)"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_clip_mmap_threshold),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_clip_mmap_threshold),
+		     0, 3600, 1, 10
+		     );
+	set_tooltip (cmt->tip_widget(), _("Clips in trigger slots are played from memory, and shared by all slots using them. "
+	                                  "Clips longer than this are kept in a memory-mapped file in the session's cache folder instead of on the heap. "
+	                                  "0 keeps all clips on the heap."));
+	add_option (_("Triggering"), cmt);
+
 	add_option (_("Triggering"), new OptionEditorHeading (_("Clip Library")));
 
 	add_option (_("Triggering"), new DirectoryOption (
@@ -33,6 +33,7 @@
 #include "ardour/gain_control.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/rc_configuration.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/session.h"
 
 #include "pbd/i18n.h"
@@ -176,13 +177,7 @@ Amp::apply_gain (BufferSet& bufs, samplecnt_t sample_rate, samplecnt_t nframes,
 	const gain_t a = 156.825f / (gain_t)sample_rate; // 25 Hz LPF
 
 	for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
-		Sample* const buffer = i->data();
-		double lpf = initial;
-
-		for (pframes_t nx = 0; nx < nframes; ++nx) {
-			buffer[nx] *= lpf;
-			lpf += a * (target - lpf);
-		}
+		gain_t lpf = apply_gain_ramp (i->data(), nframes, initial, target, a);
 		if (i == bufs.audio_begin()) {
 			rv = lpf;
 		}
@@ -258,11 +253,7 @@ Amp::apply_gain (AudioBuffer& buf, samplecnt_t sample_rate, samplecnt_t nframes,
 	Sample* const buffer = buf.data (offset);
 	const gain_t a = 156.825f / (gain_t)sample_rate; // 25 Hz LPF, see [other] Amp::apply_gain() above for details
 
-	gain_t lpf = initial;
-	for (pframes_t nx = 0; nx < nframes; ++nx) {
-		buffer[nx] *= lpf;
-		lpf += a * (target - lpf);
-	}
+	gain_t lpf = apply_gain_ramp (buffer, nframes, initial, target, a);
 
 	if (fabsf (lpf - target) < GAIN_COEFF_DELTA) return target;
 	return lpf;
@@ -308,7 +299,11 @@ Amp::apply_simple_gain (BufferSet& bufs, samplecnt_t nframes, gain_t target, boo
 		}
 
 		for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
-			apply_gain_to_buffer (i->data(), nframes, target);
+			if (target == -GAIN_COEFF_UNITY) {
+				invert_polarity (i->data(), nframes);
+			} else {
+				apply_gain_to_buffer (i->data(), nframes, target);
+			}
 		}
 	}
 }
@@ -318,6 +313,8 @@ Amp::apply_simple_gain (AudioBuffer& buf, samplecnt_t nframes, gain_t target, sa
 {
 	if (fabsf (target) < GAIN_COEFF_SMALL) {
 		memset (buf.data (offset), 0, sizeof (Sample) * nframes);
+	} else if (target == -GAIN_COEFF_UNITY) {
+		invert_polarity (buf.data (offset), nframes);
 	} else if (target != GAIN_COEFF_UNITY) {
 		apply_gain_to_buffer (buf.data(offset), nframes, target);
 	}
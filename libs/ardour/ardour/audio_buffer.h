@@ -143,7 +143,11 @@ public:
 		Sample* const       dst_raw = _data + dst_offset;
 		const Sample* const src_raw = src.data () + src_offset;
 
-		mix_buffers_with_gain (dst_raw, src_raw, len, gain_coeff);
+		if (gain_coeff == -1.f) {
+			mix_buffers_inverted (dst_raw, src_raw, len);
+		} else {
+			mix_buffers_with_gain (dst_raw, src_raw, len, gain_coeff);
+		}
 
 		_silent  = ((src.silent () && _silent) || (_silent && gain_coeff == 0));
 		_written = true;
@@ -159,7 +163,11 @@ public:
 
 		Sample* const dst_raw = _data + dst_offset;
 
-		mix_buffers_with_gain (dst_raw, src_raw, len, gain_coeff);
+		if (gain_coeff == -1.f) {
+			mix_buffers_inverted (dst_raw, src_raw, len);
+		} else {
+			mix_buffers_with_gain (dst_raw, src_raw, len, gain_coeff);
+		}
 
 		_silent  = (_silent && gain_coeff == 0);
 		_written = true;
@@ -177,15 +185,9 @@ public:
 			return;
 		}
 
-		Sample* dst        = _data + dst_offset;
-		gain_t  gain_delta = (target - initial) / len;
+		mix_buffers_with_gain_ramp (_data + dst_offset, src, len, initial, target);
 
-		for (samplecnt_t n = 0; n < len; ++n) {
-			*dst++ += (*src++ * initial);
-			initial += gain_delta;
-		}
-
-		_silent  = (_silent && initial == 0 && target == 0);
+		_silent  = false;
 		_written = true;
 	}
 
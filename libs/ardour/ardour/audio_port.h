@@ -62,11 +62,18 @@ protected:
 	/* special access for PortManager only (hah, C++) */
 	Sample* engine_get_whole_audio_buffer ();
 
+	/* cycle_start() for an input port with the same connections as
+	 * \p src, re-use the data that \p src resampled in this cycle
+	 */
+	void cycle_start_shared (pframes_t, AudioPort const& src);
+
 private:
 	AudioBuffer*            _buffer;
 	ArdourZita::VMResampler _src;
 	Sample*                 _data;
 	bool                    _buf_valid;
+	bool                    _src_stale;
+	uint32_t                _shared_src_cycle; // set by PortManager
 };
 
 } // namespace ARDOUR
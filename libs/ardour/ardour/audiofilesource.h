@@ -30,6 +30,8 @@
 
 namespace ARDOUR {
 
+class ReadAhead;
+
 struct LIBARDOUR_API SoundFileInfo {
 	float       samplerate;
 	uint16_t    channels;
@@ -57,6 +59,12 @@ public:
 	virtual void      clear_capture_marks() {}
 	virtual bool      one_of_several_channels () const { return false; }
 
+	/** Drop written data from the page-cache once it is on disk (capture) */
+	virtual void set_write_behind (bool) {}
+
+	/** Add the file range that holds samples [start, start + cnt) to \a ra */
+	virtual void read_ahead (ReadAhead& /*ra*/, samplepos_t /*start*/, samplecnt_t /*cnt*/) const {}
+
 	virtual void flush () = 0;
 	virtual int update_header (samplepos_t when, struct tm&, time_t) = 0;
 	virtual int flush_header () = 0;
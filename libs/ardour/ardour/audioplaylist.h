@@ -34,6 +34,7 @@ class Session;
 class AudioRegion;
 class Source;
 class AudioPlaylist;
+class ReadAhead;
 
 class LIBARDOUR_API AudioPlaylist : public ARDOUR::Playlist
 {
@@ -45,6 +46,9 @@ public:
 
 	timecnt_t read (Sample *dst, Sample *mixdown, float *gain_buffer, timepos_t const & start, timecnt_t const & cnt, uint32_t chan_n=0);
 
+	/** Add the file ranges that read() would access to \a ra */
+	void read_ahead (ReadAhead& ra, timepos_t const & start, timecnt_t const & cnt, uint32_t chan_n=0);
+
 	bool destroy_region (std::shared_ptr<Region>);
 
 protected:
@@ -60,6 +60,7 @@ class Playlist;
 class Session;
 class Filter;
 class AudioSource;
+class ReadAhead;
 
 
 class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
@@ -127,6 +128,8 @@ class LIBARDOUR_API AudioRegion : public Region, public AudioReadable
 
 	samplecnt_t read_raw_internal (Sample*, samplepos_t, samplecnt_t, int channel) const;
 
+	void read_ahead (ReadAhead&, samplepos_t position, samplecnt_t cnt, uint32_t chan_n = 0) const;
+
 	XMLNode& state () const;
 	XMLNode& get_basic_state () const;
 	int set_state (const XMLNode&, int version);
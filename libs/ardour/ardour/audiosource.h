@@ -23,6 +23,7 @@
 #ifndef __ardour_audio_source_h__
 #define __ardour_audio_source_h__
 
+#include <atomic>
 #include <memory>
 
 #include <boost/shared_array.hpp>
@@ -97,10 +98,15 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	int prepare_for_peakfile_writes ();
 	void done_with_peakfile_writes (bool done = true);
 
+	/** (Re)build the peak mipmap, called by the peak building threads */
+	int  build_peak_mip () const;
+
 	/** @return true if the each source sample s must be clamped to -1 < s < 1 */
 	virtual bool clamped_at_unity () const = 0;
 
   protected:
+	void remove_peak_mip () const;
+
 	static bool _build_missing_peakfiles;
 	static bool _build_peakfiles;
 
@@ -158,6 +164,16 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable boost::scoped_array<PeakData> peak_cache;
+
+	/* Reduced resolution copies of the peakfile, at 2^k times its
+	 * samples-per-peak, used to serve zoomed out views.
+	 */
+	mutable Glib::Threads::Mutex _peak_mip_lock;
+	mutable std::atomic<bool>    _peak_mip_queued;
+
+	std::string peak_mip_path () const;
+	int  read_peaks_from_mip (PeakData *peaks, samplecnt_t npeaks, samplecnt_t read_npeaks,
+	                          samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const;
 };
 
 }
@@ -24,6 +24,7 @@
 #define __ardour_butler_h__
 
 #include <atomic>
+#include <vector>
 
 #include <pthread.h>
 
@@ -33,6 +34,7 @@
 #include "pbd/pool.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/mpmc_queue.h"
+#include "pbd/pthread_utils.h"
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/session_handle.h"
@@ -40,6 +42,10 @@
 
 namespace ARDOUR
 {
+class CaptureWriter;
+class ReadAhead;
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -82,6 +88,18 @@ public:
 		return _midi_buffer_size;
 	}
 
+	/** thread-pool used by DiskWriters to write captured audio, may be NULL */
+	CaptureWriter* capture_writer () const
+	{
+		return _capture_writer;
+	}
+
+	/** read-ahead for DiskReaders, may be NULL. butler thread only */
+	ReadAhead* read_ahead () const
+	{
+		return _read_ahead;
+	}
+
 	mutable std::atomic<int> should_do_transport_work;
 
 private:
@@ -101,9 +119,46 @@ private:
 	void empty_pool_trash ();
 	void process_delegated_work ();
 	void config_changed (std::string);
+	bool refill_tracks (RouteList const&);
 	bool flush_tracks_to_disk_normal (std::shared_ptr<RouteList const>, uint32_t& errors);
 	void queue_request (Request::Type r);
 
+	/* disk I/O worker pool */
+	struct IOJob {
+		enum Type {
+			Refill,
+			Flush
+		};
+
+		IOJob (std::shared_ptr<Track> t, Type y)
+			: track (t)
+			, type (y)
+		{}
+
+		std::shared_ptr<Track> track;
+		Type                   type;
+	};
+
+	void start_io_threads (uint32_t);
+	void stop_io_threads ();
+	void io_thread_work ();
+	bool run_io_jobs (std::vector<IOJob>&, uint32_t& errors);
+	void process_io_job (IOJob const&);
+
+	std::vector<PBD::Thread*> _io_threads;
+	std::vector<IOJob>        _io_jobs;
+	size_t                    _io_next;
+	size_t                    _io_pending;
+	bool                      _io_run;
+	std::atomic<bool>         _io_work_outstanding;
+	std::atomic<uint32_t>     _io_errors;
+	Glib::Threads::Mutex      _io_lock;
+	Glib::Threads::Cond       _io_cond;
+	Glib::Threads::Cond       _io_done;
+
+	CaptureWriter* _capture_writer;
+	ReadAhead*     _read_ahead;
+
 	pthread_t thread;
 	bool      have_thread;
 
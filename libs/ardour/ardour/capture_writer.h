@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_capture_writer_h__
+#define __ardour_capture_writer_h__
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "pbd/ringbufferNPT.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace PBD {
+	class Thread;
+}
+
+namespace ARDOUR {
+
+class AudioFileSource;
+
+/** A pool of threads that write captured audio to disk.
+ *
+ * The butler queues the data of all channels of a track as one batch
+ * and continues with other tracks, the chunks are written concurrently.
+ * Once a chunk is written, the capture ringbuffer's read-pointer is
+ * advanced, so the ringbuffer sizing is not affected.
+ *
+ * A DiskWriter only queues a new batch once the previous one completed.
+ * Requests share ownership of the source and the ringbuffer, so a
+ * DiskWriter can replace either (e.g. when its I/O configuration
+ * changes) without waiting for the batch.
+ */
+class LIBARDOUR_API CaptureWriter
+{
+public:
+	CaptureWriter (uint32_t n_threads);
+	~CaptureWriter ();
+
+	struct Request {
+		Request (std::shared_ptr<AudioFileSource> s, std::shared_ptr<PBD::RingBufferNPT<Sample> > rb)
+			: source (s)
+			, wbuf (rb)
+			, pending (0)
+			, error (0)
+		{
+			buf[0] = buf[1] = 0;
+			len[0] = len[1] = 0;
+		}
+
+		std::shared_ptr<AudioFileSource>             source;
+		std::shared_ptr<PBD::RingBufferNPT<Sample> > wbuf;
+		Sample*                                      buf[2];
+		samplecnt_t                                  len[2];
+
+		std::atomic<int>* pending;
+		std::atomic<int>* error;
+	};
+
+	uint32_t n_threads () const { return _threads.size (); }
+
+	/** Queue a batch of writes, \a pending is incremented for each
+	 * request and decremented when it is complete, \a error is set
+	 * if a write fails.
+	 */
+	void queue (std::vector<Request>&, std::atomic<int>& pending, std::atomic<int>& error);
+
+	/** Wait until \a pending is zero */
+	void wait (std::atomic<int>& pending);
+
+private:
+	void thread_work ();
+
+	std::vector<PBD::Thread*> _threads;
+	std::deque<Request>       _requests;
+	bool                      _run;
+	Glib::Threads::Mutex      _lock;
+	Glib::Threads::Cond       _cond;
+	Glib::Threads::Cond       _done;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_capture_writer_h__ */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __libardour_clip_sample_cache_h__
+#define __libardour_clip_sample_cache_h__
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioRegion;
+
+/** Shared, reference-counted sample data of clips used by triggers.
+ *
+ * AudioTriggers play from memory. The same clip is often loaded into
+ * many slots, so the data of each region channel is kept here, keyed
+ * by source and range, and shared by all triggers using it. An entry is
+ * freed when the last trigger referencing it lets go of it.
+ *
+ * Clips longer than Config->get_clip_mmap_threshold() seconds are
+ * written to an unlinked file in the session's cache folder and
+ * memory-mapped instead of being kept on the heap. Since triggers read
+ * the data from the process thread, the mapping is locked in memory,
+ * or at least paged in, while the clip is in use.
+ */
+class LIBARDOUR_API ClipSampleCache
+{
+public:
+	class LIBARDOUR_API Entry
+	{
+	public:
+		~Entry ();
+
+		Sample const* data () const { return _data; }
+		samplecnt_t   length () const { return _length; }
+		bool          mapped () const { return _mapped; }
+
+	private:
+		friend class ClipSampleCache;
+		Entry ();
+
+		int  load (std::shared_ptr<AudioRegion const>, uint32_t chn, bool use_mmap);
+		int  load_mapped (std::shared_ptr<AudioRegion const>, uint32_t chn);
+		void release ();
+
+		Glib::Threads::Mutex _lock;
+		Sample*              _data;
+		samplecnt_t          _length;
+		size_t               _map_size;
+		bool                 _mapped;
+		bool                 _loaded;
+	};
+
+	typedef std::shared_ptr<Entry> EntryPtr;
+
+	static ClipSampleCache& instance ();
+
+	/** @return the raw data of channel \p chn of the given region,
+	 * reading it if it is not yet cached. Not RT safe.
+	 */
+	EntryPtr get (std::shared_ptr<AudioRegion const>, uint32_t chn);
+
+	/** number of distinct clip channels currently in use */
+	size_t n_entries () const;
+	/** size of sample data held, in bytes (heap and mapped) */
+	size_t bytes () const;
+
+private:
+	ClipSampleCache () {}
+
+	/* source, start, length */
+	struct Key {
+		Key (PBD::ID const& i, samplepos_t s, samplecnt_t l) : id (i), start (s), length (l) {}
+
+		PBD::ID     id;
+		samplepos_t start;
+		samplecnt_t length;
+
+		bool operator< (Key const& other) const {
+			if (id != other.id) {
+				return id < other.id;
+			}
+			if (start != other.start) {
+				return start < other.start;
+			}
+			return length < other.length;
+		}
+	};
+
+	typedef std::map<Key, std::weak_ptr<Entry> > EntryMap;
+
+	void prune ();
+
+	mutable Glib::Threads::Mutex _lock;
+	EntryMap                     _entries;
+};
+
+} /* namespace */
+
+#endif /* __libardour_clip_sample_cache_h__ */
@@ -36,6 +36,16 @@ public:
 	Convolution (Session&, uint32_t n_in, uint32_t n_out);
 	virtual ~Convolution () {}
 
+	/** Latency/CPU tradeoff of threaded convolution (Convolver).
+	 * The head partition is always processed in the calling (RT) thread,
+	 * a larger quantum adds latency but needs fewer, larger FFTs.
+	 */
+	enum Partitioning {
+		LowLatency, ///< 64 samples quantum
+		Balanced,   ///< 256 samples quantum
+		LowCPU      ///< 1024 samples quantum
+	};
+
 	bool add_impdata (
 	    uint32_t                    c_in,
 	    uint32_t                    c_out,
@@ -53,6 +63,15 @@ public:
 
 	void clear_impdata ();
 	void restart ();
+
+	/* Threaded mode only. Changing either restarts the convolver,
+	 * latency () needs to be re-queried.
+	 */
+	void set_partitioning (Partitioning);
+	void set_tail_threads (uint32_t); ///< number of threads for the longest partitions, 0: auto
+
+	Partitioning partitioning () const { return _partitioning; }
+	uint32_t     tail_threads () const { return _tail_threads; }
 	void run (BufferSet&, ChanMapping const&, ChanMapping const&, pframes_t, samplecnt_t);
 
 	void run_mono_buffered (float*, uint32_t);
@@ -67,6 +86,9 @@ protected:
 	bool     _configured;
 	bool     _threaded;
 
+	Partitioning _partitioning;
+	uint32_t     _tail_threads;
+
 private:
 	class ImpData : public AudioReadable
 	{
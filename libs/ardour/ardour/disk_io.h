@@ -23,6 +23,7 @@
 #include <vector>
 #include <string>
 #include <exception>
+#include <memory>
 
 #include "pbd/ringbufferNPT.h"
 #include "pbd/rcu.h"
@@ -157,8 +158,9 @@ protected:
 
 		/** A ringbuffer for data to be recorded back, written to in the
 		 * process thread, read from in the butler thread.
+		 * Shared with pending CaptureWriter requests.
 		 */
-		PBD::RingBufferNPT<Sample>* wbuf;
+		std::shared_ptr<PBD::RingBufferNPT<Sample> > wbuf;
 		PBD::RingBufferNPT<Sample>::rw_vector rw_vector;
 
 		/* used only by capture */
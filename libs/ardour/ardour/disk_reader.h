@@ -35,6 +35,7 @@ namespace ARDOUR
 class Playlist;
 class AudioPlaylist;
 class MidiPlaylist;
+class ReadAhead;
 
 template <typename T> class MidiRingBuffer;
 
@@ -90,12 +91,23 @@ public:
 	static void allocate_working_buffers ();
 	static void free_working_buffers ();
 
+	/* Working buffers for do_refill, private to the calling thread
+	 * (butler disk I/O threads). They are freed when the thread terminates.
+	 */
+	static void allocate_thread_working_buffers ();
+
 	void adjust_buffering ();
 
 	bool can_internal_playback_seek (sampleoffset_t distance);
 	void internal_playback_seek (sampleoffset_t distance);
 	int  seek (samplepos_t sample, bool complete_refill = false);
 
+	/** Add the file ranges that the next do_refill() will read to \a ra,
+	 * or if \a seek_to is given, the ranges that seek (*seek_to, true)
+	 * will read (butler thread).
+	 */
+	void read_ahead (ReadAhead& ra, boost::optional<samplepos_t> seek_to = boost::none);
+
 	static PBD::Signal0<void> Underrun;
 
 	void playlist_modified ();
@@ -175,7 +187,6 @@ protected:
 
 	private:
 		float _a;
-		float _l;
 		float _g;
 	};
 
@@ -163,6 +163,7 @@ private:
 	void check_record_status (samplepos_t transport_sample, double speed, bool can_record);
 	void finish_capture (std::shared_ptr<ChannelList const> c);
 	void reset_capture ();
+	void wait_for_pending_writes ();
 
 	void loop (samplepos_t);
 
@@ -193,6 +194,10 @@ private:
 	std::atomic<int> _samples_pending_write;
 	std::atomic<int> _num_captured_loops;
 
+	/* audio writes queued with the butler's CaptureWriter */
+	std::atomic<int> _writes_pending;
+	std::atomic<int> _write_error;
+
 	std::shared_ptr<SMFSource> _midi_write_source;
 
 	std::list<std::shared_ptr<Source> >            _last_capture_sources;
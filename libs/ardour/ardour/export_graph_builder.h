@@ -46,6 +46,8 @@ namespace AudioGrapher {
 	template <typename T> class CmdPipeWriter;
 	template <typename T> class SilenceTrimmer;
 	template <typename T> class TmpFile;
+	template <typename T> class TmpMem;
+	class TmpMemBudget;
 	template <typename T> class Threader;
 	template <typename T> class AllocatingProcessContext;
 }
@@ -86,11 +88,25 @@ class LIBARDOUR_API ExportGraphBuilder
 	typedef std::map<ExportChannelPtr, AnyExportPtr> ChannelMap;
 
   public:
+	/** Data of the channels read in the current cycle. This allows
+	 * several graphs, each exporting a different timespan, to share
+	 * the data, since every channel can be read only once per cycle.
+	 */
+	typedef std::map<ExportChannelPtr, Buffer const*> ChannelData;
 
 	ExportGraphBuilder (Session const & session);
 	~ExportGraphBuilder ();
 
 	samplecnt_t process (samplecnt_t samples, bool last_cycle);
+
+	/** Read all channels used by this graph that are not yet in @p data */
+	void read_channels (ChannelData& data, samplecnt_t samples) const;
+	/** Get the offset of aligned data in the current cycle.
+	 * @return false while in latency pre-roll, when there is no data yet.
+	 */
+	bool aligned_offset (samplecnt_t samples, sampleoffset_t& offset) const;
+	/** Process @p cnt samples of previously read data, starting at @p offset */
+	void process (ChannelData const& data, sampleoffset_t offset, samplecnt_t cnt, bool last_cycle);
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
@@ -100,6 +116,10 @@ class LIBARDOUR_API ExportGraphBuilder
 	void cleanup (bool remove_out_files = false);
 	void set_current_timespan (std::shared_ptr<ExportTimespan> span);
 	void add_config (FileSpec const & config, bool rt);
+	/** Memory that intermediates may use for analysis data, shared by
+	 * all graphs of an export. Without a budget, tmp files are used.
+	 */
+	void set_analysis_memory (std::shared_ptr<AudioGrapher::TmpMemBudget> budget) { _analysis_memory = budget; }
 	void get_analysis_results (AnalysisResults& results);
 
 	std::vector<std::string> exported_files () const {
@@ -211,12 +231,16 @@ class LIBARDOUR_API ExportGraphBuilder
 		typedef std::shared_ptr<AudioGrapher::PeakReader> PeakReaderPtr;
 		typedef std::shared_ptr<AudioGrapher::LoudnessReader> LoudnessReaderPtr;
 		typedef std::shared_ptr<AudioGrapher::TmpFile<Sample> > TmpFilePtr;
+		typedef std::shared_ptr<AudioGrapher::TmpMem<Sample> > TmpMemPtr;
 		typedef std::shared_ptr<AudioGrapher::Threader<Sample> > ThreaderPtr;
 		typedef std::shared_ptr<AudioGrapher::AllocatingProcessContext<Sample> > BufferPtr;
 
 		void prepare_post_processing ();
 		void start_post_processing ();
 
+		FloatSinkPtr storage () const;
+		samplecnt_t  samples_stored () const;
+
 		ExportGraphBuilder & parent;
 
 		FileSpec        config;
@@ -226,6 +250,7 @@ class LIBARDOUR_API ExportGraphBuilder
 		BufferPtr       buffer;
 		PeakReaderPtr   peak_reader;
 		TmpFilePtr      tmp_file;
+		TmpMemPtr       tmp_mem; // used instead of tmp_file when not exporting in realtime
 		ThreaderPtr     threader;
 
 		LoudnessReaderPtr    loudness_reader;
@@ -316,6 +341,8 @@ class LIBARDOUR_API ExportGraphBuilder
 	bool        _realtime;
 	samplecnt_t _master_align;
 
+	std::shared_ptr<AudioGrapher::TmpMemBudget> _analysis_memory;
+
 	Glib::ThreadPool     thread_pool;
 	Glib::Threads::Mutex engine_request_lock;
 };
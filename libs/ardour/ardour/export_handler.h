@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <boost/operators.hpp>
 
@@ -39,6 +40,7 @@
 
 namespace AudioGrapher {
 	class BroadcastInfo;
+	class TmpMemBudget;
 }
 
 namespace ARDOUR
@@ -127,6 +129,9 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 
 	void reset ();
 
+	static std::vector<ExportTimespanPtr> batch_timespans (std::vector<ExportTimespanPtr> candidates, ExportTimespanPtr current,
+	                                                       samplecnt_t max_gap, size_t max_size);
+
   private:
 
 	void handle_duplicate_format_extensions();
@@ -152,11 +157,38 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 	int  process_timespan (samplecnt_t samples);
 	int  post_process ();
 	void finish_timespan ();
+	void finalize_timespan (ExportGraphBuilder&);
 
 	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
 	ExportTimespanPtr     current_timespan;
 	TimespanBounds        timespan_bounds;
 
+	/* Several timespans can be exported in a single pass, each using its
+	 * own graph, which is fed the part of every cycle within the timespan.
+	 */
+	struct BatchItem {
+		BatchItem (ExportTimespanPtr ts) : timespan (ts), done (false) {}
+
+		ExportTimespanPtr                   timespan;
+		std::shared_ptr<ExportGraphBuilder> graph_builder;
+		bool                                done;
+	};
+
+	typedef std::vector<BatchItem> Batch;
+
+	bool batchable (ExportTimespanPtr) const;
+	bool collect_batch ();
+	int  start_batch ();
+	int  process_batch (samplecnt_t samples);
+	void finish_batch ();
+
+	Batch                                            batch;
+	samplepos_t                                      batch_end;
+	std::vector<std::shared_ptr<ExportGraphBuilder> > graph_builders;
+
+	/* RAM for analysis data, shared by all graphs of an export */
+	std::shared_ptr<AudioGrapher::TmpMemBudget>      analysis_memory;
+
 	PBD::ScopedConnection process_connection;
 	samplepos_t           process_position;
 
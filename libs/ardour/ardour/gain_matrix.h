@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __libardour_gain_matrix_h__
+#define __libardour_gain_matrix_h__
+
+#include <vector>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class BufferSet;
+
+/** Mixes N inputs to M outputs, for panners.
+ *
+ * Every cycle the caller sets target gains for the input/output pairs
+ * in use, apply() then accumulates all inputs into the outputs,
+ * linearly interpolating from the gains used in the previous cycle.
+ * Pairs that were used before but have no target this cycle are faded
+ * out, so the caller does not need to track which outputs were used.
+ *
+ * apply() works output by output, so each output buffer is only
+ * touched once per cycle, and uses the vectorized mix functions.
+ */
+class LIBARDOUR_API GainMatrix
+{
+public:
+	GainMatrix ();
+
+	/** Resize the matrix and reset all gains to zero, not realtime safe */
+	void configure (uint32_t n_inputs, uint32_t n_outputs);
+
+	uint32_t n_inputs () const  { return _n_inputs; }
+	uint32_t n_outputs () const { return _n_outputs; }
+
+	/** Reset the gains of the previous cycle, the next apply() fades in */
+	void reset ();
+
+	/** Start a new cycle, all target gains are zero */
+	void clear_targets ();
+
+	void set_target (uint32_t in, uint32_t out, gain_t g) {
+		_target[out * _n_inputs + in] = g;
+	}
+
+	/** Accumulate inputs into outputs, the target gains become the current gains */
+	void apply (BufferSet& ibufs, BufferSet& obufs, pframes_t nframes);
+
+private:
+	uint32_t            _n_inputs;
+	uint32_t            _n_outputs;
+	std::vector<gain_t> _current; // [out * n_inputs + in]
+	std::vector<gain_t> _target;  // [out * n_inputs + in]
+};
+
+} // namespace ARDOUR
+
+#endif /* __libardour_gain_matrix_h__ */
@@ -33,6 +33,7 @@
 
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
+#include "pbd/ws_deque.h"
 
 #include "ardour/audio_backend.h"
 #include "ardour/libardour_visibility.h"
@@ -61,12 +62,18 @@ struct GraphChain {
 	~GraphChain ();
 	void dump () const;
 	bool plot (std::string const&) const;
+	void update_critical_path () const;
 
 	node_list_t _nodes_rt;
 	/** Nodes that are not fed by any other nodes */
 	node_list_t _init_trigger_list;
 	/** The number of nodes that do not feed any other node */
 	int _n_terminal_nodes;
+
+	/** All nodes in topological order */
+	std::vector<GraphNode*> _nodes_topo;
+	/** _init_trigger_list, sorted by critical path (longest first) */
+	mutable std::vector<GraphNode*> _init_trigger_order;
 };
 
 class LIBARDOUR_API Graph : public SessionHandleRef
@@ -83,8 +90,21 @@ public:
 	bool     in_process_thread () const;
 	uint32_t n_threads () const;
 
+	/** Scheduler statistics of the most recently completed cycle */
+	struct CycleStats {
+		CycleStats () : steals (0), idle_wakeups (0), max_queue_depth (0), work_stealing (false) {}
+
+		uint32_t steals;          ///< nodes taken from another worker's deque
+		uint32_t idle_wakeups;    ///< number of times a sleeping worker was woken up
+		uint32_t max_queue_depth; ///< maximum number of runnable nodes
+		bool     work_stealing;   ///< true if the cycle used per-thread deques
+	};
+
+	CycleStats cycle_stats () const;
+
 	/* called by GraphNode */
 	void trigger (ProcessNode* n);
+	void trigger (ProcessNode* const* n, size_t cnt);
 	void reached_terminal_node ();
 
 	/* called by virtual GraphNode::process() */
@@ -105,9 +125,18 @@ private:
 	void prep ();
 
 	void helper_thread ();
+	bool find_work (ProcessNode*&);
 
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
-	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
+	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue and all worker-queues
+
+	typedef PBD::WSDeque<ProcessNode*> WorkerQueue;
+
+	/** per thread deques, used in work-stealing mode. [0] is the main thread */
+	std::vector<std::shared_ptr<WorkerQueue> > _worker_queues;
+
+	/** true if the current cycle uses per-thread deques (latched in prep) */
+	bool _work_stealing;
 
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
@@ -122,6 +151,19 @@ private:
 	/** The number of unprocessed nodes that do not feed any other node; updated during processing */
 	std::atomic<uint32_t> _terminal_refcnt;
 
+	/* statistics of the current cycle */
+	std::atomic<uint32_t> _stat_steals;
+	std::atomic<uint32_t> _stat_idle_wakeups;
+	std::atomic<uint32_t> _stat_max_queue_depth;
+
+	/* statistics of the previous cycle */
+	std::atomic<uint32_t> _last_steals;
+	std::atomic<uint32_t> _last_idle_wakeups;
+	std::atomic<uint32_t> _last_max_queue_depth;
+	std::atomic<bool>     _last_work_stealing;
+
+	void update_queue_depth (uint32_t);
+
 	bool _graph_empty;
 
 	/* number of background worker threads >= 0 */
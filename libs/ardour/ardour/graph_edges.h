@@ -47,6 +47,17 @@ public:
 	void add (GraphVertex from, GraphVertex to, bool via_sends_only);
 	void remove (GraphVertex from, GraphVertex to);
 
+	/** Vertices are only tracked to allow incremental updates,
+	 *  they are not required for any of the edge lookups.
+	 */
+	void add_vertex (GraphVertex v) { _vertices.insert (v); }
+	/** Remove the vertex and all edges to and from it */
+	void remove_vertex (GraphVertex);
+	/** Remove all edges to and from the vertex, but keep the vertex */
+	void remove_edges_of (GraphVertex);
+	bool has_vertex (GraphVertex v) const { return _vertices.find (v) != _vertices.end (); }
+	std::set<GraphVertex> const& vertices () const { return _vertices; }
+
 	bool has (GraphVertex from, GraphVertex to, bool* via_sends_only);
 	bool feeds (GraphVertex from, GraphVertex to) const;
 	/** @return the vertices that are directly fed from `r' */
@@ -54,6 +65,10 @@ public:
 	/** @return all nodes that feed `r' (`r` is fed-by rv) */
 	std::set<GraphVertex> to (GraphVertex r, bool via_sends_only = false) const;
 	bool has_none_to (GraphVertex to) const;
+	/** @return true if there is a path from `from' to `to' */
+	bool reachable (GraphVertex from, GraphVertex to) const;
+	/** @return true if both graphs have the same edges, ignoring via-send flags */
+	bool same_edges (GraphEdges const& other) const { return _from_to == other._from_to; }
 	bool empty () const;
 	void dump () const;
 
@@ -78,9 +93,19 @@ private:
 	 */
 	EdgeMapWithSends _from_to_with_sends;
 	EdgeMapWithSends _to_from_with_sends;
+
+	std::set<GraphVertex> _vertices;
 };
 
-bool topological_sort (GraphNodeList&, GraphEdges&);
+LIBARDOUR_API bool topological_sort (GraphNodeList&, GraphEdges&);
+
+/** Update the edges of a previous sort and sort again.
+ *  @param edges the graph of the previous (successful) sort, updated in place.
+ *  @param dirty vertices whose connections may have changed since.
+ *  Vertices of \a nodes which are not yet in \a edges are evaluated as well,
+ *  vertices of \a edges which are no longer in \a nodes are removed.
+ */
+LIBARDOUR_API bool topological_sort (GraphNodeList&, GraphEdges&, std::set<GraphVertex> const& dirty);
 
 }
 
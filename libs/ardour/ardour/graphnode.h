@@ -85,8 +85,18 @@ public:
 
 	virtual bool direct_feeds_according_to_reality (std::shared_ptr<GraphNode>, bool* via_send_only = 0) = 0;
 
+	/* DSP cost profile */
+
+	/** moving average of the time spent in process(), in usec */
+	float dsp_cost_avg () const { return _cost_avg.load (std::memory_order_relaxed); }
+	/** sum of the average cost of this node and the most expensive
+	 * chain of downstream nodes that depend on it, in usec */
+	float critical_path () const { return _critical_path.load (std::memory_order_relaxed); }
+
+	void set_critical_path (float cp) { _critical_path.store (cp, std::memory_order_relaxed); }
+
 protected:
-	void trigger ();
+	bool release ();
 	virtual void process () = 0;
 
 	std::shared_ptr<Graph> _graph;
@@ -94,7 +104,9 @@ protected:
 private:
 	void finish (GraphChain const*);
 
-	std::atomic<int> _refcount;
+	std::atomic<int>   _refcount;
+	std::atomic<float> _cost_avg;
+	std::atomic<float> _critical_path;
 };
 
 } // namespace ARDOUR
@@ -42,6 +42,11 @@ public:
 	virtual samplepos_t natural_position() const = 0;
 
 	virtual bool clamped_at_unity () const = 0;
+
+	/** Retrieve the absolute peak of the complete source without reading it,
+	 * if the file provides this information (e.g. a WAV PEAK chunk).
+	 */
+	virtual bool get_signal_max (float& /*peak*/) const { return false; }
 };
 
 }
@@ -155,6 +155,8 @@ public:
 
 		XMLNode &marshal_note(const NotePtr note) const;
 		NotePtr unmarshal_note(XMLNode *xml_note);
+
+		bool affected_range (TimeType& start, TimeType& end) const;
 	};
 
 	/* Currently this class only supports changes of sys-ex time, but could be expanded */
@@ -192,6 +194,8 @@ public:
 
 		XMLNode & marshal_change (const Change &) const;
 		Change unmarshal_change (XMLNode *);
+
+		bool affected_range (TimeType& start, TimeType& end) const;
 	};
 
 	class LIBARDOUR_API PatchChangeDiffCommand : public DiffCommand {
@@ -251,6 +255,8 @@ public:
 
 		XMLNode & marshal_patch_change (constPatchChangePtr) const;
 		PatchChangePtr unmarshal_patch_change (XMLNode *);
+
+		bool affected_range (TimeType& start, TimeType& end) const;
 	};
 
 	void create_mapping_stash (Temporal::Beats const & offset);
@@ -311,6 +317,13 @@ public:
 	PBD::Signal0<void> ContentsChanged;
 	PBD::Signal1<void, Temporal::timecnt_t> ContentsShifted;
 
+	/** When called from a handler of ContentsChanged, get the range of
+	 * model time (inclusive) touched by the change being signalled.
+	 * @return false if the range is not known, and all of the model must be
+	 * assumed to have changed.
+	 */
+	bool changed_range (TimeType& start, TimeType& end) const;
+
 	std::shared_ptr<Evoral::Note<TimeType> > find_note (NotePtr);
 	PatchChangePtr find_patch_change (Evoral::event_id_t);
 	std::shared_ptr<Evoral::Note<TimeType> > find_note (Evoral::event_id_t);
@@ -359,6 +372,8 @@ private:
 
 	void control_list_marked_dirty ();
 
+	void contents_changed (TimeType const& start, TimeType const& end);
+
 	PBD::ScopedConnectionList _midi_source_connections;
 
 	MidiSource& _midi_source;
@@ -367,6 +382,10 @@ private:
 	typedef std::map<void*,superclock_t> TempoMappingStash;
 	TempoMappingStash tempo_mapping_stash;
 
+	TimeType _changed_start;
+	TimeType _changed_end;
+	bool     _changed_range_valid;
+
 };
 
 } /* namespace ARDOUR */
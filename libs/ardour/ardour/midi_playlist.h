@@ -23,6 +23,7 @@
 #ifndef __ardour_midi_playlist_h__
 #define __ardour_midi_playlist_h__
 
+#include <map>
 #include <vector>
 #include <list>
 
@@ -87,12 +88,50 @@ public:
 	std::shared_ptr<Region> combine (const RegionList&, std::shared_ptr<Track>);
 	void uncombine (std::shared_ptr<Region>);
 
+  protected:
+	bool region_changed (const PBD::PropertyChange&, std::shared_ptr<Region>);
+
   private:
+	typedef std::list<std::shared_ptr<MidiRegion> >            MidiRegionList;
+	typedef std::vector<std::pair<samplepos_t, samplepos_t> > DirtyRanges;
+
+	/* extent of a region, as last rendered into _rendered */
+	struct RenderedRegion {
+		RenderedRegion (MidiRegion const&);
+
+		bool operator!= (RenderedRegion const& other) const {
+			return position != other.position || end != other.end || start != other.start;
+		}
+
+		samplepos_t position;
+		samplepos_t end; /* last sample, resolved note-offs */
+		samplepos_t start;
+	};
+
+	typedef std::map<PBD::ID, RenderedRegion> RenderedRegions;
+
 	void dump () const;
 
+	bool find_dirty_ranges (MidiRegionList const&, MidiChannelFilter*, bool layered, DirtyRanges&);
+	bool render_ranges (MidiRegionList const&, MidiChannelFilter*, DirtyRanges&, RTMidiBuffer::WriteProtectRender&);
+	void tempo_map_changed ();
+
 	NoteMode     _note_mode;
 
 	RTMidiBuffer _rendered;
+
+	/* state of the last render, only used by ::render() */
+	RenderedRegions _rendered_regions;
+	ChannelMode     _rendered_channel_mode;
+	uint16_t        _rendered_channel_mask;
+	bool            _rendered_layered;
+
+	/* ranges that changed since the last render */
+	Glib::Threads::Mutex _dirty_lock;
+	DirtyRanges          _dirty;
+	bool                 _render_all;
+
+	PBD::ScopedConnection _tempo_map_connection;
 };
 
 } /* namespace ARDOUR */
@@ -114,7 +114,27 @@ class LIBARDOUR_API MidiRegion : public Region
 	                  NoteMode                        mode,
 	                  timepos_t const &               read_start,
 	                  timecnt_t const &               read_length,
-	                  MidiChannelFilter*              filter) const;
+	                  MidiChannelFilter*              filter,
+	                  bool                            resolve_notes = true) const;
+
+	/** Render only those events of this region that are timestamped in
+	 * [@p from, @p to) (session samples), identical to the corresponding
+	 * part of what ::render() writes.
+	 * @return -1 if that is not possible, in which case the whole region
+	 * needs to be rendered.
+	 */
+	int render_section (Evoral::EventSink<samplepos_t>& dst,
+	                    uint32_t                        chan_n,
+	                    NoteMode                        mode,
+	                    samplepos_t                     from,
+	                    samplepos_t                     to,
+	                    MidiChannelFilter*              filter) const;
+
+	/** Get the range of session samples [@p start, @p end) affected by
+	 * edits of the model since the last call.
+	 * @return false if it is not known, i.e. all of the region may have changed.
+	 */
+	bool take_changed_range (samplepos_t& start, samplepos_t& end);
 
 	void start_domain_bounce (Temporal::DomainBounceInfo&);
 	void finish_domain_bounce (Temporal::DomainBounceInfo&);
@@ -161,6 +181,12 @@ class LIBARDOUR_API MidiRegion : public Region
 	PBD::ScopedConnection _source_connection;
 	PBD::ScopedConnection _model_contents_connection;
 	bool _ignore_shift;
+
+	/* model time range of edits not yet picked up by the playlist */
+	Temporal::Beats _changed_start;
+	Temporal::Beats _changed_end;
+	bool            _changed_pending;
+	bool            _changed_known;
 };
 
 } /* namespace ARDOUR */
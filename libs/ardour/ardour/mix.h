@@ -50,6 +50,18 @@ extern "C" {
 LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint32_t nsamples, float* min, float* max);
 #endif
 
+/* AVX functions (x86_functions_avx.cc) */
+LIBARDOUR_API float x86_avx_apply_gain_ramp             (float* buf, uint32_t nframes, float gain, float target, float coeff);
+LIBARDOUR_API void  x86_avx_interleave                  (float* dst, float const* src, uint32_t nframes, uint32_t chn, uint32_t n_chn);
+LIBARDOUR_API void  x86_avx_deinterleave                (float* dst, float const* src, uint32_t nframes, uint32_t chn, uint32_t n_chn);
+LIBARDOUR_API void  x86_avx_float_to_int16              (int16_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx_int16_to_float              (float* dst, int16_t const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx_float_to_int24              (int32_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx_int24_to_float              (float* dst, int32_t const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx_invert_polarity             (float* buf, uint32_t nframes);
+LIBARDOUR_API void  x86_avx_mix_buffers_inverted        (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx_mix_buffers_with_gain_ramp  (float* dst, float const* src, uint32_t nframes, float gain, float target);
+
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
@@ -63,6 +75,14 @@ LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain   (float* dst, float const
 LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain     (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_copy_vector             (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API float x86_avx512f_apply_gain_ramp         (float* buf, uint32_t nframes, float gain, float target, float coeff);
+LIBARDOUR_API void  x86_avx512f_float_to_int16          (int16_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_int16_to_float          (float* dst, int16_t const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_float_to_int24          (int32_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_int24_to_float          (float* dst, int32_t const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_invert_polarity         (float* buf, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_inverted    (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain_ramp (float* dst, float const* src, uint32_t nframes, float gain, float target);
 #endif
 
 /* debug wrappers for SSE functions */
@@ -95,6 +115,16 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
 }
+LIBARDOUR_API float arm_neon_apply_gain_ramp          (float* buf, uint32_t nframes, float gain, float target, float coeff);
+LIBARDOUR_API void  arm_neon_interleave               (float* dst, float const* src, uint32_t nframes, uint32_t chn, uint32_t n_chn);
+LIBARDOUR_API void  arm_neon_deinterleave             (float* dst, float const* src, uint32_t nframes, uint32_t chn, uint32_t n_chn);
+LIBARDOUR_API void  arm_neon_float_to_int16           (int16_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_int16_to_float           (float* dst, int16_t const* src, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_float_to_int24           (int32_t* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_int24_to_float           (float* dst, int32_t const* src, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_invert_polarity          (float* buf, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_mix_buffers_inverted     (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_mix_buffers_with_gain_ramp (float* dst, float const* src, uint32_t nframes, float gain, float target);
 #endif
 
 /* non-optimized functions */
@@ -105,5 +135,15 @@ LIBARDOUR_API void  default_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDO
 LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API float default_apply_gain_ramp           (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float gain, float target, float coeff);
+LIBARDOUR_API void  default_interleave                (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t chn, uint32_t n_chn);
+LIBARDOUR_API void  default_deinterleave              (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t chn, uint32_t n_chn);
+LIBARDOUR_API void  default_float_to_int16            (int16_t* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_int16_to_float            (ARDOUR::Sample* dst, int16_t const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_float_to_int24            (int32_t* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_int24_to_float            (ARDOUR::Sample* dst, int32_t const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_invert_polarity           (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_mix_buffers_inverted      (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_mix_buffers_with_gain_ramp (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain, float target);
 
 #endif /* __ardour_mix_h__ */
@@ -19,8 +19,15 @@
 #ifndef _libardour_mixer_scene_h_
 #define _libardour_mixer_scene_h_
 
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 
+#include <glibmm/threads.h>
+
 #include "pbd/stateful.h"
 
 #include "ardour/libardour_visibility.h"
@@ -33,6 +40,8 @@ namespace PBD {
 
 namespace ARDOUR {
 
+class AutomationControl;
+
 class LIBARDOUR_API MixerScene : public SessionHandleRef, public PBD::Stateful
 {
 public:
@@ -43,7 +52,37 @@ public:
 	bool apply () const;
 	bool apply (PBD::ControllableSet const&, AutomationTypeSet const& ts = AutomationTypeSet()) const;
 	void clear ();
-	bool empty () const { return _ctrl_map.empty (); }
+	bool empty () const;
+
+	typedef std::map<PBD::ID, double> ControllableValueMap;
+
+	/** Copy of the stored values, which can be used by other threads
+	 * while the scene is modified.
+	 */
+	ControllableValueMap values () const;
+
+	/** true if @p values contain a value for any of the given controls */
+	static bool has_values (ControllableValueMap const& values, PBD::ControllableSet const&);
+
+	/* Recall is split in two steps. stage () collects the controls to
+	 * set, in order (masters first), and can run in a background thread.
+	 * apply_staged () sets the values, and is intended to run in the
+	 * process thread at a cycle boundary, possibly only a slice of the
+	 * values per cycle.
+	 */
+	struct StagedValue {
+		StagedValue (std::shared_ptr<AutomationControl> c, double v, bool s)
+			: ctrl (c), value (v), slaved (s) {}
+
+		std::weak_ptr<AutomationControl> ctrl;
+		double                           value;
+		bool                             slaved; // value is relative to masters
+	};
+
+	typedef std::vector<StagedValue> StagedValues;
+
+	static bool stage (ControllableValueMap const&, StagedValues&, PBD::ControllableSet const&, AutomationTypeSet const& ts = AutomationTypeSet());
+	static bool apply_staged (StagedValues const&, size_t first = 0, size_t count = std::numeric_limits<size_t>::max ());
 
 	std::string name () const { return _name; }
 	bool        set_name (std::string const& name);
@@ -54,12 +93,11 @@ public:
 	static PBD::Signal0<void> Change;
 
 private:
-	typedef std::map<PBD::ID, double> ControllableValueMap;
-
-	bool recurse_to_master (std::shared_ptr<PBD::Controllable>, std::set <PBD::ID>&, AutomationTypeSet const&) const;
+	static bool recurse_to_master (ControllableValueMap const&, std::shared_ptr<PBD::Controllable>, std::set <PBD::ID>&, AutomationTypeSet const&, StagedValues&);
 
-	ControllableValueMap       _ctrl_map;
-	std::string                _name;
+	mutable Glib::Threads::Mutex _lock; // protects _ctrl_map
+	ControllableValueMap         _ctrl_map;
+	std::string                  _name;
 };
 
 }
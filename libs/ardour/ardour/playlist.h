@@ -51,6 +51,7 @@
 #include "ardour/ardour.h"
 #include "ardour/data_type.h"
 #include "ardour/region.h"
+#include "ardour/region_index.h"
 #include "ardour/session_object.h"
 #include "ardour/thawlist.h"
 
@@ -326,6 +327,7 @@ protected:
 		    , playlist (pl)
 		    , block_notify (do_block_notify)
 		{
+			++playlist->_region_write_locked;
 			if (block_notify) {
 				playlist->delay_notifications ();
 			}
@@ -334,7 +336,9 @@ protected:
 		~RegionWriteLock ()
 		{
 			Glib::Threads::RWLock::WriterLock::release ();
+			/* regions report their new position when thawed */
 			thawlist.release ();
+			--playlist->_region_write_locked;
 			if (block_notify) {
 				playlist->release_notifications ();
 			}
@@ -433,6 +437,7 @@ protected:
 	bool add_region_internal (std::shared_ptr<Region>, timepos_t const & position, ThawList& thawlist);
 
 	int  remove_region_internal (std::shared_ptr<Region>, ThawList& thawlist);
+	void remove_region_from_index (std::shared_ptr<Region>);
 	void copy_regions (RegionList&) const;
 
 	void partition_internal (timepos_t start, timepos_t end, bool cutting, ThawList& thawlist);
@@ -473,6 +478,25 @@ private:
 	void coalesce_and_check_crossfades (std::list<Temporal::TimeRange>);
 	std::shared_ptr<RegionList> find_regions_at (timepos_t const &);
 
+	/* Position index of `regions', updated as regions are added, removed
+	 * or moved. Access must hold _region_index_lock.
+	 * While a write-lock is held, and until its regions are thawed, regions
+	 * may be moved without notification (see ThawList), so the index is bypassed.
+	 */
+	mutable RegionIndex          _region_index;
+	mutable Glib::Threads::Mutex _region_index_lock;
+	std::atomic<int>             _region_write_locked;
+
+	enum RegionQuery {
+		QueryTouched,
+		QueryStartWithin,
+		QueryEndWithin
+	};
+
+	typedef RegionIndex::Result RegionCandidates;
+
+	void region_candidates (RegionQuery, timepos_t const& start, timepos_t const& end, RegionCandidates&) const;
+
 	mutable boost::optional<std::pair<timepos_t, timepos_t> > _cached_extent;
 	timepos_t _end_space;  //this is used when we are pasting a range with extra space at the end
 	bool _playlist_shift_active;
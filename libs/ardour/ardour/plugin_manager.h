@@ -302,6 +302,19 @@ private:
 
 	void reset_scan_cancel_state (bool single = false);
 
+	/* out-of-process scans, several scanner apps can run concurrently */
+	struct ScannerJob;
+	typedef std::shared_ptr<ScannerJob> ScannerJobPtr;
+	typedef std::list<ScannerJobPtr>    ScannerJobList;
+
+	void run_scanner_apps (ScannerJobList&, std::string const&);
+	bool scanner_result (std::string const& key, bool& completed);
+
+	/** Scanner apps that completed (or failed) in run_scanner_apps (),
+	 * by path or AU descriptor.
+	 */
+	std::map<std::string, bool> _scanner_results;
+
 	bool no_timeout () const { return _cancel_scan_timeout_one || _cancel_scan_timeout_all; }
 
 	void detect_name_ambiguities (ARDOUR::PluginInfoList*);
@@ -336,6 +349,7 @@ private:
 	void auv2_plugin (CAComponentDescription const&, AUv2Info const&);
 	int  auv2_discover (AUv2DescStr const&, bool);
 	bool run_auv2_scanner_app (CAComponentDescription const&, AUv2DescStr const&, PSLEPtr) const;
+	void auv2_parallel_scan (std::vector<AUv2DescStr> const&);
 #endif
 
 	void lv2_plugin (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool);
@@ -347,6 +361,7 @@ private:
 #if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
 	bool vst2_plugin (std::string const& module_path, ARDOUR::PluginType, VST2Info const&);
 	bool run_vst2_scanner_app (std::string bundle_path, PSLEPtr) const;
+	void vst2_parallel_scan (std::vector<std::string> const&, ARDOUR::PluginType);
 	int vst2_discover (std::string path, ARDOUR::PluginType, bool cache_only = false);
 #endif
 
@@ -355,6 +370,7 @@ private:
 #ifdef VST3_SUPPORT
 	void vst3_plugin (std::string const&, std::string const&, VST3Info const&);
 	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr) const;
+	void vst3_parallel_scan (std::vector<std::string> const&);
 #endif
 
 	int ladspa_discover (std::string path);
@@ -41,6 +41,8 @@ namespace ARDOUR {
 
 class PortEngine;
 class AudioBackend;
+class AudioPort;
+class RTTaskList;
 class Session;
 
 class CircularSampleBuffer;
@@ -389,6 +391,32 @@ private:
 	SerializedRCUManager<AudioInputPorts> _audio_input_ports;
 	SerializedRCUManager<MIDIInputPorts>  _midi_input_ports;
 	std::atomic<int>                     _reset_meters;
+
+	/* Audio input ports with identical connections. Only the first
+	 * port of each group resamples, the others copy its data.
+	 */
+	typedef std::vector<std::shared_ptr<AudioPort> > InputResampleGroup;
+	typedef std::vector<InputResampleGroup>           InputResampleGroups;
+
+	SerializedRCUManager<InputResampleGroups> _input_resample_groups;
+	Glib::Threads::Mutex                      _input_resample_groups_lock;
+	std::atomic<bool>                         _input_resample_groups_dirty;
+	uint32_t                                  _resample_cycle;
+
+	enum ResampleMode {
+		NoResample,
+		Resample,
+		SharedResample
+	};
+
+	ResampleMode resample_mode (Port const*, bool input) const;
+
+	void update_input_resample_groups ();
+	void resample_input_group (InputResampleGroup const*, pframes_t);
+	void cycle_start_no_resample (pframes_t, samplecnt_t);
+	void cycle_end_no_resample (pframes_t);
+	void cycle_end_ports (pframes_t, Session*);
+	bool parallel_resample (RTTaskList const&, size_t n_jobs, pframes_t) const;
 };
 
 } // namespace ARDOUR
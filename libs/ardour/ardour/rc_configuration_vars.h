@@ -101,8 +101,14 @@ CONFIG_VARIABLE (BufferingPreset, buffering_preset, "buffering-preset", Medium)
 CONFIG_VARIABLE (float, audio_capture_buffer_seconds, "capture-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
+CONFIG_VARIABLE (uint32_t, butler_io_threads, "butler-io-threads", 0) /* 0, 1: butler thread only */
+CONFIG_VARIABLE (uint32_t, capture_writer_threads, "capture-writer-threads", 0) /* 0: write from the butler thread(s) */
+CONFIG_VARIABLE (bool, capture_write_behind, "capture-write-behind", false)
+CONFIG_VARIABLE (uint32_t, read_ahead_threads, "read-ahead-threads", 0) /* 0: no read-ahead, 1: from the butler thread */
+CONFIG_VARIABLE (bool, multichannel_read_cache, "multichannel-read-cache", true) /* share decoded blocks between the channels of a file */
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
+CONFIG_VARIABLE (uint32_t, import_jobs, "import-jobs", 0) /* 0: one per CPU core, up to 4 */
 CONFIG_VARIABLE (float, transient_sensitivity, "transient-sensitivity", 50)
 CONFIG_VARIABLE (float, max_transport_speed, "max-transport-speed", 2.0)
 
@@ -217,9 +223,12 @@ CONFIG_VARIABLE_SPECIAL (std::string, default_session_parent_dir, "default-sessi
 CONFIG_VARIABLE_SPECIAL (std::string, default_session_parent_dir, "default-session-parent-dir", "~", poor_mans_glob)
 #endif
 CONFIG_VARIABLE (std::string, clip_library_dir, "clip-library-dir", "@default@") /* writable folder */
+CONFIG_VARIABLE (uint32_t, clip_mmap_threshold, "clip-mmap-threshold", 0) /* seconds, trigger clips longer than this are memory-mapped, 0: never */
 CONFIG_VARIABLE (std::string, sample_lib_path, "sample-lib-path", "") /* custom paths */
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (bool, graph_work_stealing, "graph-work-stealing", false)
+CONFIG_VARIABLE (uint32_t, convolver_threads, "convolver-threads", 1) /* background threads for the longest IR partitions, 0: auto */
 CONFIG_VARIABLE (int32_t, cpu_dma_latency, "cpu-dma-latency", -1) /* >=0 to enable */
 CONFIG_VARIABLE (gain_t, max_gain, "max-gain", 2.0) /* +6.0dB */
 CONFIG_VARIABLE (uint32_t, max_recent_sessions, "max-recent-sessions", 10)
@@ -248,6 +257,8 @@ CONFIG_VARIABLE (bool, ask_replace_instrument, "ask-replace-instrument", true)
 CONFIG_VARIABLE (bool, ask_setup_instrument, "ask-setup-instrument", true)
 CONFIG_VARIABLE (bool, setup_sidechain, "setup-sidechain", false)
 CONFIG_VARIABLE (uint32_t, plugin_scan_timeout, "plugin-scan-timeout", 150) /* deci-seconds */
+CONFIG_VARIABLE (uint32_t, plugin_scan_jobs, "plugin-scan-jobs", 0) /* 0: one per CPU core, up to 8 */
+CONFIG_VARIABLE (std::string, plugin_scan_cache_path, "plugin-scan-cache-path", "") /* empty: user cache folder */
 CONFIG_VARIABLE (uint32_t, limit_n_automatables, "limit-n-automatables", 512)
 CONFIG_VARIABLE (uint32_t, plugin_cache_version, "plugin-cache-version", 0)
 
@@ -285,4 +296,6 @@ CONFIG_VARIABLE (bool, show_video_server_dialog, "show-video-server-dialog", fal
 /* export */
 CONFIG_VARIABLE (float, export_preroll, "export-preroll", 2.0) // seconds
 CONFIG_VARIABLE (float, export_silence_threshold, "export-silence-threshold", -90) // dB
+CONFIG_VARIABLE (bool, export_timespans_in_one_pass, "export-timespans-in-one-pass", true)
+CONFIG_VARIABLE (uint32_t, export_analysis_memory_limit, "export-analysis-memory-limit", 2048) // MB for all analysis data of an export, 0: always use a tmp file
 CONFIG_VARIABLE (float, ppqn_factor_for_export, "ppqn-factor-for-export", 1) // Temporal::ticks_per_beat
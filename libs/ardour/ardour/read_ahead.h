@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef __ardour_read_ahead_h__
+#define __ardour_read_ahead_h__
+
+#include <vector>
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+
+namespace PBD {
+	class Thread;
+}
+
+namespace ARDOUR {
+
+/** Asynchronous read-ahead for disk playback.
+ *
+ * Before the butler reads the next chunk of all tracks (after a locate,
+ * or when refilling playback buffers), the file ranges that will be read
+ * are collected here. They are sorted by file and offset, adjacent ranges
+ * are merged, and the OS is told to read them into the page-cache
+ * (POSIX_FADV_WILLNEED, F_RDADVISE on macOS).
+ *
+ * This queues the reads of all tracks at once, rather than one
+ * seek and read after another, so the I/O scheduler and the storage
+ * can reorder and overlap them. The actual reads by the DiskReaders
+ * are then served from the cache.
+ *
+ * Advice is issued concurrently by a pool of threads, since it may block
+ * when the device's queue is full, or on network storage.
+ * All methods are to be called from the butler thread only.
+ */
+class LIBARDOUR_API ReadAhead
+{
+public:
+	ReadAhead (uint32_t n_threads);
+	~ReadAhead ();
+
+	/** Add a range of a file.
+	 * @param fd file-descriptor to advise
+	 * @param file unique ID of the file (inode), used to sort ranges
+	 * @param offset byte offset
+	 * @param len number of bytes
+	 */
+	void add (int fd, uint64_t file, off_t offset, off_t len);
+
+	/** Sort and merge the ranges added since the last call, and issue them.
+	 * Returns once all ranges are submitted, not when they are read.
+	 */
+	void commit ();
+
+	size_t n_pending () const { return _ranges.size (); }
+
+private:
+	struct Range {
+		Range (int d, uint64_t f, off_t o, off_t l)
+			: fd (d)
+			, file (f)
+			, offset (o)
+			, len (l)
+		{}
+
+		bool operator< (Range const& other) const {
+			if (file != other.file) {
+				return file < other.file;
+			}
+			return offset < other.offset;
+		}
+
+		int      fd;
+		uint64_t file;
+		off_t    offset;
+		off_t    len;
+	};
+
+	static void advise (Range const&);
+	void thread_work ();
+
+	std::vector<Range>        _ranges;
+	std::vector<PBD::Thread*> _threads;
+	size_t                    _queued;  // ranges handed to the threads
+	size_t                    _next;    // next range to advise
+	size_t                    _pending; // ranges not yet advised
+	bool                      _run;
+	Glib::Threads::Mutex      _lock;
+	Glib::Threads::Cond       _cond;
+	Glib::Threads::Cond       _done;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_read_ahead_h__ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __libardour_region_index_h__
+#define __libardour_region_index_h__
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "temporal/timeline.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class Region;
+
+/** Position index over the regions of a playlist.
+ *
+ * Regions are kept in one augmented interval tree (a treap) per time-domain:
+ * regions whose position and length are in audio-time are keyed by
+ * superclock, those in music-time by beat ticks. Keys therefore do not
+ * depend on the tempo-map. Regions with a mixed time-domain are not
+ * indexed and always returned as candidates.
+ *
+ * Adding, removing or moving a region is O(log n), looking up the
+ * regions touching a given range is O(log n + k).
+ *
+ * The index is conservative: callers must check the exact condition
+ * for each returned region. Results are sorted by position.
+ */
+class LIBARDOUR_API RegionIndex
+{
+public:
+	typedef std::vector<std::shared_ptr<Region> > Result;
+
+	RegionIndex ();
+	~RegionIndex ();
+
+	void clear ();
+
+	void add (std::shared_ptr<Region> const&);
+	void remove (std::shared_ptr<Region> const&);
+	/** re-index a region after its position or length changed */
+	void update (std::shared_ptr<Region> const&);
+
+	size_t size () const { return _nodes.size (); }
+
+	/** Regions that may touch [start, end] (inclusive) */
+	void touched (timepos_t const& start, timepos_t const& end, Result&) const;
+	/** Regions whose position may be in [start, end] (inclusive) */
+	void starting_within (timepos_t const& start, timepos_t const& end, Result&) const;
+	/** Regions whose last sample may be in [start, end] (inclusive) */
+	void ending_within (timepos_t const& start, timepos_t const& end, Result&) const;
+
+	/** @return the first region starting after pos (dir > 0),
+	 * or the last region starting before pos (dir < 0)
+	 */
+	std::shared_ptr<Region> next_start (timepos_t const& pos, int dir) const;
+
+private:
+	struct Node;
+
+	typedef std::multimap<int64_t, Node*> ByLast;
+
+	struct Node {
+		int64_t                 start;
+		int64_t                 last;
+		int64_t                 max_last; ///< max. last of the subtree rooted at this node
+		uint64_t                seq;      ///< insertion order, breaks ties of start
+		uint32_t                prio;
+		std::shared_ptr<Region> region;
+		Node*                   left;
+		Node*                   right;
+		ByLast::iterator        by_last;
+		int                     tree;     ///< index into _trees, or -1 if not indexed
+	};
+
+	struct Tree {
+		Tree () : root (0) {}
+
+		Node*  root;
+		ByLast by_last;
+
+		void insert (Node*);
+		void erase (Node*);
+
+		void touched (Node*, int64_t start, int64_t end, std::vector<Node const*>&) const;
+		void starting_within (Node*, int64_t start, int64_t end, std::vector<Node const*>&) const;
+
+		Node const* ceil (int64_t start, uint64_t seq) const;
+		Node const* floor_below (int64_t start, uint64_t seq) const;
+	};
+
+	enum { AudioTree = 0, BeatTree = 1 };
+
+	static void    pull (Node*);
+	static void    split (Node*, int64_t start, uint64_t seq, Node*& l, Node*& r);
+	static Node*   merge (Node* l, Node* r);
+	static int64_t key (timepos_t const&, int tree);
+
+	void insert (Node*);
+	void erase (Node*);
+	void result (std::vector<Node const*>&, Result&) const;
+
+	Node const* next_start (Tree const&, int tree, timepos_t const& pos, int dir) const;
+
+	std::map<Region const*, Node*> _nodes;
+	std::map<uint64_t, Node*>      _unindexed;
+	Tree                           _trees[2];
+	uint64_t                       _seq;
+	std::minstd_rand               _rand;
+};
+
+} /* namespace ARDOUR */
+
+#endif /* __libardour_region_index_h__ */
@@ -33,6 +33,10 @@
 
 #include "ardour/types.h"
 
+namespace Evoral {
+	template<typename Time> class EventList;
+}
+
 namespace ARDOUR {
 
 class MidiBuffer;
@@ -62,6 +66,15 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	samplecnt_t span() const;
 
 	uint32_t write (TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
+
+	/** Replace all events in [start, end) with the given events, which
+	 * must be sorted and timestamped in the same range. Like ::write()
+	 * this requires the caller to hold a WriteProtectRender.
+	 *
+	 * Blob storage of replaced events is not reclaimed until the next
+	 * ::clear().
+	 */
+	void splice (samplepos_t start, samplepos_t end, Evoral::EventList<TimeType> const& events);
 	uint32_t read (MidiBuffer& dst, samplepos_t start, samplepos_t end, MidiNoteTracker& tracker, samplecnt_t offset = 0);
 	void track (MidiStateTracker&, samplepos_t start, samplepos_t end);
 
@@ -119,6 +132,8 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	bool   _reversed;
 	/* secondary blob storage. Holds Blobs (arbitrary size + data) */
 
+	void set_item (Item&, TimeType time, uint32_t size, const uint8_t* buf);
+
 	uint32_t alloc_blob (uint32_t size);
 	uint32_t store_blob (uint32_t size, uint8_t const * data);
 	uint32_t _pool_size;
@@ -40,6 +40,9 @@ public:
 
 	std::vector<RTTask> const& tasks () const { return _tasks; }
 
+	/** number of threads available to process tasks */
+	uint32_t n_threads () const;
+
 private:
 	std::vector<RTTask>      _tasks;
 	std::shared_ptr<Graph> _graph;
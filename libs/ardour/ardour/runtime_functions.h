@@ -32,12 +32,38 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 
+	/* buf[i] *= g; g += coeff * (target - g); returns g after the last sample */
+	typedef float (*apply_gain_ramp_t)       (ARDOUR::Sample *, pframes_t, float gain, float target, float coeff);
+	/* write src to (resp. read dst from) channel chn of an interleaved buffer with n_chn channels */
+	typedef void  (*interleave_t)            (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t, uint32_t chn, uint32_t n_chn);
+	typedef void  (*deinterleave_t)          (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t, uint32_t chn, uint32_t n_chn);
+	/* sample format conversion, int24 is right-aligned in an int32_t; float to int is clamped */
+	typedef void  (*float_to_int16_t)        (int16_t *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*int16_to_float_t)        (ARDOUR::Sample *, const int16_t *, pframes_t);
+	typedef void  (*float_to_int24_t)        (int32_t *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*int24_to_float_t)        (ARDOUR::Sample *, const int32_t *, pframes_t);
+	typedef void  (*invert_polarity_t)       (ARDOUR::Sample *, pframes_t);
+	typedef void  (*mix_buffers_inverted_t)  (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	/* dst[i] += src[i] * (gain + i * (target - gain) / nframes), linear interpolation */
+	typedef void  (*mix_buffers_with_gain_ramp_t) (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t, float gain, float target);
+
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
 	LIBARDOUR_API extern apply_gain_to_buffer_t  apply_gain_to_buffer;
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+
+	LIBARDOUR_API extern apply_gain_ramp_t       apply_gain_ramp;
+	LIBARDOUR_API extern interleave_t            interleave;
+	LIBARDOUR_API extern deinterleave_t          deinterleave;
+	LIBARDOUR_API extern float_to_int16_t        float_to_int16;
+	LIBARDOUR_API extern int16_to_float_t        int16_to_float;
+	LIBARDOUR_API extern float_to_int24_t        float_to_int24;
+	LIBARDOUR_API extern int24_to_float_t        int24_to_float;
+	LIBARDOUR_API extern invert_polarity_t       invert_polarity;
+	LIBARDOUR_API extern mix_buffers_inverted_t  mix_buffers_inverted;
+	LIBARDOUR_API extern mix_buffers_with_gain_ramp_t mix_buffers_with_gain_ramp;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
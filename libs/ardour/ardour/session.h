@@ -276,6 +276,7 @@ public:
 	std::string analysis_dir () const;    ///< Analysis data
 	std::string plugins_dir () const;     ///< Plugin state
 	std::string externals_dir () const;   ///< Links to external files
+	std::string cache_dir () const;       ///< Disposable data, e.g. clip data
 
 	std::string construct_peak_filepath (const std::string& audio_path, const bool in_session = false, const bool old_peak_name = false) const;
 
@@ -357,6 +358,7 @@ public:
 	uint32_t nbusses () const;
 
 	bool plot_process_graph (std::string const& file_name) const;
+	bool process_graph_stats (uint32_t& steals, uint32_t& idle_wakeups, uint32_t& max_queue_depth) const;
 
 	std::shared_ptr<BundleList const> bundles () {
 		return _bundles.reader ();
@@ -1232,6 +1234,13 @@ public:
 	std::shared_ptr<PBD::Controllable> solo_cut_control() const;
 	std::shared_ptr<PBD::Controllable> recently_touched_controllable () const;
 
+	/* Scenes are staged in the butler thread, and applied in the
+	 * process thread, spread over as many cycles as needed.
+	 * These return true if the scene has a value for any of the
+	 * controls, and false if there is nothing to recall. Values
+	 * are not yet set when these return (unless called from a thread
+	 * without event loop).
+	 */
 	bool apply_nth_mixer_scene (size_t);
 	bool apply_nth_mixer_scene (size_t, RouteList const&);
 	void store_nth_mixer_scene (size_t);
@@ -1976,7 +1985,7 @@ private:
 	std::shared_ptr<Route> XMLRouteFactory_2X (const XMLNode&, int);
 	std::shared_ptr<Route> XMLRouteFactory_3X (const XMLNode&, int);
 
-	void route_processors_changed (RouteProcessorChange);
+	void route_processors_changed (RouteProcessorChange, std::weak_ptr<Route> wr = std::weak_ptr<Route> ());
 
 	bool find_route_name (std::string const &, uint32_t& id, std::string& name, bool);
 	void count_existing_track_channels (ChanCount& in, ChanCount& out);
@@ -2295,6 +2304,11 @@ private:
 	}
 
 	void rt_set_controls (std::shared_ptr<WeakAutomationControlList>, double val, PBD::Controllable::GroupControlDisposition group_override);
+
+	struct MixerSceneRecall;
+	bool recall_mixer_scene (std::shared_ptr<MixerScene>, std::shared_ptr<PBD::ControllableSet const>);
+	void stage_mixer_scene (std::shared_ptr<MixerSceneRecall>);
+	void rt_apply_mixer_scene (std::shared_ptr<MixerSceneRecall>);
 	void rt_clear_all_solo_state (std::shared_ptr<RouteList const>, bool yn, PBD::Controllable::GroupControlDisposition group_override);
 
 	void setup_midi_machine_control ();
@@ -2319,6 +2333,22 @@ private:
 	 */
 	GraphEdges _current_route_graph;
 
+	/** Nodes whose connections changed since _current_route_graph was
+	 * computed, only their edges are re-evaluated by the next resort.
+	 */
+	struct GraphPortChange {
+		std::weak_ptr<Port> port;
+		bool                ours;
+	};
+
+	Glib::Threads::Mutex                  _graph_dirty_lock;
+	bool                                  _graph_dirty_all;
+	std::vector<std::weak_ptr<Route> >    _graph_dirty_routes;
+	std::vector<std::pair<GraphPortChange, GraphPortChange> > _graph_dirty_ports;
+
+	void graph_port_connection_changed (std::weak_ptr<Port>, std::string const&, std::weak_ptr<Port>, std::string const&);
+	bool collect_dirty_graph_nodes (GraphNodeList const&, std::set<GraphVertex>&);
+
 	friend class IOPlug;
 	std::shared_ptr<Graph>      _process_graph;
 	std::shared_ptr<GraphChain> _graph_chain;
@@ -41,6 +41,7 @@ public:
 	samplecnt_t samplerate() const;
 	void       seek (samplepos_t pos);
 	bool       clamped_at_unity () const;
+	bool       get_signal_max (float&) const;
 	samplepos_t natural_position () const;
 
 protected:
@@ -36,6 +36,8 @@ namespace PBD {
 
 namespace ARDOUR {
 
+class SndFileBlockCache;
+
 class LIBARDOUR_API SndFileSource : public AudioFileSource {
   public:
 	/** Constructor to be called for existing external-to-session files */
@@ -73,6 +75,9 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	bool clamped_at_unity () const;
 
+	void set_write_behind (bool yn) { _write_behind = yn; }
+	void read_ahead (ReadAhead&, samplepos_t start, samplecnt_t cnt) const;
+
 	static const Source::Flag default_writable_flags;
 
 	static int get_soundfile_info (const std::string& path, SoundFileInfo& _info, std::string& error_msg);
@@ -84,6 +89,7 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	void set_header_natural_position ();
 
 	samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
+	samplecnt_t read_cached (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
 	samplecnt_t write_unlocked (Sample *dst, samplecnt_t cnt);
 	samplecnt_t write_float (Sample* data, samplepos_t pos, samplecnt_t cnt);
 
@@ -92,6 +98,20 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	int   _fd;
+	bool  _write_behind;
+	off_t _write_behind_prev;
+	off_t _write_behind_pos;
+
+	void write_behind ();
+
+	/* location of uncompressed audio data, for read-ahead */
+	off_t    _data_offset;
+	uint64_t _file_id;
+
+	/* blocks shared with the other channels of a multi-channel file */
+	std::shared_ptr<SndFileBlockCache> _block_cache;
+
 	void init_sndfile ();
 	int open();
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
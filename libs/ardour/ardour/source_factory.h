@@ -57,9 +57,12 @@ public:
 	static std::vector<PBD::Thread*> peak_thread_pool;
 
 	static std::list<std::weak_ptr<AudioSource>> files_with_peaks;
+	static std::list<std::weak_ptr<AudioSource>> files_with_peak_mips;
 
 	static int peak_work_queue_length ();
 	static int setup_peakfile (std::shared_ptr<Source>, bool async);
+	/** (Re)build the peak mipmap of @p as in a peak building thread */
+	static void build_peak_mip (std::shared_ptr<AudioSource const> as);
 };
 
 } // namespace ARDOUR
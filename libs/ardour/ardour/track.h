@@ -24,6 +24,8 @@
 
 #include <memory>
 
+#include <boost/optional.hpp>
+
 #include "pbd/enum_convert.h"
 
 #include "ardour/interthread_info.h"
@@ -40,6 +42,7 @@ class Region;
 class DiskReader;
 class DiskWriter;
 class IO;
+class ReadAhead;
 class RecordEnableControl;
 class RecordSafeControl;
 class MidiNoteTracker;
@@ -149,6 +152,7 @@ public:
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (OverwriteReason);
 	int seek (samplepos_t, bool complete_refill = false);
+	void read_ahead (ReadAhead&, boost::optional<samplepos_t> seek_to = boost::none);
 	bool can_internal_playback_seek (samplecnt_t);
 	void internal_playback_seek (samplecnt_t);
 	void non_realtime_locate (samplepos_t);
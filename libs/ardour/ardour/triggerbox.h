@@ -45,6 +45,7 @@
 #include "evoral/PatchChange.h"
 #include "evoral/SMF.h"
 
+#include "ardour/clip_sample_cache.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_state_tracker.h"
 #include "ardour/processor.h"
@@ -534,8 +535,9 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	void retrigger ();
 
   private:
-	struct Data : std::vector<Sample*> {
+	struct Data : std::vector<Sample const*> {
 		samplecnt_t length;
+		std::vector<ClipSampleCache::EntryPtr> refs; /* shared clip data, see ClipSampleCache */
 
 		Data () : length (0) {}
 	};
@@ -515,4 +515,222 @@ arm_neon_copy_vector(
 	}
 }
 
+
+float
+arm_neon_apply_gain_ramp(float *buf, uint32_t nframes, float gain, float target, float coeff)
+{
+	// The distance to the target decays by (1 - coeff) per sample
+	const float r = 1.f - coeff;
+	float delta = gain - target;
+
+	if (nframes >= 4) {
+		const float pw[4] = { 1.f, r, r * r, r * r * r };
+		const float32x4_t vtarget = vdupq_n_f32(target);
+		float32x4_t vdelta = vmulq_n_f32(vld1q_f32(pw), delta);
+		const float r4 = pw[3] * r;
+
+		while (nframes >= 4) {
+			float32x4_t x0 = vld1q_f32(buf);
+			x0 = vmulq_f32(x0, vaddq_f32(vtarget, vdelta));
+			vst1q_f32(buf, x0);
+			vdelta = vmulq_n_f32(vdelta, r4);
+
+			buf += 4;
+			nframes -= 4;
+		}
+
+		delta = vgetq_lane_f32(vdelta, 0);
+	}
+
+	return default_apply_gain_ramp(buf, nframes, target + delta, target, coeff);
+}
+
+void
+arm_neon_interleave(float *dst, const float *src, uint32_t nframes, uint32_t chn, uint32_t n_chn)
+{
+	if (n_chn != 2) {
+		default_interleave(dst, src, nframes, chn, n_chn);
+		return;
+	}
+
+	while (nframes >= 4) {
+		float32x4x2_t x = vld2q_f32(dst);
+		x.val[chn & 1] = vld1q_f32(src);
+		vst2q_f32(dst, x);
+
+		src += 4;
+		dst += 8;
+		nframes -= 4;
+	}
+
+	default_interleave(dst, src, nframes, chn, n_chn);
+}
+
+void
+arm_neon_deinterleave(float *dst, const float *src, uint32_t nframes, uint32_t chn, uint32_t n_chn)
+{
+	if (n_chn != 2) {
+		default_deinterleave(dst, src, nframes, chn, n_chn);
+		return;
+	}
+
+	while (nframes >= 4) {
+		float32x4x2_t x = vld2q_f32(src);
+		vst1q_f32(dst, x.val[chn & 1]);
+
+		src += 8;
+		dst += 4;
+		nframes -= 4;
+	}
+
+	default_deinterleave(dst, src, nframes, chn, n_chn);
+}
+
+void
+arm_neon_float_to_int16(int16_t *dst, const float *src, uint32_t nframes)
+{
+#ifdef __aarch64__
+	// vcvtnq rounds to nearest (like lrintf), vqmovn saturates
+	const float32x4_t vmin = vdupq_n_f32(-32768.f);
+	const float32x4_t vmax = vdupq_n_f32(32767.f);
+
+	while (nframes >= 8) {
+		float32x4_t x0 = vmulq_n_f32(vld1q_f32(src + 0), 32768.f);
+		float32x4_t x1 = vmulq_n_f32(vld1q_f32(src + 4), 32768.f);
+		x0 = vminq_f32(vmaxq_f32(x0, vmin), vmax);
+		x1 = vminq_f32(vmaxq_f32(x1, vmin), vmax);
+		int16x4_t i0 = vqmovn_s32(vcvtnq_s32_f32(x0));
+		int16x4_t i1 = vqmovn_s32(vcvtnq_s32_f32(x1));
+		vst1q_s16(dst, vcombine_s16(i0, i1));
+
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+#endif
+
+	default_float_to_int16(dst, src, nframes);
+}
+
+void
+arm_neon_int16_to_float(float *dst, const int16_t *src, uint32_t nframes)
+{
+	const float scale = 1.f / 32768.f;
+
+	while (nframes >= 8) {
+		int16x8_t i = vld1q_s16(src);
+		float32x4_t x0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(i)));
+		float32x4_t x1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(i)));
+		vst1q_f32(dst + 0, vmulq_n_f32(x0, scale));
+		vst1q_f32(dst + 4, vmulq_n_f32(x1, scale));
+
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	default_int16_to_float(dst, src, nframes);
+}
+
+void
+arm_neon_float_to_int24(int32_t *dst, const float *src, uint32_t nframes)
+{
+#ifdef __aarch64__
+	const float32x4_t vmin = vdupq_n_f32(-8388608.f);
+	const float32x4_t vmax = vdupq_n_f32(8388607.f);
+
+	while (nframes >= 4) {
+		float32x4_t x0 = vmulq_n_f32(vld1q_f32(src), 8388608.f);
+		x0 = vminq_f32(vmaxq_f32(x0, vmin), vmax);
+		vst1q_s32(dst, vcvtnq_s32_f32(x0));
+
+		src += 4;
+		dst += 4;
+		nframes -= 4;
+	}
+#endif
+
+	default_float_to_int24(dst, src, nframes);
+}
+
+void
+arm_neon_int24_to_float(float *dst, const int32_t *src, uint32_t nframes)
+{
+	const float scale = 1.f / 8388608.f;
+
+	while (nframes >= 4) {
+		float32x4_t x0 = vcvtq_f32_s32(vld1q_s32(src));
+		vst1q_f32(dst, vmulq_n_f32(x0, scale));
+
+		src += 4;
+		dst += 4;
+		nframes -= 4;
+	}
+
+	default_int24_to_float(dst, src, nframes);
+}
+
+void
+arm_neon_invert_polarity(float *buf, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		float32x4_t x0 = vld1q_f32(buf + 0);
+		float32x4_t x1 = vld1q_f32(buf + 4);
+		vst1q_f32(buf + 0, vnegq_f32(x0));
+		vst1q_f32(buf + 4, vnegq_f32(x1));
+
+		buf += 8;
+		nframes -= 8;
+	}
+
+	default_invert_polarity(buf, nframes);
+}
+
+void
+arm_neon_mix_buffers_inverted(float *dst, const float *src, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		float32x4_t d0 = vld1q_f32(dst + 0);
+		float32x4_t d1 = vld1q_f32(dst + 4);
+		d0 = vsubq_f32(d0, vld1q_f32(src + 0));
+		d1 = vsubq_f32(d1, vld1q_f32(src + 4));
+		vst1q_f32(dst + 0, d0);
+		vst1q_f32(dst + 4, d1);
+
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	default_mix_buffers_inverted(dst, src, nframes);
+}
+
+void
+arm_neon_mix_buffers_with_gain_ramp(float *dst, const float *src, uint32_t nframes, float gain, float target)
+{
+	if (nframes == 0) {
+		return;
+	}
+
+	const float delta = (target - gain) / nframes;
+	uint32_t i = 0;
+
+	if (nframes >= 4) {
+		const float idx[4] = { 0.f, 1.f, 2.f, 3.f };
+		const float32x4_t vdelta4 = vdupq_n_f32(4.f * delta);
+		float32x4_t vgain = vmlaq_n_f32(vdupq_n_f32(gain), vld1q_f32(idx), delta);
+
+		for (; i + 4 <= nframes; i += 4) {
+			float32x4_t d = vld1q_f32(dst + i);
+			d = vmlaq_f32(d, vld1q_f32(src + i), vgain);
+			vst1q_f32(dst + i, d);
+			vgain = vaddq_f32(vgain, vdelta4);
+		}
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] += src[i] * (gain + i * delta);
+	}
+}
+
 #endif
@@ -302,6 +302,32 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 	return cnt;
 }
 
+void
+AudioPlaylist::read_ahead (ReadAhead& ra, timepos_t const & start, timecnt_t const & cnt, uint32_t chan_n)
+{
+	Playlist::RegionReadLock rl (this);
+
+	/* regions that are hidden by opaque regions on higher layers
+	 * are included, the read-ahead is only advisory.
+	 */
+	std::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt);
+
+	samplepos_t const s = start.samples ();
+	samplepos_t const e = (start + cnt).samples ();
+
+	for (auto const& r : *all) {
+		std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (r);
+		if (!ar || ar->muted ()) {
+			continue;
+		}
+		samplepos_t const rs = max (ar->position_sample (), s);
+		samplepos_t const re = min (ar->position_sample () + ar->length_samples (), e);
+		if (re > rs) {
+			ar->read_ahead (ra, rs, re - rs, chan_n);
+		}
+	}
+}
+
 void
 AudioPlaylist::dump () const
 {
@@ -344,6 +370,7 @@ AudioPlaylist::destroy_region (std::shared_ptr<Region> region)
 
 			if ((*i) == region) {
 				regions.erase (i);
+				remove_region_from_index (region);
 				changed = true;
 			}
 
@@ -40,6 +40,8 @@ AudioPort::AudioPort (const std::string& name, PortFlags flags)
 	: Port (name, DataType::AUDIO, flags)
 	, _buffer (new AudioBuffer (0))
 	, _data (0)
+	, _src_stale (false)
+	, _shared_src_cycle (0)
 {
 	assert (name.find_first_of (':') == string::npos);
 	_src.setup (resampler_quality ());
@@ -72,6 +74,11 @@ AudioPort::cycle_start (pframes_t nframes)
 		_src.reset ();
 		memset (_data, 0, _cycle_nframes * sizeof (float));
 	} else {
+		if (_src_stale) {
+			/* data was shared with another port, resampler history is outdated */
+			_src.reset ();
+			_src_stale = false;
+		}
 		_src.inp_data  = (float*)port_engine.get_buffer (_port_handle, nframes);
 		_src.inp_count = nframes;
 		_src.out_count = _cycle_nframes;
@@ -86,6 +93,16 @@ AudioPort::cycle_start (pframes_t nframes)
 	}
 }
 
+void
+AudioPort::cycle_start_shared (pframes_t nframes, AudioPort const& src)
+{
+	/* caller must hold process lock, src.cycle_start() must have been called */
+	assert (!sends_output ());
+	Port::cycle_start (nframes);
+	copy_vector (_data, src._data, _cycle_nframes);
+	_src_stale = true;
+}
+
 void
 AudioPort::cycle_end (pframes_t nframes)
 {
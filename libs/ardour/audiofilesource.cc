@@ -165,6 +165,7 @@ AudioFileSource::~AudioFileSource ()
 	if (removable()) {
 		::g_unlink (_path.c_str());
 		::g_unlink (_peakpath.c_str());
+		remove_peak_mip ();
 	}
 }
 
@@ -261,6 +262,7 @@ AudioFileSource::mark_streaming_write_completed (const WriterLock& lock)
 int
 AudioFileSource::move_dependents_to_trash()
 {
+	remove_peak_mip ();
 	return ::g_unlink (_peakpath.c_str());
 }
 
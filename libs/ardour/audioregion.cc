@@ -794,6 +794,38 @@ AudioRegion::read_from_sources (SourceList const & srcs, samplecnt_t limit, Samp
 	return to_read;
 }
 
+/** Add the source data that is read for \a cnt samples from session
+ *  position \a position of channel \a chan_n to \a ra.
+ */
+void
+AudioRegion::read_ahead (ReadAhead& ra, samplepos_t position, samplecnt_t cnt, uint32_t chan_n) const
+{
+	if (n_channels () == 0) {
+		return;
+	}
+
+	sampleoffset_t const internal_offset = position - position_sample ();
+
+	if (internal_offset < 0 || internal_offset >= length_samples ()) {
+		return;
+	}
+
+	cnt = min (cnt, length_samples () - internal_offset);
+
+	if (chan_n >= n_channels ()) {
+		if (!Config->get_replicate_missing_region_channels ()) {
+			return;
+		}
+		chan_n = chan_n % n_channels ();
+	}
+
+	std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (_sources[chan_n]);
+
+	if (afs) {
+		afs->read_ahead (ra, _start.val().samples() + internal_offset, cnt);
+	}
+}
+
 XMLNode&
 AudioRegion::get_basic_state () const
 {
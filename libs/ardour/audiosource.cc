@@ -60,9 +60,11 @@
 #include "pbd/xml++.h"
 
 #include "ardour/audiosource.h"
+#include "ardour/filename_extensions.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
+#include "ardour/source_factory.h"
 
 #include "pbd/i18n.h"
 
@@ -79,6 +81,51 @@ bool AudioSource::_build_peakfiles = false;
 
 #define _FPP 256
 
+namespace {
+
+/* Header of peak mipmap files. Level k (k >= 1) follows the header
+ * (after level k-1) and holds ceil (base_peaks / 2^k) peaks, each
+ * covering _FPP * 2^k samples. Data is in native byte-order, like the
+ * peakfile itself.
+ */
+struct PeakMipHeader {
+	char     magic[4];
+	uint32_t version;
+	uint32_t fpp;
+	uint32_t levels;
+	int64_t  base_size;  ///< size of the peakfile this was built from
+	int64_t  base_mtime; ///< modification time of that peakfile
+	int64_t  base_peaks; ///< number of peaks used from the peakfile
+};
+
+static const char     peak_mip_magic[4]   = { 'A', 'P', 'M', 'P' };
+static const uint32_t peak_mip_version    = 2;
+static const int64_t  peak_mip_min_peaks  = 64; // smallest level to write
+static const uint32_t peak_mip_max_levels = 24;
+
+static int64_t
+peak_mip_level_size (int64_t base_peaks, uint32_t level)
+{
+	return (base_peaks + (((int64_t) 1) << level) - 1) >> level;
+}
+
+static bool
+read_all (int fd, void* buf, size_t len)
+{
+	char* p = (char*) buf;
+	while (len > 0) {
+		ssize_t r = ::read (fd, p, len);
+		if (r <= 0) {
+			return false;
+		}
+		p   += r;
+		len -= r;
+	}
+	return true;
+}
+
+}
+
 AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _peak_byte_max (0)
@@ -92,6 +139,7 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _peak_mip_queued (false)
 {
 }
 
@@ -108,6 +156,7 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _peak_mip_queued (false)
 {
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
@@ -220,6 +269,9 @@ AudioSource::rename_peakfile (string newpath)
 
 	string oldpath = _peakpath;
 
+	/* the mipmap will be re-created from the renamed peakfile when needed */
+	remove_peak_mip ();
+
 	if (Glib::file_test (oldpath, Glib::FILE_TEST_EXISTS)) {
 		if (g_rename (oldpath.c_str(), newpath.c_str()) != 0) {
 			error << string_compose (_("cannot rename peakfile for %1 from %2 to %3 (%4)"), _name, oldpath, newpath, strerror (errno)) << endmsg;
@@ -497,6 +549,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		return 0;
 	}
 
+	if (scale < 1.0 && samples_per_file_peak == _FPP && samples_per_visual_peak >= 2 * _FPP) {
+		/* zoomed out, use reduced resolution peaks if available */
+		if (read_peaks_from_mip (peaks, npeaks, read_npeaks, start, cnt, samples_per_visual_peak) == 0) {
+			return 0;
+		}
+	}
+
 	if (scale == 1.0) {
 		off_t first_peak_byte = (start / samples_per_file_peak) * sizeof (PeakData);
 		size_t bytes_to_read = sizeof (PeakData) * read_npeaks;
@@ -766,6 +825,228 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 	return 0;
 }
 
+string
+AudioSource::peak_mip_path () const
+{
+	return _peakpath + peakmip_suffix;
+}
+
+void
+AudioSource::remove_peak_mip () const
+{
+	if (!_peakpath.empty ()) {
+		Glib::Threads::Mutex::Lock lm (_peak_mip_lock);
+		::g_unlink (peak_mip_path ().c_str ());
+	}
+}
+
+/** (Re)build the peak mipmap file from the current peakfile. */
+int
+AudioSource::build_peak_mip () const
+{
+	Glib::Threads::Mutex::Lock lm (_peak_mip_lock);
+
+	/* changes from now on need another build */
+	_peak_mip_queued = false;
+
+	if (_peakpath.empty () || 0 != (_flags & NoPeakFile)) {
+		return -1;
+	}
+
+	GStatBuf statbuf;
+
+	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
+		return -1;
+	}
+
+	PeakMipHeader h;
+	memcpy (h.magic, peak_mip_magic, sizeof (h.magic));
+	h.version    = peak_mip_version;
+	h.fpp        = _FPP;
+	h.levels     = 0;
+	h.base_size  = statbuf.st_size;
+	h.base_mtime = statbuf.st_mtime;
+	h.base_peaks = std::min<int64_t> (statbuf.st_size / sizeof (PeakData), (_length.samples() + _FPP - 1) / _FPP);
+
+	while (h.levels < peak_mip_max_levels && peak_mip_level_size (h.base_peaks, h.levels + 1) >= peak_mip_min_peaks) {
+		++h.levels;
+	}
+
+	std::vector<PeakData> level;
+
+	if (h.levels > 0) {
+		ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+		level.resize (h.base_peaks);
+		if (sfd < 0 || !read_all (sfd, &level[0], h.base_peaks * sizeof (PeakData))) {
+			error << string_compose (_("Cannot read peakfile @ %1 to build mipmap (%2)"), _peakpath, strerror (errno)) << endmsg;
+			return -1;
+		}
+	}
+
+	string const path = peak_mip_path ();
+	string const tmp  = path + temp_suffix;
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Build peak mipmap %1 with %2 levels\n", path, h.levels));
+
+	{
+		ScopedFileDescriptor sfd (g_open (tmp.c_str(), O_CREAT|O_TRUNC|O_RDWR, 0664));
+
+		if (sfd < 0) {
+			error << string_compose (_("Cannot open peak mipmap @ %1 for writing (%2)"), tmp, strerror (errno)) << endmsg;
+			return -1;
+		}
+
+		bool ok = ::write (sfd, &h, sizeof (h)) == sizeof (h);
+		size_t n = level.size ();
+
+		for (uint32_t l = 1; ok && l <= h.levels; ++l) {
+			/* reduce in-place: each peak combines two peaks of the previous level */
+			size_t const m = (n + 1) / 2;
+			for (size_t i = 0; i < m; ++i) {
+				PeakData p = level[2 * i];
+				if (2 * i + 1 < n) {
+					p.min = min (p.min, level[2 * i + 1].min);
+					p.max = max (p.max, level[2 * i + 1].max);
+				}
+				level[i] = p;
+			}
+			n = m;
+			assert ((int64_t) n == peak_mip_level_size (h.base_peaks, l));
+			ok = ::write (sfd, &level[0], n * sizeof (PeakData)) == (ssize_t) (n * sizeof (PeakData));
+		}
+
+		if (!ok) {
+			error << string_compose (_("%1: could not write peak mipmap data (%2)"), _name, strerror (errno)) << endmsg;
+			::g_unlink (tmp.c_str ());
+			return -1;
+		}
+	}
+
+	if (g_rename (tmp.c_str (), path.c_str ()) != 0) {
+		::g_unlink (tmp.c_str ());
+		return -1;
+	}
+
+	return 0;
+}
+
+/** Read peaks for zoomed-out views from the level of the peak mipmap
+ * closest to (but not coarser than) the requested resolution.
+ * Caller must hold _lock.
+ *
+ * @return 0 on success, -1 if there is no suitable mipmap.
+ */
+int
+AudioSource::read_peaks_from_mip (PeakData *peaks, samplecnt_t npeaks, samplecnt_t read_npeaks,
+                                  samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
+{
+	if (_peakpath.empty () || 0 != (_flags & NoPeakFile)) {
+		return -1;
+	}
+
+	GStatBuf statbuf;
+
+	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
+		return -1;
+	}
+
+	string const  path = peak_mip_path ();
+	PeakMipHeader h;
+	bool          valid;
+
+	{
+		ScopedFileDescriptor sfd (g_open (path.c_str(), O_RDONLY, 0444));
+		valid = sfd >= 0
+			&& read_all (sfd, &h, sizeof (h))
+			&& !memcmp (h.magic, peak_mip_magic, sizeof (h.magic))
+			&& h.version == peak_mip_version
+			&& h.fpp == _FPP
+			&& h.levels <= peak_mip_max_levels
+			&& h.base_size == (int64_t) statbuf.st_size
+			&& h.base_mtime == (int64_t) statbuf.st_mtime;
+	}
+
+	if (!valid) {
+		/* missing or stale, (re)build it in the background from
+		 * complete peak data, and use the peakfile until then.
+		 */
+		bool built;
+		{
+			Glib::Threads::Mutex::Lock lp (_peaks_ready_lock);
+			built = _peaks_built;
+		}
+		if (built && SourceFactory::peak_thread_run && !_peak_mip_queued.exchange (true)) {
+			SourceFactory::build_peak_mip (std::dynamic_pointer_cast<AudioSource const> (shared_from_this ()));
+		}
+		return -1;
+	}
+
+	/* coarsest level that still has at least one stored peak per visual peak */
+	uint32_t level = 0;
+	while (level < h.levels && (double) (((samplecnt_t) _FPP) << (level + 1)) <= samples_per_visual_peak) {
+		++level;
+	}
+
+	if (level == 0) {
+		return -1;
+	}
+
+	samplecnt_t const fpp     = ((samplecnt_t) _FPP) << level;
+	int64_t const     lsize   = peak_mip_level_size (h.base_peaks, level);
+	off_t             offset  = sizeof (PeakMipHeader);
+
+	for (uint32_t l = 1; l < level; ++l) {
+		offset += peak_mip_level_size (h.base_peaks, l) * sizeof (PeakData);
+	}
+
+	if (read_npeaks <= 0 || cnt <= 0 || start / fpp >= lsize) {
+		memset (peaks, 0, sizeof (PeakData) * npeaks);
+		return 0;
+	}
+
+	int64_t const first = start / fpp;
+	int64_t const last  = std::min<int64_t> ((start + cnt - 1) / fpp, lsize - 1);
+	int64_t const n     = last - first + 1;
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("MIPMAP level %1 (fpp %2): read %3 peaks for %4 visual peaks\n", level, fpp, n, read_npeaks));
+
+	boost::scoped_array<PeakData> staging (new PeakData[n]);
+
+	{
+		ScopedFileDescriptor sfd (g_open (path.c_str(), O_RDONLY, 0444));
+		off_t const pos = offset + first * sizeof (PeakData);
+		if (sfd < 0 || lseek (sfd, pos, SEEK_SET) != pos || !read_all (sfd, staging.get (), n * sizeof (PeakData))) {
+			error << string_compose (_("Cannot read peak mipmap @ %1 (%2)"), path, strerror (errno)) << endmsg;
+			return -1;
+		}
+	}
+
+	for (samplecnt_t i = 0; i < read_npeaks; ++i) {
+		samplepos_t const s0 = start + (samplepos_t) floor (i * samples_per_visual_peak);
+		samplepos_t const s1 = start + (samplepos_t) ceil ((i + 1) * samples_per_visual_peak);
+
+		int64_t p0 = std::min<int64_t> (s0 / fpp - first, n - 1);
+		int64_t p1 = std::min<int64_t> ((s1 - 1) / fpp - first, n - 1);
+
+		PeakData::PeakDatum xmax = staging[p0].max;
+		PeakData::PeakDatum xmin = staging[p0].min;
+
+		for (int64_t p = p0 + 1; p <= p1; ++p) {
+			xmax = max (xmax, staging[p].max);
+			xmin = min (xmin, staging[p].min);
+		}
+
+		peaks[i].max = xmax;
+		peaks[i].min = xmin;
+	}
+
+	if (npeaks > read_npeaks) {
+		memset (&peaks[read_npeaks], 0, sizeof (PeakData) * (npeaks - read_npeaks));
+	}
+
+	return 0;
+}
+
 int
 AudioSource::build_peaks_from_scratch ()
 {
@@ -850,6 +1131,7 @@ AudioSource::close_peakfile ()
 	}
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
+		remove_peak_mip ();
 	}
 	_peaks_built = false;
 	return 0;
@@ -890,9 +1172,18 @@ AudioSource::done_with_peakfile_writes (bool done)
 	}
 
 	if (done) {
-		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
-		_peaks_built = true;
-		PeaksReady (); /* EMIT SIGNAL */
+		{
+			Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+			_peaks_built = true;
+			PeaksReady (); /* EMIT SIGNAL */
+		}
+
+		/* this may be the butler at the end of a capture, so leave the
+		 * mipmap to the peak thread; reads use the peakfile until then.
+		 */
+		if (SourceFactory::peak_thread_run && !_peak_mip_queued.exchange (true)) {
+			SourceFactory::build_peak_mip (std::dynamic_pointer_cast<AudioSource const> (shared_from_this ()));
+		}
 	}
 }
 
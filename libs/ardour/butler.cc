@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -36,10 +37,12 @@
 
 #include "ardour/auditioner.h"
 #include "ardour/butler.h"
+#include "ardour/capture_writer.h"
 #include "ardour/debug.h"
 #include "ardour/disk_io.h"
 #include "ardour/disk_reader.h"
 #include "ardour/io.h"
+#include "ardour/read_ahead.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
 
@@ -59,8 +62,15 @@ Butler::Butler (Session& s)
 	, _midi_buffer_size (0)
 	, pool_trash (16)
 	, _xthread (true)
+	, _io_next (0)
+	, _io_pending (0)
+	, _io_run (false)
+	, _capture_writer (0)
+	, _read_ahead (0)
 {
 	should_do_transport_work.store (0);
+	_io_work_outstanding.store (false);
+	_io_errors.store (0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
 	/* catch future changes to parameters */
@@ -144,6 +154,20 @@ Butler::start_thread ()
 	//pthread_detach (thread);
 	have_thread = true;
 
+	start_io_threads (Config->get_butler_io_threads ());
+
+	if (Config->get_capture_writer_threads () > 0) {
+		_capture_writer = new CaptureWriter (Config->get_capture_writer_threads ());
+		if (_capture_writer->n_threads () == 0) {
+			delete _capture_writer;
+			_capture_writer = 0;
+		}
+	}
+
+	if (Config->get_read_ahead_threads () > 0) {
+		_read_ahead = new ReadAhead (Config->get_read_ahead_threads ());
+	}
+
 	// we are ready to request buffer adjustments
 	_session.adjust_capture_buffering ();
 	_session.adjust_playback_buffering ();
@@ -160,6 +184,14 @@ Butler::terminate_thread ()
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
 	}
+	stop_io_threads ();
+
+	/* all pending writes are completed */
+	delete _capture_writer;
+	_capture_writer = 0;
+
+	delete _read_ahead;
+	_read_ahead = 0;
 }
 
 void*
@@ -173,9 +205,8 @@ Butler::_thread_work (void* arg)
 void*
 Butler::thread_work ()
 {
-	uint32_t            err                   = 0;
-	bool                disk_work_outstanding = false;
-	RouteList::iterator i;
+	uint32_t err                   = 0;
+	bool     disk_work_outstanding = false;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time ()));
@@ -253,42 +284,7 @@ Butler::thread_work ()
 
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested ()));
 
-		for (i = rl_with_auditioner.begin (); !transport_work_requested () && should_run && i != rl_with_auditioner.end (); ++i) {
-			std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (*i);
-
-			if (!tr) {
-				continue;
-			}
-
-			std::shared_ptr<IO> io = tr->input ();
-
-			if (io && !io->active ()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-				case 0:
-					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-					break;
-
-				case 1:
-					DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name ()));
-					disk_work_outstanding = true;
-					break;
-
-				default:
-					error << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << endmsg;
-					std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << std::endl;
-					break;
-			}
-		}
-
-		if (i != rl_with_auditioner.begin () && i != rl_with_auditioner.end ()) {
-			/* we didn't get to all the streams */
-			disk_work_outstanding = true;
-		}
+		disk_work_outstanding = refill_tracks (rl_with_auditioner);
 
 		if (!err && transport_work_requested ()) {
 			DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill, back to restart\n");
@@ -335,11 +331,119 @@ Butler::thread_work ()
 	return (0);
 }
 
+/** Refill the playback buffers of all active tracks.
+ *
+ * Tracks with the least amount of buffered data are served first.
+ * If there are disk I/O threads, tracks are refilled concurrently.
+ *
+ * @return true if there is outstanding disk work
+ */
+bool
+Butler::refill_tracks (RouteList const& rl)
+{
+	bool disk_work_outstanding = false;
+
+	std::vector<std::pair<float, std::shared_ptr<Track> > > tracks;
+	tracks.reserve (rl.size ());
+
+	for (auto const& r : rl) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+
+		if (!tr) {
+			continue;
+		}
+
+		std::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active ()) {
+			/* don't read inactive tracks */
+			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
+			continue;
+		}
+
+		tracks.push_back (std::make_pair (tr->playback_buffer_load (), tr));
+	}
+
+	std::stable_sort (tracks.begin (), tracks.end (),
+	                  [] (std::pair<float, std::shared_ptr<Track> > const& a, std::pair<float, std::shared_ptr<Track> > const& b) { return a.first < b.first; });
+
+	if (_read_ahead) {
+		/* queue the next chunk of all tracks at once */
+		for (auto const& t : tracks) {
+			t.second->read_ahead (*_read_ahead);
+		}
+		_read_ahead->commit ();
+	}
+
+	if (!_io_threads.empty ()) {
+		std::vector<IOJob> jobs;
+		jobs.reserve (tracks.size ());
+		for (auto const& t : tracks) {
+			jobs.push_back (IOJob (t.second, IOJob::Refill));
+		}
+		uint32_t errors = 0;
+		return run_io_jobs (jobs, errors);
+	}
+
+	std::vector<std::pair<float, std::shared_ptr<Track> > >::const_iterator i;
+
+	for (i = tracks.begin (); !transport_work_requested () && should_run && i != tracks.end (); ++i) {
+		std::shared_ptr<Track> const& tr (i->second);
+		// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), i->first));
+		switch (tr->do_refill ()) {
+			case 0:
+				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+				break;
+
+			case 1:
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name ()));
+				disk_work_outstanding = true;
+				break;
+
+			default:
+				error << string_compose (_("Butler read ahead failure on dstream %1"), tr->name ()) << endmsg;
+				std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), tr->name ()) << std::endl;
+				break;
+		}
+	}
+
+	if (i != tracks.begin () && i != tracks.end ()) {
+		/* we didn't get to all the streams */
+		disk_work_outstanding = true;
+	}
+
+	return disk_work_outstanding;
+}
+
 bool
 Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32_t& errors)
 {
 	bool disk_work_outstanding = false;
 
+	if (!_io_threads.empty ()) {
+		/* flush concurrently, tracks with the least space in the capture buffer first */
+		std::vector<std::pair<float, std::shared_ptr<Track> > > tracks;
+		tracks.reserve (rl->size ());
+
+		for (auto const& r : *rl) {
+			std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+			/* note that we still try to flush diskstreams attached to inactive routes */
+			if (tr) {
+				tracks.push_back (std::make_pair (tr->capture_buffer_load (), tr));
+			}
+		}
+
+		std::stable_sort (tracks.begin (), tracks.end (),
+		                  [] (std::pair<float, std::shared_ptr<Track> > const& a, std::pair<float, std::shared_ptr<Track> > const& b) { return a.first < b.first; });
+
+		std::vector<IOJob> jobs;
+		jobs.reserve (tracks.size ());
+		for (auto const& t : tracks) {
+			jobs.push_back (IOJob (t.second, IOJob::Flush));
+		}
+		return run_io_jobs (jobs, errors);
+	}
+
 	for (RouteList::const_iterator i = rl->begin (); !transport_work_requested () && should_run && i != rl->end (); ++i) {
 		// cerr << "write behind for " << (*i)->name () << endl;
 
@@ -379,6 +483,168 @@ Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32
 	return disk_work_outstanding;
 }
 
+void
+Butler::start_io_threads (uint32_t n_threads)
+{
+	assert (_io_threads.empty ());
+
+	/* The butler thread itself also processes jobs, so a single
+	 * extra thread is the minimum for concurrent disk I/O.
+	 */
+	if (n_threads < 2) {
+		return;
+	}
+
+	_io_run = true;
+
+	for (uint32_t n = 1; n < n_threads; ++n) {
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&Butler::io_thread_work, this), string_compose ("butler io %1", n));
+		if (!t) {
+			error << _("Session: could not create butler I/O thread") << endmsg;
+			break;
+		}
+		_io_threads.push_back (t);
+	}
+}
+
+void
+Butler::stop_io_threads ()
+{
+	if (_io_threads.empty ()) {
+		return;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_io_lock);
+		_io_run = false;
+		_io_cond.broadcast ();
+	}
+
+	for (auto& t : _io_threads) {
+		t->join ();
+		delete t;
+	}
+
+	_io_threads.clear ();
+	_io_jobs.clear ();
+}
+
+void
+Butler::io_thread_work ()
+{
+	SessionEvent::create_per_thread_pool (X_("butler io events"), 64);
+	DiskReader::allocate_thread_working_buffers ();
+
+	Glib::Threads::Mutex::Lock lm (_io_lock);
+
+	while (true) {
+		while (_io_run && _io_next >= _io_jobs.size ()) {
+			_io_cond.wait (_io_lock);
+		}
+
+		if (!_io_run) {
+			break;
+		}
+
+		IOJob const& job (_io_jobs[_io_next++]);
+
+		lm.release ();
+		Temporal::TempoMap::fetch ();
+		process_io_job (job);
+		lm.acquire ();
+
+		if (--_io_pending == 0) {
+			_io_done.signal ();
+		}
+	}
+}
+
+/** Process \a jobs using the disk I/O threads and the butler thread.
+ * Returns when all jobs are complete. \a jobs is consumed.
+ *
+ * @return true if there is outstanding disk work
+ */
+bool
+Butler::run_io_jobs (std::vector<IOJob>& jobs, uint32_t& errors)
+{
+	if (jobs.empty ()) {
+		return false;
+	}
+
+	_io_work_outstanding.store (false);
+	_io_errors.store (0);
+
+	Glib::Threads::Mutex::Lock lm (_io_lock);
+
+	/* the I/O threads only look at the job list with _io_lock held */
+	assert (_io_jobs.empty () && _io_pending == 0);
+	_io_jobs.swap (jobs);
+	_io_next    = 0;
+	_io_pending = _io_jobs.size ();
+	_io_cond.broadcast ();
+
+	/* the butler thread lends a hand, too */
+	while (_io_next < _io_jobs.size ()) {
+		IOJob const& job (_io_jobs[_io_next++]);
+		lm.release ();
+		process_io_job (job);
+		lm.acquire ();
+		--_io_pending;
+	}
+
+	while (_io_pending > 0) {
+		_io_done.wait (_io_lock);
+	}
+
+	_io_jobs.clear ();
+	_io_next = 0;
+
+	errors += _io_errors.load ();
+	return _io_work_outstanding.load ();
+}
+
+void
+Butler::process_io_job (IOJob const& job)
+{
+	if (transport_work_requested () || !should_run) {
+		/* skip, the job will be scheduled again */
+		_io_work_outstanding.store (true);
+		return;
+	}
+
+	switch (job.type) {
+		case IOJob::Refill:
+			switch (job.track->do_refill ()) {
+				case 0:
+					break;
+				case 1:
+					DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", job.track->name ()));
+					_io_work_outstanding.store (true);
+					break;
+				default:
+					error << string_compose (_("Butler read ahead failure on dstream %1"), job.track->name ()) << endmsg;
+					std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), job.track->name ()) << std::endl;
+					break;
+			}
+			break;
+
+		case IOJob::Flush:
+			switch (job.track->do_flush (ButlerContext, false)) {
+				case 0:
+					break;
+				case 1:
+					_io_work_outstanding.store (true);
+					break;
+				default:
+					_io_errors.fetch_add (1);
+					error << string_compose (_("Butler write-behind failure on dstream %1"), job.track->name ()) << endmsg;
+					std::cerr << string_compose (_("Butler write-behind failure on dstream %1"), job.track->name ()) << std::endl;
+					break;
+			}
+			break;
+	}
+}
+
 void
 Butler::schedule_transport_work ()
 {
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cassert>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/audiofilesource.h"
+#include "ardour/capture_writer.h"
+#include "ardour/session_event.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+CaptureWriter::CaptureWriter (uint32_t n_threads)
+	: _run (true)
+{
+	for (uint32_t n = 0; n < n_threads; ++n) {
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&CaptureWriter::thread_work, this), string_compose ("capture writer %1", n));
+		if (!t) {
+			error << _("Session: could not create capture writer thread") << endmsg;
+			break;
+		}
+		_threads.push_back (t);
+	}
+}
+
+CaptureWriter::~CaptureWriter ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_run = false;
+		_cond.broadcast ();
+	}
+
+	for (auto& t : _threads) {
+		t->join ();
+		delete t;
+	}
+
+	/* the threads complete all queued requests before terminating */
+	assert (_requests.empty ());
+}
+
+void
+CaptureWriter::queue (std::vector<Request>& requests, std::atomic<int>& pending, std::atomic<int>& error)
+{
+	if (requests.empty ()) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (auto& r : requests) {
+		r.pending = &pending;
+		r.error   = &error;
+		_requests.push_back (r);
+	}
+
+	pending.fetch_add (requests.size ());
+	_cond.broadcast ();
+}
+
+void
+CaptureWriter::wait (std::atomic<int>& pending)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	while (pending.load () > 0) {
+		_done.wait (_lock);
+	}
+}
+
+void
+CaptureWriter::thread_work ()
+{
+	SessionEvent::create_per_thread_pool (X_("capture writer events"), 64);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	while (true) {
+		while (_run && _requests.empty ()) {
+			_cond.wait (_lock);
+		}
+
+		if (_requests.empty ()) {
+			/* !_run */
+			break;
+		}
+
+		Request r (_requests.front ());
+		_requests.pop_front ();
+
+		lm.release ();
+
+		bool ok = true;
+
+		for (int i = 0; i < 2 && ok; ++i) {
+			if (r.len[i] == 0) {
+				continue;
+			}
+			if (r.source->write (r.buf[i], r.len[i]) != r.len[i]) {
+				ok = false;
+				break;
+			}
+			r.wbuf->increment_read_ptr (r.len[i]);
+		}
+
+		if (!ok) {
+			r.error->store (1);
+		}
+
+		/* drop the references before the DiskWriter is notified */
+		r.source.reset ();
+		r.wbuf.reset ();
+
+		lm.acquire ();
+
+		if (r.pending->fetch_sub (1) == 1) {
+			_done.broadcast ();
+		}
+	}
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+
+#include "ardour/audioregion.h"
+#include "ardour/audiosource.h"
+#include "ardour/clip_sample_cache.h"
+#include "ardour/debug.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/session.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+ClipSampleCache::Entry::Entry ()
+	: _data (0)
+	, _length (0)
+	, _map_size (0)
+	, _mapped (false)
+	, _loaded (false)
+{
+}
+
+ClipSampleCache::Entry::~Entry ()
+{
+	release ();
+}
+
+void
+ClipSampleCache::Entry::release ()
+{
+#ifndef PLATFORM_WINDOWS
+	if (_mapped) {
+		munmap (_data, _map_size);
+		_data = 0;
+	}
+#endif
+	delete [] _data;
+
+	_data     = 0;
+	_length   = 0;
+	_map_size = 0;
+	_mapped   = false;
+	_loaded   = false;
+}
+
+int
+ClipSampleCache::Entry::load (std::shared_ptr<AudioRegion const> ar, uint32_t chn, bool use_mmap)
+{
+	release ();
+
+	if (use_mmap && 0 == load_mapped (ar, chn)) {
+		_loaded = true;
+		return 0;
+	}
+
+	samplecnt_t const len = ar->length_samples ();
+
+	try {
+		_data = new Sample[len];
+	} catch (...) {
+		return -1;
+	}
+
+	if (ar->read (_data, 0, len, chn) != len) {
+		release ();
+		return -1;
+	}
+
+	_length = len;
+	_loaded = true;
+	return 0;
+}
+
+#ifndef PLATFORM_WINDOWS
+static void
+prefault (char const* p, size_t sz)
+{
+	size_t const  page = sysconf (_SC_PAGESIZE);
+	volatile char c;
+
+	for (size_t o = 0; o < sz; o += page) {
+		c = p[o];
+	}
+	(void) c;
+}
+#endif
+
+int
+ClipSampleCache::Entry::load_mapped (std::shared_ptr<AudioRegion const> ar, uint32_t chn)
+{
+#ifdef PLATFORM_WINDOWS
+	return -1;
+#else
+	samplecnt_t const len = ar->length_samples ();
+	size_t const      sz  = len * sizeof (Sample);
+
+	if (len == 0) {
+		return -1;
+	}
+
+	/* use the session folder rather than $TMPDIR, which is often
+	 * a tmpfs and would hold the data in memory (or swap) anyway.
+	 */
+	std::string const dir      = ar->session ().cache_dir ();
+	gchar*            tmp_path = g_build_filename (dir.c_str (), "clip-XXXXXX", NULL);
+	int               fd       = -1;
+
+	if (g_mkdir_with_parents (dir.c_str (), 0755) == 0) {
+		fd = g_mkstemp (tmp_path);
+	}
+
+	if (fd < 0) {
+		warning << string_compose (_("Cannot create file for clip data in %1 (%2)"), dir, strerror (errno)) << endmsg;
+		g_free (tmp_path);
+		return -1;
+	}
+
+	/* the data stays accessible until unmapped */
+	::g_unlink (tmp_path);
+	g_free (tmp_path);
+
+	samplecnt_t const chunk = 65536;
+	Sample*           buf   = new Sample[chunk];
+	int               rv    = 0;
+
+	for (samplecnt_t pos = 0; pos < len && rv == 0; pos += chunk) {
+		samplecnt_t const n = std::min (chunk, len - pos);
+		if (ar->read (buf, pos, n, chn) != n) {
+			rv = -1;
+			break;
+		}
+		char const* p      = (char const*) buf;
+		size_t      remain = n * sizeof (Sample);
+		while (remain > 0) {
+			ssize_t w = ::write (fd, p, remain);
+			if (w < 0 && errno == EINTR) {
+				continue;
+			}
+			if (w <= 0) {
+				rv = -1;
+				break;
+			}
+			p      += w;
+			remain -= w;
+		}
+	}
+
+	delete [] buf;
+
+	if (rv == 0) {
+		void* addr = mmap (NULL, sz, PROT_READ, MAP_SHARED, fd, 0);
+		if (addr == MAP_FAILED) {
+			rv = -1;
+		} else {
+			/* triggers read from the process thread, which must not
+			 * page-fault. If locking is not permitted (RLIMIT_MEMLOCK),
+			 * at least page in all of it now.
+			 */
+			if (mlock (addr, sz)) {
+				DEBUG_TRACE (DEBUG::Triggers, string_compose ("ClipSampleCache: cannot lock clip data of %1 (%2)\n", ar->name (), strerror (errno)));
+				madvise (addr, sz, MADV_WILLNEED);
+				prefault ((char const*) addr, sz);
+			}
+			_data     = (Sample*) addr;
+			_length   = len;
+			_map_size = sz;
+			_mapped   = true;
+		}
+	}
+
+	::close (fd);
+
+	if (rv) {
+		warning << string_compose (_("Cannot memory-map clip data of %1 (%2)"), ar->name (), strerror (errno)) << endmsg;
+	}
+
+	return rv;
+#endif
+}
+
+ClipSampleCache&
+ClipSampleCache::instance ()
+{
+	static ClipSampleCache c;
+	return c;
+}
+
+ClipSampleCache::EntryPtr
+ClipSampleCache::get (std::shared_ptr<AudioRegion const> ar, uint32_t chn)
+{
+	if (!ar || chn >= ar->n_channels ()) {
+		return EntryPtr ();
+	}
+
+	Key const key (ar->audio_source (chn)->id (), ar->start_sample (), ar->length_samples ());
+
+	EntryPtr e;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		prune ();
+
+		EntryMap::iterator i = _entries.find (key);
+		if (i != _entries.end ()) {
+			e = i->second.lock ();
+		}
+		if (!e) {
+			e.reset (new Entry);
+			_entries[key] = e;
+		}
+	}
+
+	/* the first trigger to get here reads the data, others using the
+	 * same clip wait for it, and share the result.
+	 */
+	Glib::Threads::Mutex::Lock lm (e->_lock);
+
+	if (!e->_loaded) {
+		uint32_t const threshold = Config->get_clip_mmap_threshold ();
+		bool const     use_mmap  = threshold > 0 && ar->length_samples () > (samplecnt_t) threshold * ar->session ().sample_rate ();
+
+		if (e->load (ar, chn, use_mmap)) {
+			return EntryPtr ();
+		}
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("ClipSampleCache: loaded %1 chn %2, %3 samples%4\n", ar->name (), chn, e->length (), e->mapped () ? " (mapped)" : ""));
+	}
+
+	return e;
+}
+
+void
+ClipSampleCache::prune ()
+{
+	/* called with _lock held */
+	for (EntryMap::iterator i = _entries.begin (); i != _entries.end ();) {
+		if (i->second.expired ()) {
+			_entries.erase (i++);
+		} else {
+			++i;
+		}
+	}
+}
+
+size_t
+ClipSampleCache::n_entries () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	size_t n = 0;
+	for (EntryMap::const_iterator i = _entries.begin (); i != _entries.end (); ++i) {
+		if (!i->second.expired ()) {
+			++n;
+		}
+	}
+	return n;
+}
+
+size_t
+ClipSampleCache::bytes () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	size_t b = 0;
+	for (EntryMap::const_iterator i = _entries.begin (); i != _entries.end (); ++i) {
+		EntryPtr e = i->second.lock ();
+		if (e) {
+			b += e->length () * sizeof (Sample);
+		}
+	}
+	return b;
+}
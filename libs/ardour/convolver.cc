@@ -18,6 +18,7 @@
 
 #include <assert.h>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 
@@ -27,6 +28,7 @@
 #include "ardour/chan_mapping.h"
 #include "ardour/convolver.h"
 #include "ardour/dsp_filter.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/readable.h"
 #include "ardour/session.h"
 #include "ardour/source_factory.h"
@@ -46,6 +48,8 @@ Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     , _offset (0)
     , _configured (false)
     , _threaded (false)
+    , _partitioning (LowLatency)
+    , _tail_threads (Config->get_convolver_threads ())
     , _n_inputs (n_in)
     , _n_outputs (n_out)
 {
@@ -86,12 +90,37 @@ Convolution::ready () const
 	return _configured && _convproc.state () == Convproc::ST_PROC;
 }
 
+void
+Convolution::set_partitioning (Partitioning p)
+{
+	if (_partitioning == p) {
+		return;
+	}
+	_partitioning = p;
+	if (_threaded && _configured) {
+		restart ();
+	}
+}
+
+void
+Convolution::set_tail_threads (uint32_t n)
+{
+	if (_tail_threads == n) {
+		return;
+	}
+	_tail_threads = n;
+	if (_threaded && _configured) {
+		restart ();
+	}
+}
+
 void
 Convolution::restart ()
 {
 	_convproc.stop_process ();
 	_convproc.cleanup ();
 	_convproc.set_options (0);
+	_convproc.set_tail_threads (1);
 
 	if (_impdata.empty ()) {
 		_configured = false;
@@ -101,8 +130,29 @@ Convolution::restart ()
 	uint32_t n_part;
 
 	if (_threaded) {
-		_n_samples = 64;
-		n_part     = Convproc::MAXPART;
+		switch (_partitioning) {
+			case LowLatency:
+				_n_samples = 64;
+				break;
+			case Balanced:
+				_n_samples = 256;
+				break;
+			case LowCPU:
+				_n_samples = 1024;
+				break;
+		}
+		n_part = Convproc::MAXPART;
+
+		/* The first partition is processed in the RT thread,
+		 * all others in background threads with decreasing priority.
+		 * The bulk of the work for long IRs are the largest partitions,
+		 * those can be spread over several threads.
+		 */
+		uint32_t n_threads = _tail_threads;
+		if (n_threads == 0) {
+			n_threads = std::max<uint32_t> (1, std::min<uint32_t> (4, hardware_concurrency () / 2));
+		}
+		_convproc.set_tail_threads (n_threads);
 	} else {
 		_n_samples = _session.get_block_size ();
 		uint32_t power_of_two;
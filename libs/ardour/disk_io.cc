@@ -324,7 +324,6 @@ DiskIOProcessor::use_playlist (DataType dt, std::shared_ptr<Playlist> playlist)
 
 DiskIOProcessor::ChannelInfo::ChannelInfo (samplecnt_t bufsize)
 	: rbuf (0)
-	, wbuf (0)
 	, capture_transition_buf (0)
 	, curr_capture_cnt (0)
 {
@@ -333,10 +332,9 @@ DiskIOProcessor::ChannelInfo::ChannelInfo (samplecnt_t bufsize)
 DiskIOProcessor::ChannelInfo::~ChannelInfo ()
 {
 	delete rbuf;
-	delete wbuf;
 	delete capture_transition_buf;
 	rbuf = 0;
-	wbuf = 0;
+	wbuf.reset ();
 	capture_transition_buf = 0;
 }
 
@@ -38,6 +38,7 @@
 #include "ardour/pannable.h"
 #include "ardour/playlist.h"
 #include "ardour/playlist_factory.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/session.h"
 #include "ardour/session_playlists.h"
 
@@ -57,6 +58,28 @@ DiskReader::Declicker DiskReader::loop_declick_in;
 DiskReader::Declicker DiskReader::loop_declick_out;
 samplecnt_t           DiskReader::loop_fade_length (0);
 
+struct ThreadWorkingBuffers {
+	ThreadWorkingBuffers ()
+	{
+		sum_buffer     = new Sample[2 * 1048576];
+		mixdown_buffer = new Sample[2 * 1048576];
+		gain_buffer    = new gain_t[2 * 1048576];
+	}
+
+	~ThreadWorkingBuffers ()
+	{
+		delete[] sum_buffer;
+		delete[] mixdown_buffer;
+		delete[] gain_buffer;
+	}
+
+	Sample* sum_buffer;
+	Sample* mixdown_buffer;
+	gain_t* gain_buffer;
+};
+
+static Glib::Threads::Private<ThreadWorkingBuffers> thread_working_buffers;
+
 DiskReader::DiskReader (Session& s, Track& t, string const& str, Temporal::TimeDomainProvider const & tdp, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, t, X_("player:") + str, f, tdp)
 	, overwrite_sample (0)
@@ -137,6 +160,14 @@ DiskReader::allocate_working_buffers ()
 	_gain_buffer    = new gain_t[2 * 1048576];
 }
 
+void
+DiskReader::allocate_thread_working_buffers ()
+{
+	if (!thread_working_buffers.get ()) {
+		thread_working_buffers.set (new ThreadWorkingBuffers);
+	}
+}
+
 void
 DiskReader::free_working_buffers ()
 {
@@ -918,6 +949,69 @@ DiskReader::seek (samplepos_t sample, bool complete_refill)
 	return ret;
 }
 
+void
+DiskReader::read_ahead (ReadAhead& ra, boost::optional<samplepos_t> seek_to)
+{
+	std::shared_ptr<AudioPlaylist>     pl = audio_playlist ();
+	std::shared_ptr<ChannelList const> c  = channels.reader ();
+
+	if (!pl || c->empty () || _session.loading ()) {
+		return;
+	}
+
+	const bool  reversed = !_session.transport_will_roll_forwards ();
+	samplepos_t start;
+	samplecnt_t cnt;
+
+	if (seek_to) {
+		/* see seek(): a complete refill, starting "reservation" earlier */
+		if ((size_t)abs (*seek_to - playback_sample) < (c->front ()->rbuf->reserved_size () / 6)) {
+			return;
+		}
+		const samplecnt_t rsize = (samplecnt_t)c->front ()->rbuf->reservation_size ();
+		const samplecnt_t shift = min (*seek_to, rsize);
+
+		start = reversed ? *seek_to + shift : *seek_to - shift;
+		cnt   = c->front ()->rbuf->bufsize ();
+	} else {
+		/* see refill_audio() */
+		start = file_sample[DataType::AUDIO];
+		cnt   = c->front ()->rbuf->write_space ();
+		if (cnt < _chunk_samples) {
+			return;
+		}
+	}
+
+	Location* loc = reversed ? 0 : _loop_location;
+
+	if (reversed) {
+		cnt   = min (cnt, start);
+		start = start - cnt;
+	}
+
+	while (cnt > 0 && start < max_samplepos) {
+		samplecnt_t this_read = min (cnt, max_samplepos - start);
+
+		if (loc) {
+			/* like audio_read(), wrap around at the loop end */
+			const Temporal::Range loop_range (loc->start (), loc->end ());
+			start     = loop_range.squish (timepos_t (start)).samples ();
+			this_read = min (this_read, loc->end_sample () - start);
+		}
+
+		if (this_read <= 0) {
+			break;
+		}
+
+		for (uint32_t n = 0; n < c->size (); ++n) {
+			pl->read_ahead (ra, timepos_t (start), timecnt_t::from_samples (this_read), n);
+		}
+
+		start += this_read;
+		cnt   -= this_read;
+	}
+}
+
 bool
 DiskReader::can_internal_playback_seek (sampleoffset_t distance)
 {
@@ -1101,6 +1195,11 @@ int
 DiskReader::do_refill ()
 {
 	const bool reversed = !_session.transport_will_roll_forwards ();
+
+	ThreadWorkingBuffers* wb = thread_working_buffers.get ();
+	if (wb) {
+		return refill (wb->sum_buffer, wb->mixdown_buffer, wb->gain_buffer, 0, reversed);
+	}
 	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
 }
 
@@ -1592,8 +1691,10 @@ DiskReader::dec_no_disk_output ()
 
 DiskReader::DeclickAmp::DeclickAmp (samplecnt_t sample_rate)
 {
-	_a = 800.f / (gain_t)sample_rate; // ~ 1/50Hz to fade by 40dB
-	_l = -log1p (_a);
+	/* ~ 1/50Hz to fade by 40dB. This used to be applied every 4 samples,
+	 * the per-sample coefficient below results in the same decay rate.
+	 */
+	_a = 1.f - powf (1.f - 800.f / (gain_t)sample_rate, .25f);
 	_g = 0;
 }
 
@@ -1611,30 +1712,7 @@ DiskReader::DeclickAmp::apply_gain (AudioBuffer& buf, samplecnt_t n_samples, con
 		return;
 	}
 
-	const float   a      = _a;
-	Sample* const buffer = buf.data ();
-
-	const int max_nproc = 4;
-	uint32_t  remain    = n_samples;
-	uint32_t  offset    = buffer_offset;
-
-	while (remain > 0) {
-		uint32_t n_proc = remain > max_nproc ? max_nproc : remain;
-		for (uint32_t i = 0; i < n_proc; ++i) {
-			buffer[offset + i] *= g;
-		}
-#if 1
-		g += a * (target - g);
-#else /* accurate exponential fade */
-		if (n_proc == max_nproc) {
-			g += a * (target - g);
-		} else {
-			g = target - (target - g) * expf (_l * n_proc / max_nproc);
-		}
-#endif
-		remain -= n_proc;
-		offset += n_proc;
-	}
+	g = apply_gain_ramp (buf.data (buffer_offset), n_samples, g, target, _a);
 
 	if (fabsf (g - target) < GAIN_COEFF_DELTA) {
 		_g = target;
@@ -27,6 +27,7 @@
 #include "ardour/audioplaylist.h"
 #include "ardour/audioregion.h"
 #include "ardour/butler.h"
+#include "ardour/capture_writer.h"
 #include "ardour/debug.h"
 #include "ardour/disk_writer.h"
 #include "ardour/midi_playlist.h"
@@ -69,12 +70,16 @@ DiskWriter::DiskWriter (Session& s, Track& t, string const & str, DiskIOProcesso
 	_record_safe.store (0);
 	_samples_pending_write.store (0);
 	_num_captured_loops.store (0);
+	_writes_pending.store (0);
+	_write_error.store (0);
 }
 
 DiskWriter::~DiskWriter ()
 {
 	DEBUG_TRACE (DEBUG::Destruction, string_compose ("DiskWriter %1 @ %2 deleted\n", _name, this));
 
+	wait_for_pending_writes ();
+
 	std::shared_ptr<ChannelList const> c = channels.reader();
 
 	for (auto const& chaninfo : *c) {
@@ -82,6 +87,17 @@ DiskWriter::~DiskWriter ()
 	}
 }
 
+void
+DiskWriter::wait_for_pending_writes ()
+{
+	if (_writes_pending.load () == 0) {
+		return;
+	}
+	CaptureWriter* cw = _session.butler ()->capture_writer ();
+	assert (cw);
+	cw->wait (_writes_pending);
+}
+
 samplecnt_t
 DiskWriter::default_chunk_samples ()
 {
@@ -100,8 +116,8 @@ DiskWriter::WriterChannelInfo::resize (samplecnt_t bufsize)
 	if (!capture_transition_buf) {
 		capture_transition_buf = new RingBufferNPT<CaptureTransition> (256);
 	}
-	delete wbuf;
-	wbuf = new RingBufferNPT<Sample> (bufsize);
+	/* a pending CaptureWriter request may still hold the previous one */
+	wbuf.reset (new RingBufferNPT<Sample> (bufsize));
 	/* touch memory to lock it */
 	memset (wbuf->buffer(), 0, sizeof (Sample) * wbuf->bufsize());
 }
@@ -934,6 +950,9 @@ DiskWriter::reset_capture ()
 {
 	uint32_t n;
 	ChannelList::const_iterator chan;
+
+	wait_for_pending_writes ();
+
 	std::shared_ptr<ChannelList const> c = channels.reader();
 
 	for (n = 0, chan = c->begin(); chan != c->end(); ++chan, ++n) {
@@ -955,19 +974,46 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 	int32_t ret = 0;
 	RingBufferNPT<Sample>::rw_vector vector;
 	samplecnt_t total;
+	bool skip = false;
 
 	vector.buf[0] = 0;
 	vector.buf[1] = 0;
 
+	/* Audio is written by the butler's CaptureWriter threads, if any.
+	 * A forced flush (transport stop) writes synchronously, after
+	 * previously queued writes have completed.
+	 */
+	CaptureWriter* cw = force_flush ? 0 : _session.butler()->capture_writer ();
+	std::vector<CaptureWriter::Request> requests;
+
+	if (force_flush) {
+		wait_for_pending_writes ();
+	}
+
+	if (_write_error.exchange (0)) {
+		error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
+		return -1;
+	}
+
+	/* while the previous batch is being written, the ringbuffers'
+	 * read-pointers have not been advanced yet, try again next time.
+	 */
+	bool const busy = cw && _writes_pending.load () > 0;
+
 	std::shared_ptr<ChannelList const> c = channels.reader();
 	for (auto const& chan : *c) {
 
+		if (busy) {
+			break;
+		}
+
 		chan->wbuf->get_read_vector (&vector);
 
 		total = vector.len[0] + vector.len[1];
 
 		if (total == 0 || (total < _chunk_samples && !force_flush && _was_recording)) {
-			goto out;
+			skip = true;
+			break;
 		}
 
 		/* if there are 2+ chunks of disk i/o possible for
@@ -985,15 +1031,14 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 			ret = 1;
 		}
 
-		to_write = min (_chunk_samples, (samplecnt_t) vector.len[0]);
-
-		if ((!chan->write_source) || chan->write_source->write (vector.buf[0], to_write) != to_write) {
+		if (!chan->write_source) {
 			error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 			return -1;
 		}
 
-		chan->wbuf->increment_read_ptr (to_write);
-		chan->curr_capture_cnt += to_write;
+		to_write = min (_chunk_samples, (samplecnt_t) vector.len[0]);
+
+		samplecnt_t to_write_1 = 0;
 
 		if ((to_write == vector.len[0]) && (total > to_write) && (to_write < _chunk_samples)) {
 
@@ -1002,20 +1047,52 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 			   of vector.len[1] to be flushed to disk as well.
 			*/
 
-			to_write = min ((samplecnt_t)(_chunk_samples - to_write), (samplecnt_t) vector.len[1]);
+			to_write_1 = min ((samplecnt_t)(_chunk_samples - to_write), (samplecnt_t) vector.len[1]);
+
+                        DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), to_write_1));
+		}
+
+		if (cw) {
+			CaptureWriter::Request r (chan->write_source, chan->wbuf);
+			r.buf[0] = vector.buf[0];
+			r.len[0] = to_write;
+			r.buf[1] = vector.buf[1];
+			r.len[1] = to_write_1;
+			requests.push_back (r);
+			chan->curr_capture_cnt += to_write + to_write_1;
+			continue;
+		}
+
+		if (chan->write_source->write (vector.buf[0], to_write) != to_write) {
+			error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
+			return -1;
+		}
 
-                        DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), to_write));
+		chan->wbuf->increment_read_ptr (to_write);
+		chan->curr_capture_cnt += to_write;
 
-			if (chan->write_source->write (vector.buf[1], to_write) != to_write) {
+		if (to_write_1 > 0) {
+			if (chan->write_source->write (vector.buf[1], to_write_1) != to_write_1) {
 				error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 				return -1;
 			}
 
-			chan->wbuf->increment_read_ptr (to_write);
-			chan->curr_capture_cnt += to_write;
+			chan->wbuf->increment_read_ptr (to_write_1);
+			chan->curr_capture_cnt += to_write_1;
 		}
 	}
 
+	if (!requests.empty ()) {
+		/* all channels of this track are written concurrently,
+		 * the butler continues with the next track meanwhile.
+		 */
+		cw->queue (requests, _writes_pending, _write_error);
+	}
+
+	if (skip) {
+		goto out;
+	}
+
 	/* MIDI*/
 
 	if (_midi_write_source && _midi_buf) {
@@ -1082,6 +1159,13 @@ DiskWriter::reset_write_sources (bool mark_write_complete, bool /*force*/)
 		return;
 	}
 
+	if (mark_write_complete) {
+		/* pending requests hold a reference to the sources they write to,
+		 * only wait if the sources are to be finalized.
+		 */
+		wait_for_pending_writes ();
+	}
+
 	capturing_sources.clear ();
 
 	for (auto const chan : *c) {
@@ -1171,6 +1255,7 @@ DiskWriter::use_new_write_source (DataType dt, uint32_t n)
 		}
 
 		chan->write_source->set_allow_remove_if_empty (true);
+		chan->write_source->set_write_behind (Config->get_capture_write_behind ());
 	}
 
 	return 0;
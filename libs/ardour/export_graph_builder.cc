@@ -52,6 +52,7 @@
 #include "audiographer/sndfile/tmp_file.h"
 #include "audiographer/sndfile/tmp_file_rt.h"
 #include "audiographer/sndfile/tmp_file_sync.h"
+#include "audiographer/sndfile/tmp_mem.h"
 #include "audiographer/sndfile/sndfile_writer.h"
 
 #include "ardour/audioengine.h"
@@ -62,6 +63,7 @@
 #include "ardour/export_graph_builder.h"
 #include "ardour/export_timespan.h"
 #include "ardour/filesystem_paths.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session_directory.h"
 #include "ardour/session_metadata.h"
 #include "ardour/sndfile_helpers.h"
@@ -171,36 +173,76 @@ ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
 {
 	assert(samples <= process_buffer_samples);
 
-	sampleoffset_t off = 0;
-	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
+	if (channels.empty ()) {
+		return samples;
+	}
+
+	ChannelData data;
+	read_channels (data, samples);
+
+	sampleoffset_t off;
+	if (!aligned_offset (samples, off)) {
+		/* Skip processing during pre-roll, only read/write export ringbuffers */
+		return 0;
+	}
+
+	process (data, off, samples - off, last_cycle);
+
+	return samples - off;
+}
+
+void
+ExportGraphBuilder::read_channels (ChannelData& data, samplecnt_t samples) const
+{
+	assert(samples <= process_buffer_samples);
+
+	for (ChannelMap::const_iterator it = channels.begin(); it != channels.end(); ++it) {
+		/* each channel must only be read once per cycle */
+		if (data.find (it->first) != data.end ()) {
+			continue;
+		}
 		Buffer const* buf;
 		it->first->read (buf, samples);
+		data[it->first] = buf;
+	}
+}
 
-		if (session.remaining_latency_preroll () >= _master_align + samples) {
-			/* Skip processing during pre-roll, only read/write export ringbuffers */
-			return 0;
-		}
+bool
+ExportGraphBuilder::aligned_offset (samplecnt_t samples, sampleoffset_t& off) const
+{
+	off = 0;
 
-		off = 0;
-		if (session.remaining_latency_preroll () > _master_align) {
-			off = session.remaining_latency_preroll () - _master_align;
-			assert (off < samples);
-		}
+	if (session.remaining_latency_preroll () >= _master_align + samples) {
+		return false;
+	}
 
-		AudioBuffer const* ab = dynamic_cast<AudioBuffer const*> (buf);
+	if (session.remaining_latency_preroll () > _master_align) {
+		off = session.remaining_latency_preroll () - _master_align;
+		assert (off < samples);
+	}
+
+	return true;
+}
+
+void
+ExportGraphBuilder::process (ChannelData const& data, sampleoffset_t offset, samplecnt_t cnt, bool last_cycle)
+{
+	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
+		ChannelData::const_iterator d = data.find (it->first);
+		assert (d != data.end ());
+
+		AudioBuffer const* ab = dynamic_cast<AudioBuffer const*> (d->second);
 		MidiBuffer const*  mb;
 		if (ab) {
 			Sample const* process_buffer = ab->data ();
-			ConstProcessContext<Sample> context(&process_buffer[off], samples - off, 1);
+			ConstProcessContext<Sample> context(&process_buffer[offset], cnt, 1);
 			if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
 			it->second->process (context);
 		}
-		if  ((mb = dynamic_cast<MidiBuffer const*> (buf))) {
-			it->second->process (*mb, off, samples - off, last_cycle);
+		if  ((mb = dynamic_cast<MidiBuffer const*> (d->second))) {
+			it->second->process (*mb, offset, cnt, last_cycle);
 		}
 	}
-
-	return samples - off;
 }
 
 bool
@@ -795,21 +837,36 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 
 	int format = ExportFormatBase::F_RAW | ExportFormatBase::SF_Float;
 
+	/* When freewheeling, the analysed data is kept in RAM, so that
+	 * post-processing does not need to write and read back a complete
+	 * tmp file. All intermediates of an export share one budget, once
+	 * that is used up, the remainder spills to disk.
+	 * TmpMem is not realtime-safe, so realtime export still uses TmpFileRt.
+	 */
 	if (parent._realtime) {
 		tmp_file.reset (new TmpFileRt<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
+	} else if (parent._analysis_memory) {
+		tmp_mem.reset (new TmpMem<float> (channels, config.format->sample_rate(), parent._analysis_memory, tmpfile_path, format));
 	} else {
 		tmp_file.reset (new TmpFileSync<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
 	}
 
-	tmp_file->FileWritten.connect_same_thread (post_processing_connection,
-	                                           boost::bind (&Intermediate::prepare_post_processing, this));
-	tmp_file->FileFlushed.connect_same_thread (post_processing_connection,
-	                                           boost::bind (&Intermediate::start_post_processing, this));
+	if (tmp_mem) {
+		tmp_mem->FileWritten.connect_same_thread (post_processing_connection,
+		                                          boost::bind (&Intermediate::prepare_post_processing, this));
+		tmp_mem->FileFlushed.connect_same_thread (post_processing_connection,
+		                                          boost::bind (&Intermediate::start_post_processing, this));
+	} else {
+		tmp_file->FileWritten.connect_same_thread (post_processing_connection,
+		                                           boost::bind (&Intermediate::prepare_post_processing, this));
+		tmp_file->FileFlushed.connect_same_thread (post_processing_connection,
+		                                           boost::bind (&Intermediate::start_post_processing, this));
+	}
 
 	add_child (new_config);
 
 	peak_reader->add_output (loudness_reader);
-	loudness_reader->add_output (tmp_file);
+	loudness_reader->add_output (storage ());
 }
 
 ExportGraphBuilder::FloatSinkPtr
@@ -820,10 +877,28 @@ ExportGraphBuilder::Intermediate::sink ()
 	} else if (use_loudness) {
 		return loudness_reader;
 	} else {
-		return tmp_file;
+		return storage ();
 	}
 }
 
+ExportGraphBuilder::FloatSinkPtr
+ExportGraphBuilder::Intermediate::storage () const
+{
+	if (tmp_mem) {
+		return tmp_mem;
+	}
+	return tmp_file;
+}
+
+samplecnt_t
+ExportGraphBuilder::Intermediate::samples_stored () const
+{
+	if (tmp_mem) {
+		return tmp_mem->get_samples_written ();
+	}
+	return tmp_file->get_samples_written ();
+}
+
 void
 ExportGraphBuilder::Intermediate::add_child (FileSpec const & new_config)
 {
@@ -861,14 +936,14 @@ ExportGraphBuilder::Intermediate::operator== (FileSpec const & other_config) con
 unsigned
 ExportGraphBuilder::Intermediate::get_postprocessing_cycle_count() const
 {
-	return static_cast<unsigned>(std::ceil(static_cast<float>(tmp_file->get_samples_written()) /
+	return static_cast<unsigned>(std::ceil(static_cast<float>(samples_stored ()) /
 	                                       max_samples_out));
 }
 
 bool
 ExportGraphBuilder::Intermediate::process()
 {
-	samplecnt_t samples_read = tmp_file->read (*buffer);
+	samplecnt_t samples_read = tmp_mem ? tmp_mem->read (*buffer) : tmp_file->read (*buffer);
 	return samples_read != buffer->samples();
 }
 
@@ -884,7 +959,11 @@ ExportGraphBuilder::Intermediate::prepare_post_processing()
 		}
 	}
 
-	tmp_file->add_output (threader);
+	if (tmp_mem) {
+		tmp_mem->add_output (threader);
+	} else {
+		tmp_file->add_output (threader);
+	}
 	parent.intermediates.push_back (this);
 }
 
@@ -892,10 +971,14 @@ void
 ExportGraphBuilder::Intermediate::start_post_processing()
 {
 	for (boost::ptr_list<SFC>::iterator i = children.begin(); i != children.end(); ++i) {
-		(*i).set_duration (tmp_file->get_samples_written() / config.channel_config->get_n_chans());
+		(*i).set_duration (samples_stored () / config.channel_config->get_n_chans());
 	}
 
-	tmp_file->seek (0, SEEK_SET);
+	if (tmp_mem) {
+		tmp_mem->rewind ();
+	} else {
+		tmp_file->seek (0, SEEK_SET);
+	}
 
 	/* called in disk-thread when exporting in realtime,
 	 * to enable freewheeling for post-proc.
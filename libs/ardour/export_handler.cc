@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "pbd/gstdio_compat.h"
 #include <glibmm.h>
 #include <glibmm/convert.h>
@@ -39,6 +41,7 @@
 #include "ardour/export_status.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_filename.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/soundcloud_upload.h"
 #include "ardour/surround_return.h"
 #include "ardour/system_exec.h"
@@ -46,6 +49,8 @@
 #include "pbd/basename.h"
 #include "ardour/session_metadata.h"
 
+#include "audiographer/sndfile/tmp_mem.h"
+
 #include "pbd/i18n.h"
 
 using namespace std;
@@ -117,9 +122,11 @@ ExportHandler::ExportHandler (Session & session)
   , graph_builder (new ExportGraphBuilder (session))
   , export_status (session.get_export_status ())
   , post_processing (false)
+  , batch_end (0)
   , cue_tracknum (0)
   , cue_indexnum (0)
 {
+	graph_builders.push_back (graph_builder);
 }
 
 ExportHandler::~ExportHandler ()
@@ -127,7 +134,9 @@ ExportHandler::~ExportHandler ()
 	if (export_status->aborted () && !current_timespan->vapor ().empty () && session.surround_master ()) {
 		session.surround_master ()->surround_return ()->finalize_export ();
 	}
-	graph_builder->cleanup (export_status->aborted () );
+	for (auto const& gb : graph_builders) {
+		gb->cleanup (export_status->aborted ());
+	}
 }
 
 /** Add an export to the `to-do' list */
@@ -157,6 +166,13 @@ ExportHandler::do_export ()
 	}
 	export_status->total_timespans = timespan_set.size();
 
+	size_t const mem_limit = (size_t) Config->get_export_analysis_memory_limit () * 1048576;
+	if (mem_limit > 0) {
+		analysis_memory.reset (new AudioGrapher::TmpMemBudget (mem_limit));
+	} else {
+		analysis_memory.reset ();
+	}
+
 	if (export_status->total_timespans > 1) {
 		// always include timespan if there's more than one.
 		for (ConfigMap::iterator it = config_map.begin(); it != config_map.end(); ++it) {
@@ -196,6 +212,10 @@ ExportHandler::start_timespan ()
 	*/
 	current_timespan = config_map.begin()->first;
 
+	if (Config->get_export_timespans_in_one_pass () && collect_batch ()) {
+		return start_batch ();
+	}
+
 	export_status->total_samples_current_timespan = current_timespan->get_length();
 	export_status->timespan_name = current_timespan->name();
 	export_status->processed_samples_current_timespan = 0;
@@ -206,6 +226,7 @@ ExportHandler::start_timespan ()
 	timespan_bounds = config_map.equal_range (current_timespan);
 	graph_builder->reset ();
 	graph_builder->set_current_timespan (current_timespan);
+	graph_builder->set_analysis_memory (analysis_memory);
 	handle_duplicate_format_extensions();
 	bool realtime = current_timespan->realtime ();
 	bool region_export = true;
@@ -290,6 +311,9 @@ ExportHandler::process (samplecnt_t samples)
 		}
 	} else if (samples > 0) {
 		Glib::Threads::Mutex::Lock l (export_status->lock());
+		if (!batch.empty ()) {
+			return process_batch (samples);
+		}
 		return process_timespan (samples);
 	}
 	return 0;
@@ -347,8 +371,24 @@ ExportHandler::process_timespan (samplecnt_t samples)
 int
 ExportHandler::post_process ()
 {
-	if (graph_builder->post_process ()) {
-		finish_timespan ();
+	bool done = true;
+
+	if (batch.empty ()) {
+		done = graph_builder->post_process ();
+	} else {
+		for (auto const& b : batch) {
+			if (!b.graph_builder->post_process ()) {
+				done = false;
+			}
+		}
+	}
+
+	if (done) {
+		if (batch.empty ()) {
+			finish_timespan ();
+		} else {
+			finish_batch ();
+		}
 		export_status->active_job = ExportStatus::Exporting;
 	} else {
 		if (graph_builder->realtime ()) {
@@ -385,35 +425,53 @@ ExportHandler::start_timespan_bg (void* eh)
 
 void
 ExportHandler::finish_timespan ()
+{
+	finalize_timespan (*graph_builder);
+
+	/* finish timespan is called in freewheeling rt-context,
+	 * we cannot start a new export from here */
+	assert (AudioEngine::instance()->freewheeling ());
+	pthread_t tid;
+	pthread_create (&tid, NULL, ExportHandler::start_timespan_bg, this);
+	pthread_detach (tid);
+}
+
+/** Close, tag and post-process the files of current_timespan
+ * and remove its entries from the config_map.
+ */
+void
+ExportHandler::finalize_timespan (ExportGraphBuilder& builder)
 {
 	if (/*!region_export &&*/ !current_timespan->vapor ().empty () && session.surround_master ()) {
 		session.surround_master ()->surround_return ()->finalize_export ();
 	}
 
-	graph_builder->get_analysis_results (export_status->result_map);
+	builder.get_analysis_results (export_status->result_map);
 
 	/* work-around: split-channel will produce several files
 	 * for a single config, config_map iterator below does not yet
 	 * take that into account.
 	 */
-	for (auto const& f : graph_builder->exported_files ()) {
-		Session::Exported (current_timespan->name(), f, config_map.begin()->second.format->reimport(), current_timespan->get_start ()); /* EMIT SIGNAL */
+	for (auto const& f : builder.exported_files ()) {
+		Session::Exported (current_timespan->name(), f, timespan_bounds.first->second.format->reimport(), current_timespan->get_start ()); /* EMIT SIGNAL */
 	}
 
-	while (config_map.begin() != timespan_bounds.second) {
+	while (timespan_bounds.first != timespan_bounds.second) {
 
 		// XXX single timespan+format may produce multiple files
 		// e.g export selection == session
 		// -> TagLib::FileRef is null
 
-		FileSpec& config = config_map.begin()->second;
+		FileSpec& config = timespan_bounds.first->second;
 		ExportFormatSpecPtr fmt = config.format;
+		/* the filename is shared by all timespans of a batch */
+		config.filename->set_timespan (current_timespan);
 		config.filename->set_channel_config (config.channel_config);
 		std::string filename = config.filename->get_path (fmt);
 
 		if (fmt->type () == ExportFormatBase::T_None) {
-			graph_builder->reset ();
-			config_map.erase (config_map.begin());
+			builder.reset ();
+			config_map.erase (timespan_bounds.first++);
 			continue;
 		}
 
@@ -433,7 +491,7 @@ ExportHandler::finish_timespan ()
 		 * The process cannot access the file because it is being used.
 		 * ditto for post-export and upload.
 		 */
-		graph_builder->reset ();
+		builder.reset ();
 
 		if (fmt->tag()) {
 			/* TODO: check Umlauts and encoding in filename.
@@ -539,11 +597,277 @@ ExportHandler::finish_timespan ()
 			}
 			delete soundcloud_uploader;
 		}
-		config_map.erase (config_map.begin());
+		config_map.erase (timespan_bounds.first++);
+	}
+}
+
+/** @return true if the timespan can be exported together with others */
+bool
+ExportHandler::batchable (ExportTimespanPtr ts) const
+{
+	if (ts->get_length () <= 0 || !ts->vapor ().empty ()) {
+		return false;
+	}
+
+	for (ConfigMap::const_iterator it = config_map.lower_bound (ts); it != config_map.upper_bound (ts); ++it) {
+		if (it->second.channel_config->region_processing_type () != RegionExportChannelFactory::None) {
+			return false;
+		}
 	}
 
-	/* finish timespan is called in freewheeling rt-context,
-	 * we cannot start a new export from here */
+	return true;
+}
+
+/** Find timespans to export in the same pass as current_timespan.
+ *
+ * Those need to use the same channel configurations, since channels are
+ * shared by the graphs and aligned to the common latency, and should
+ * not be too far apart: everything from the start of the first to the end
+ * of the last timespan of the batch is processed.
+ */
+bool
+ExportHandler::collect_batch ()
+{
+	/* gaps up to this size are cheaper to process than starting another pass */
+	samplecnt_t const max_gap  = session.sample_rate () * 10;
+	size_t const      max_size = 32;
+
+	batch.clear ();
+
+	if (!batchable (current_timespan)) {
+		return false;
+	}
+
+	std::set<ExportChannelConfigPtr> channel_configs;
+	for (ConfigMap::const_iterator it = config_map.lower_bound (current_timespan); it != config_map.upper_bound (current_timespan); ++it) {
+		channel_configs.insert (it->second.channel_config);
+	}
+
+	std::vector<ExportTimespanPtr> candidates;
+	candidates.push_back (current_timespan);
+
+	for (ConfigMap::const_iterator it = config_map.begin (); it != config_map.end (); it = config_map.upper_bound (it->first)) {
+		ExportTimespanPtr ts = it->first;
+
+		if (ts == current_timespan || ts->realtime () != current_timespan->realtime () || !batchable (ts)) {
+			continue;
+		}
+
+		std::set<ExportChannelConfigPtr> cc;
+		for (ConfigMap::const_iterator i = it; i != config_map.upper_bound (ts); ++i) {
+			cc.insert (i->second.channel_config);
+		}
+		if (cc != channel_configs) {
+			continue;
+		}
+
+		candidates.push_back (ts);
+	}
+
+	std::vector<ExportTimespanPtr> const timespans = batch_timespans (candidates, current_timespan, max_gap, max_size);
+
+	if (timespans.size () < 2) {
+		return false;
+	}
+
+	for (std::vector<ExportTimespanPtr>::const_iterator i = timespans.begin (); i != timespans.end (); ++i) {
+		batch.push_back (BatchItem (*i));
+	}
+
+	return true;
+}
+
+static bool
+timespan_start_less (ExportTimespanPtr a, ExportTimespanPtr b)
+{
+	return a->get_start () < b->get_start ();
+}
+
+/** Select the timespans to export in the same pass as @a current.
+ *
+ * config_map is ordered by pointer, not by position, so the candidates are
+ * sorted by start and the batch grows outwards from @a current as long as
+ * the gap to the range covered so far is at most @a max_gap.
+ *
+ * @return the batch, @a current first, or just @a current if none fit.
+ */
+std::vector<ExportTimespanPtr>
+ExportHandler::batch_timespans (std::vector<ExportTimespanPtr> candidates, ExportTimespanPtr current, samplecnt_t max_gap, size_t max_size)
+{
+	std::vector<ExportTimespanPtr> rv;
+	rv.push_back (current);
+
+	std::stable_sort (candidates.begin (), candidates.end (), timespan_start_less);
+
+	std::vector<ExportTimespanPtr>::iterator cur = std::find (candidates.begin (), candidates.end (), current);
+	if (cur == candidates.end ()) {
+		return rv;
+	}
+
+	samplepos_t start = current->get_start ();
+	samplepos_t end   = current->get_end ();
+
+	/* [lo, hi) is the part of candidates in the batch */
+	size_t lo = cur - candidates.begin ();
+	size_t hi = lo + 1;
+
+	while (rv.size () < max_size) {
+		bool grown = false;
+
+		if (hi < candidates.size () && candidates[hi]->get_start () <= end + max_gap) {
+			rv.push_back (candidates[hi]);
+			end = std::max (end, candidates[hi]->get_end ());
+			++hi;
+			grown = true;
+		}
+
+		if (rv.size () < max_size && lo > 0 && candidates[lo - 1]->get_end () + max_gap >= start) {
+			--lo;
+			rv.push_back (candidates[lo]);
+			start = candidates[lo]->get_start ();
+			end   = std::max (end, candidates[lo]->get_end ());
+			grown = true;
+		}
+
+		if (!grown) {
+			break;
+		}
+	}
+
+	return rv;
+}
+
+int
+ExportHandler::start_batch ()
+{
+	bool const  realtime = current_timespan->realtime ();
+	samplepos_t start    = current_timespan->get_start ();
+	std::string names;
+
+	batch_end = 0;
+
+	for (size_t n = 0; n < batch.size (); ++n) {
+		BatchItem& b (batch[n]);
+
+		if (n >= graph_builders.size ()) {
+			graph_builders.push_back (std::shared_ptr<ExportGraphBuilder> (new ExportGraphBuilder (session)));
+		}
+
+		b.graph_builder = graph_builders[n];
+		b.graph_builder->reset ();
+		b.graph_builder->set_current_timespan (b.timespan);
+		b.graph_builder->set_analysis_memory (analysis_memory);
+
+		timespan_bounds = config_map.equal_range (b.timespan);
+		handle_duplicate_format_extensions ();
+
+		for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+			FileSpec & spec = it->second;
+			spec.filename->set_timespan (it->first);
+			b.graph_builder->add_config (spec, realtime);
+		}
+
+		start     = std::min (start, b.timespan->get_start ());
+		batch_end = std::max (batch_end, b.timespan->get_end ());
+
+		if (!names.empty ()) {
+			names += ", ";
+		}
+		names += b.timespan->name ();
+	}
+
+	/* start_timespan () counted the first one */
+	export_status->timespan += batch.size () - 1;
+	export_status->timespan_name = names;
+	export_status->total_samples_current_timespan = batch_end - start;
+	export_status->processed_samples_current_timespan = 0;
+
+	post_processing = false;
+	session.ProcessExport.connect_same_thread (process_connection, boost::bind (&ExportHandler::process, this, _1));
+	process_position = start;
+
+	return session.start_audio_export (process_position, realtime, false);
+}
+
+int
+ExportHandler::process_batch (samplecnt_t samples)
+{
+	export_status->active_job = ExportStatus::Exporting;
+
+	if (process_position >= batch_end) {
+		export_status->stop = true;
+
+		unsigned cycles = 0;
+
+		post_processing = false;
+		for (auto const& b : batch) {
+			if (b.graph_builder->need_postprocessing ()) {
+				post_processing = true;
+				cycles = std::max (cycles, b.graph_builder->get_postprocessing_cycle_count ());
+			}
+		}
+
+		if (post_processing) {
+			export_status->total_postprocessing_cycles = cycles;
+			export_status->current_postprocessing_cycle = 0;
+		} else {
+			finish_batch ();
+		}
+		return 1; /* trigger realtime_stop() */
+	}
+
+	/* read every channel once, the graphs each process their part */
+	ExportGraphBuilder::ChannelData data;
+	for (auto const& b : batch) {
+		b.graph_builder->read_channels (data, samples);
+	}
+
+	sampleoffset_t off;
+	if (!batch.front ().graph_builder->aligned_offset (samples, off)) {
+		/* latency pre-roll */
+		return 0;
+	}
+
+	samplecnt_t const n   = std::min<samplecnt_t> (samples - off, batch_end - process_position);
+	samplepos_t const end = process_position + n;
+
+	for (auto& b : batch) {
+		if (b.done) {
+			continue;
+		}
+
+		samplepos_t const s = std::max (process_position, b.timespan->get_start ());
+		samplepos_t const e = std::min (end, b.timespan->get_end ());
+
+		if (s >= e) {
+			continue;
+		}
+
+		b.done = (e == b.timespan->get_end ());
+		b.graph_builder->process (data, off + s - process_position, e - s, b.done);
+
+		export_status->processed_samples += e - s;
+	}
+
+	process_position += n;
+	export_status->processed_samples_current_timespan += n;
+
+	return 0;
+}
+
+void
+ExportHandler::finish_batch ()
+{
+	for (auto const& b : batch) {
+		current_timespan = b.timespan;
+		timespan_bounds  = config_map.equal_range (b.timespan);
+		export_status->timespan_name = current_timespan->name ();
+		finalize_timespan (*b.graph_builder);
+	}
+
+	batch.clear ();
+
+	/* called in freewheeling rt-context, see finish_timespan () */
 	assert (AudioEngine::instance()->freewheeling ());
 	pthread_t tid;
 	pthread_create (&tid, NULL, ExportHandler::start_timespan_bg, this);
@@ -554,7 +878,10 @@ void
 ExportHandler::reset ()
 {
 	config_map.clear ();
-	graph_builder->reset ();
+	batch.clear ();
+	for (auto const& gb : graph_builders) {
+		gb->reset ();
+	}
 }
 
 /*** CD Marker stuff ***/
@@ -120,7 +120,7 @@ bool
 GainControl::get_masters_curve_locked (samplepos_t start, samplepos_t end, float* vec, samplecnt_t veclen) const
 {
 	if (_masters.empty()) {
-		return list()->curve().rt_safe_get_vector (timepos_t (start), timepos_t (end), vec, veclen);
+		return list()->rt_safe_eval_block (timepos_t (start), timepos_t (end), vec, veclen);
 	}
 	for (samplecnt_t i = 0; i < veclen; ++i) {
 		vec[i] = 1.f;
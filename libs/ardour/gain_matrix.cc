@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "ardour/audio_buffer.h"
+#include "ardour/buffer_set.h"
+#include "ardour/gain_matrix.h"
+
+using namespace ARDOUR;
+
+GainMatrix::GainMatrix ()
+	: _n_inputs (0)
+	, _n_outputs (0)
+{
+}
+
+void
+GainMatrix::configure (uint32_t n_inputs, uint32_t n_outputs)
+{
+	_n_inputs  = n_inputs;
+	_n_outputs = n_outputs;
+	_current.assign (n_inputs * n_outputs, 0);
+	_target.assign (n_inputs * n_outputs, 0);
+}
+
+void
+GainMatrix::reset ()
+{
+	std::fill (_current.begin (), _current.end (), 0);
+}
+
+void
+GainMatrix::clear_targets ()
+{
+	std::fill (_target.begin (), _target.end (), 0);
+}
+
+void
+GainMatrix::apply (BufferSet& ibufs, BufferSet& obufs, pframes_t nframes)
+{
+	assert (ibufs.count ().n_audio () >= _n_inputs);
+	assert (obufs.count ().n_audio () >= _n_outputs);
+
+	gain_t*       cur = &_current[0];
+	gain_t const* tgt = &_target[0];
+
+	for (uint32_t o = 0; o < _n_outputs; ++o) {
+		AudioBuffer* ob = 0;
+
+		for (uint32_t i = 0; i < _n_inputs; ++i, ++cur, ++tgt) {
+			gain_t const g0 = *cur;
+			gain_t const g1 = *tgt;
+
+			if (g0 == 0 && g1 == 0) {
+				continue;
+			}
+
+			if (!ob) {
+				ob = &obufs.get_audio (o);
+			}
+
+			Sample const* src = ibufs.get_audio (i).data ();
+
+			if (fabsf (g1 - g0) > 0.00001f) {
+				/* gain changed, interpolate */
+				ob->accumulate_with_ramped_gain_from (src, nframes, g0, g1);
+			} else {
+				ob->accumulate_with_gain_from (src, nframes, g1);
+			}
+
+			*cur = g1;
+		}
+	}
+}
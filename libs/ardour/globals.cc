@@ -155,6 +155,17 @@ mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
 
+apply_gain_ramp_t       ARDOUR::apply_gain_ramp       = 0;
+interleave_t            ARDOUR::interleave            = 0;
+deinterleave_t          ARDOUR::deinterleave          = 0;
+float_to_int16_t        ARDOUR::float_to_int16        = 0;
+int16_to_float_t        ARDOUR::int16_to_float        = 0;
+float_to_int24_t        ARDOUR::float_to_int24        = 0;
+int24_to_float_t        ARDOUR::int24_to_float        = 0;
+invert_polarity_t       ARDOUR::invert_polarity       = 0;
+mix_buffers_inverted_t  ARDOUR::mix_buffers_inverted  = 0;
+mix_buffers_with_gain_ramp_t ARDOUR::mix_buffers_with_gain_ramp = 0;
+
 PBD::Signal1<void, std::string>                    ARDOUR::BootMessage;
 PBD::Signal3<void, std::string, std::string, bool> ARDOUR::PluginScanMessage;
 PBD::Signal1<void, int>                            ARDOUR::PluginScanTimeout;
@@ -205,6 +216,17 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 			copy_vector           = x86_avx512f_copy_vector;
 
+			apply_gain_ramp       = x86_avx512f_apply_gain_ramp;
+			interleave            = x86_avx_interleave;
+			deinterleave          = x86_avx_deinterleave;
+			float_to_int16        = x86_avx512f_float_to_int16;
+			int16_to_float        = x86_avx512f_int16_to_float;
+			float_to_int24        = x86_avx512f_float_to_int24;
+			int24_to_float        = x86_avx512f_int24_to_float;
+			invert_polarity       = x86_avx512f_invert_polarity;
+			mix_buffers_inverted  = x86_avx512f_mix_buffers_inverted;
+			mix_buffers_with_gain_ramp = x86_avx512f_mix_buffers_with_gain_ramp;
+
 			generic_mix_functions = false;
 
 		} else
@@ -222,6 +244,17 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			apply_gain_ramp       = x86_avx_apply_gain_ramp;
+			interleave            = x86_avx_interleave;
+			deinterleave          = x86_avx_deinterleave;
+			float_to_int16        = x86_avx_float_to_int16;
+			int16_to_float        = x86_avx_int16_to_float;
+			float_to_int24        = x86_avx_float_to_int24;
+			int24_to_float        = x86_avx_int24_to_float;
+			invert_polarity       = x86_avx_invert_polarity;
+			mix_buffers_inverted  = x86_avx_mix_buffers_inverted;
+			mix_buffers_with_gain_ramp = x86_avx_mix_buffers_with_gain_ramp;
+
 			generic_mix_functions = false;
 
 		} else
@@ -237,6 +270,17 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			apply_gain_ramp       = x86_avx_apply_gain_ramp;
+			interleave            = x86_avx_interleave;
+			deinterleave          = x86_avx_deinterleave;
+			float_to_int16        = x86_avx_float_to_int16;
+			int16_to_float        = x86_avx_int16_to_float;
+			float_to_int24        = x86_avx_float_to_int24;
+			int24_to_float        = x86_avx_int24_to_float;
+			invert_polarity       = x86_avx_invert_polarity;
+			mix_buffers_inverted  = x86_avx_mix_buffers_inverted;
+			mix_buffers_with_gain_ramp = x86_avx_mix_buffers_with_gain_ramp;
+
 			generic_mix_functions = false;
 
 		} else if (fpu->has_sse ()) {
@@ -250,6 +294,17 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
 
+			apply_gain_ramp       = default_apply_gain_ramp;
+			interleave            = default_interleave;
+			deinterleave          = default_deinterleave;
+			float_to_int16        = default_float_to_int16;
+			int16_to_float        = default_int16_to_float;
+			float_to_int24        = default_float_to_int24;
+			int24_to_float        = default_int24_to_float;
+			invert_polarity       = default_invert_polarity;
+			mix_buffers_inverted  = default_mix_buffers_inverted;
+			mix_buffers_with_gain_ramp = default_mix_buffers_with_gain_ramp;
+
 			generic_mix_functions = false;
 		}
 
@@ -265,6 +320,17 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
 
+			apply_gain_ramp       = arm_neon_apply_gain_ramp;
+			interleave            = arm_neon_interleave;
+			deinterleave          = arm_neon_deinterleave;
+			float_to_int16        = arm_neon_float_to_int16;
+			int16_to_float        = arm_neon_int16_to_float;
+			float_to_int24        = arm_neon_float_to_int24;
+			int24_to_float        = arm_neon_int24_to_float;
+			invert_polarity       = arm_neon_invert_polarity;
+			mix_buffers_inverted  = arm_neon_mix_buffers_inverted;
+			mix_buffers_with_gain_ramp = arm_neon_mix_buffers_with_gain_ramp;
+
 			generic_mix_functions = false;
 		}
 
@@ -278,6 +344,17 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
 
+			apply_gain_ramp       = default_apply_gain_ramp;
+			interleave            = default_interleave;
+			deinterleave          = default_deinterleave;
+			float_to_int16        = default_float_to_int16;
+			int16_to_float        = default_int16_to_float;
+			float_to_int24        = default_float_to_int24;
+			int24_to_float        = default_int24_to_float;
+			invert_polarity       = default_invert_polarity;
+			mix_buffers_inverted  = default_mix_buffers_inverted;
+			mix_buffers_with_gain_ramp = default_mix_buffers_with_gain_ramp;
+
 			generic_mix_functions = false;
 
 			info << "Apple VecLib H/W specific optimizations in use" << endmsg;
@@ -297,11 +374,25 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
 
+		apply_gain_ramp       = default_apply_gain_ramp;
+		interleave            = default_interleave;
+		deinterleave          = default_deinterleave;
+		float_to_int16        = default_float_to_int16;
+		int16_to_float        = default_int16_to_float;
+		float_to_int24        = default_float_to_int24;
+		int24_to_float        = default_int24_to_float;
+		invert_polarity       = default_invert_polarity;
+		mix_buffers_inverted  = default_mix_buffers_inverted;
+		mix_buffers_with_gain_ramp = default_mix_buffers_with_gain_ramp;
+
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
 
 	AudioGrapher::Routines::override_compute_peak (compute_peak);
 	AudioGrapher::Routines::override_apply_gain_to_buffer (apply_gain_to_buffer);
+	AudioGrapher::Routines::override_interleave (interleave);
+	AudioGrapher::Routines::override_deinterleave (deinterleave);
+	AudioGrapher::Routines::override_float_to_int16 (float_to_int16);
 }
 
 static void
@@ -20,9 +20,13 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <map>
 #include <stdio.h>
 
+#include <glibmm/threads.h>
+
 #include "pbd/compose.h"
 #include "pbd/debug_rt_alloc.h"
 #include "pbd/pthread_utils.h"
@@ -35,6 +39,7 @@
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/rt_task.h"
 #include "ardour/rt_tasklist.h"
@@ -47,6 +52,26 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+namespace {
+/** per process-thread state, used in work-stealing mode */
+struct GraphWorkerContext {
+	GraphWorkerContext (PBD::WSDeque<ProcessNode*>* q, uint32_t i)
+		: queue (q)
+		, id (i)
+	{}
+
+	PBD::WSDeque<ProcessNode*>* queue;
+	uint32_t                    id;
+};
+
+void
+do_not_delete_the_worker_context (void*)
+{
+}
+
+Glib::Threads::Private<GraphWorkerContext> graph_worker (do_not_delete_the_worker_context);
+}
+
 #ifdef DEBUG_RT_ALLOC
 static Graph* graph = 0;
 
@@ -65,6 +90,7 @@ Graph::Graph (Session& session)
 	, _execution_sem ("graph_execution", 0)
 	, _callback_start_sem ("graph_start", 0)
 	, _callback_done_sem ("graph_done", 0)
+	, _work_stealing (false)
 	, _graph_empty (true)
 	, _graph_chain (0)
 {
@@ -74,6 +100,14 @@ Graph::Graph (Session& session)
 	_idle_thread_cnt.store (0);
 	_trigger_queue_size.store (0);
 
+	_stat_steals.store (0);
+	_stat_idle_wakeups.store (0);
+	_stat_max_queue_depth.store (0);
+	_last_steals.store (0);
+	_last_idle_wakeups.store (0);
+	_last_max_queue_depth.store (0);
+	_last_work_stealing.store (false);
+
 	/* pre-allocate memory */
 	_trigger_queue.reserve (1024);
 
@@ -121,6 +155,14 @@ Graph::reset_thread_list ()
 		drop_threads ();
 	}
 
+	/* One work-stealing deque per process thread */
+	if (_worker_queues.size () != num_threads) {
+		_worker_queues.clear ();
+		for (uint32_t i = 0; i < num_threads; ++i) {
+			_worker_queues.push_back (std::shared_ptr<WorkerQueue> (new WorkerQueue (1024)));
+		}
+	}
+
 	/* Allow threads to run */
 	_terminate.store (0);
 
@@ -153,6 +195,9 @@ Graph::session_going_away ()
 	/* now drop all references on the nodes. */
 	_trigger_queue_size.store (0);
 	_trigger_queue.clear ();
+	for (auto const& q : _worker_queues) {
+		q->clear ();
+	}
 	_graph_chain = 0;
 }
 
@@ -218,22 +263,90 @@ Graph::prep ()
 		_trigger_queue.reserve (_graph_chain->_nodes_rt.size ());
 	}
 
+	/* All other threads are idle at this point, so it is safe to
+	 * switch scheduler mode and resize the per-thread deques.
+	 */
+	_work_stealing = Config->get_graph_work_stealing () && _worker_queues.size () > 1;
+
+	if (_work_stealing) {
+		for (auto const& q : _worker_queues) {
+			if (q->capacity () < _graph_chain->_nodes_rt.size ()) {
+				q->reserve (_graph_chain->_nodes_rt.size ());
+			}
+		}
+	}
+
+	_stat_steals.store (0);
+	_stat_idle_wakeups.store (0);
+	_stat_max_queue_depth.store (0);
+
 	_terminal_refcnt.store (_graph_chain->_n_terminal_nodes);
 
-	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
-	for (auto const& i : _graph_chain->_init_trigger_list) {
-		_trigger_queue_size.fetch_add (1);
-		_trigger_queue.push_back (i.get ());
+	/* Prioritize nodes using the cost measured in previous cycles */
+	_graph_chain->update_critical_path ();
+
+	/* Trigger the initial nodes for processing, which are the ones at the `input' end,
+	 * longest critical path first.
+	 * In work-stealing mode these are taken from the shared queue by any thread.
+	 */
+	for (auto const& i : _graph_chain->_init_trigger_order) {
+		update_queue_depth (_trigger_queue_size.fetch_add (1) + 1);
+		_trigger_queue.push_back (i);
 	}
 }
 
 void
 Graph::trigger (ProcessNode* n)
 {
-	_trigger_queue_size.fetch_add (1);
+	update_queue_depth (_trigger_queue_size.fetch_add (1) + 1);
+
+	if (_work_stealing) {
+		/* Keep the node on the thread that activated it, idle threads will steal it */
+		GraphWorkerContext* ctx = graph_worker.get ();
+		if (ctx && ctx->queue->push (n)) {
+			return;
+		}
+	}
+
 	_trigger_queue.push_back (n);
 }
 
+/** Trigger a set of nodes, ordered by priority (highest first) */
+void
+Graph::trigger (ProcessNode* const* n, size_t cnt)
+{
+	if (_work_stealing) {
+		/* The local deque is LIFO, push lowest priority first */
+		for (size_t i = cnt; i > 0; --i) {
+			trigger (n[i - 1]);
+		}
+	} else {
+		for (size_t i = 0; i < cnt; ++i) {
+			trigger (n[i]);
+		}
+	}
+}
+
+void
+Graph::update_queue_depth (uint32_t depth)
+{
+	uint32_t cur = _stat_max_queue_depth.load (std::memory_order_relaxed);
+	while (depth > cur && !_stat_max_queue_depth.compare_exchange_weak (cur, depth, std::memory_order_relaxed)) {
+		;
+	}
+}
+
+Graph::CycleStats
+Graph::cycle_stats () const
+{
+	CycleStats s;
+	s.steals          = _last_steals.load ();
+	s.idle_wakeups    = _last_idle_wakeups.load ();
+	s.max_queue_depth = _last_max_queue_depth.load ();
+	s.work_stealing   = _last_work_stealing.load ();
+	return s;
+}
+
 /** Called when a node at the `output' end of the chain (ie one that has no-one to feed)
  *  is finished.
  */
@@ -248,8 +361,14 @@ Graph::reached_terminal_node ()
 		 */
 		assert (_trigger_queue_size.load() == 0);
 
+		_last_steals.store (_stat_steals.load ());
+		_last_idle_wakeups.store (_stat_idle_wakeups.load ());
+		_last_max_queue_depth.store (_stat_max_queue_depth.load ());
+		_last_work_stealing.store (_work_stealing);
+
 		/* Notify caller */
-		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 cycle done.\n", pthread_name ()));
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 cycle done. steals: %2 wakeups: %3 max-depth: %4\n",
+		                                                    pthread_name (), _last_steals.load (), _last_idle_wakeups.load (), _last_max_queue_depth.load ()));
 
 		_callback_done_sem.signal ();
 
@@ -295,7 +414,7 @@ Graph::run_one ()
 		return;
 	}
 
-	if (_trigger_queue.pop_front (to_run)) {
+	if (find_work (to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
 		 * other threads.
@@ -325,10 +444,11 @@ Graph::run_one ()
 
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name ()));
 
+		_stat_idle_wakeups.fetch_add (1, std::memory_order_relaxed);
 		PBD::atomic_dec_and_test (_idle_thread_cnt);
 
 		/* Try to find some work to do */
-		_trigger_queue.pop_front (to_run);
+		find_work (to_run);
 	}
 
 	/* Update the thread-local tempo map ptr.
@@ -346,11 +466,54 @@ Graph::run_one ()
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name ()));
 }
 
+/** Dequeue a node that is ready to run.
+ *
+ * In work-stealing mode, nodes activated by this thread are processed first
+ * (most recently activated first, their input buffers are likely still in cache),
+ * then nodes from the shared queue, and finally nodes are stolen from other threads.
+ */
+bool
+Graph::find_work (ProcessNode*& to_run)
+{
+	if (!_work_stealing) {
+		return _trigger_queue.pop_front (to_run);
+	}
+
+	GraphWorkerContext* ctx = graph_worker.get ();
+
+	if (ctx && ctx->queue->pop (to_run)) {
+		return true;
+	}
+
+	if (_trigger_queue.pop_front (to_run)) {
+		return true;
+	}
+
+	uint32_t const n_queues = _worker_queues.size ();
+	uint32_t const self     = ctx ? ctx->id : n_queues;
+
+	for (uint32_t i = 1; i <= n_queues; ++i) {
+		uint32_t const victim = (self + i) % n_queues;
+		if (victim == self) {
+			continue;
+		}
+		WorkerQueue* q = _worker_queues[victim].get ();
+		/* steal() fails when racing another thief, retry while there is work */
+		while (q->size () > 0) {
+			if (q->steal (to_run)) {
+				_stat_steals.fetch_add (1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 void
 Graph::helper_thread ()
 {
-	_n_workers.fetch_add (1);
-	uint32_t id = _n_workers.load();
+	uint32_t id = _n_workers.fetch_add (1) + 1;
 
 	/* This is needed for ARDOUR::Session requests called from rt-processors
 	 * in particular Lua scripts may do cross-thread calls */
@@ -368,10 +531,16 @@ Graph::helper_thread ()
 
 	pt->get_buffers ();
 
+	assert (id < _worker_queues.size ());
+	GraphWorkerContext ctx (_worker_queues[id].get (), id);
+	graph_worker.set (&ctx);
+
 	while (!_terminate.load ()) {
 		run_one ();
 	}
 
+	graph_worker.set (0);
+
 	pt->drop_buffers ();
 	delete pt;
 }
@@ -398,6 +567,10 @@ Graph::main_thread ()
 
 	pt->get_buffers ();
 
+	assert (!_worker_queues.empty ());
+	GraphWorkerContext ctx (_worker_queues[0].get (), 0);
+	graph_worker.set (&ctx);
+
 	/* Wait for initial process callback */
 again:
 	_callback_start_sem.wait ();
@@ -405,6 +578,7 @@ again:
 	DEBUG_TRACE (DEBUG::ProcessThreads, "main thread is awake\n");
 
 	if (_terminate.load ()) {
+		graph_worker.set (0);
 		pt->drop_buffers ();
 		delete (pt);
 		return;
@@ -425,6 +599,8 @@ again:
 		run_one ();
 	}
 
+	graph_worker.set (0);
+
 	pt->drop_buffers ();
 	delete (pt);
 }
@@ -588,6 +764,10 @@ Graph::process_tasklist (RTTaskList const& rt)
 	_terminal_refcnt.store (tasks.size ());
 	_graph_empty = false;
 
+	_stat_steals.store (0);
+	_stat_idle_wakeups.store (0);
+	_stat_max_queue_depth.store (tasks.size ());
+
 	for (auto const& t : tasks) {
 		_trigger_queue.push_back (const_cast<RTTask*>(&t));
 	}
@@ -658,9 +838,50 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 			_n_terminal_nodes += 1;
 		}
 	}
+
+	/* Sort nodes topologically (Kahn), this allows to compute the
+	 * critical path of each node in a single pass in reverse order.
+	 */
+	std::map<GraphNode*, int> refcnt;
+	for (auto const& ni : _nodes_rt) {
+		refcnt[ni.get ()] = ni->init_refcount (this);
+	}
+	for (auto const& ni : _init_trigger_list) {
+		_nodes_topo.push_back (ni.get ());
+		_init_trigger_order.push_back (ni.get ());
+	}
+	for (size_t i = 0; i < _nodes_topo.size (); ++i) {
+		for (auto const& ai : _nodes_topo[i]->activation_set (this)) {
+			if (--refcnt[ai.get ()] == 0) {
+				_nodes_topo.push_back (ai.get ());
+			}
+		}
+	}
+	assert (_nodes_topo.size () == _nodes_rt.size ());
+
 	dump ();
 }
 
+/** Calculate the longest remaining path of every node,
+ * using the moving average of each node's DSP cost.
+ *
+ * This is called in the process thread before each cycle, when no nodes are running.
+ */
+void
+GraphChain::update_critical_path () const
+{
+	for (auto n = _nodes_topo.rbegin (); n != _nodes_topo.rend (); ++n) {
+		float cp = 0;
+		for (auto const& ai : (*n)->activation_set (this)) {
+			cp = std::max (cp, ai->critical_path ());
+		}
+		(*n)->set_critical_path (cp + (*n)->dsp_cost_avg ());
+	}
+
+	std::sort (_init_trigger_order.begin (), _init_trigger_order.end (),
+	           [] (GraphNode const* a, GraphNode const* b) { return a->critical_path () > b->critical_path (); });
+}
+
 GraphChain::~GraphChain ()
 {
 	/* clear chain */
@@ -726,7 +947,7 @@ GraphChain::dump () const
 #ifndef NDEBUG
 	DEBUG_TRACE (DEBUG::Graph, "--8<-- Graph dump ----------------------------\n");
 	for (auto const& ni : _nodes_rt) {
-		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", ni->graph_node_name (), ni->init_refcount (this)));
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2 cost: %3 critical-path: %4\n", ni->graph_node_name (), ni->init_refcount (this), ni->dsp_cost_avg (), ni->critical_path ()));
 		for (auto const& ai : ni->activation_set (this)) {
 			DEBUG_TRACE (DEBUG::Graph, string_compose ("  triggers: %1\n", ai->graph_node_name ()));
 		}
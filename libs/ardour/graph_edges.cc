@@ -174,6 +174,63 @@ GraphEdges::remove (GraphVertex from, GraphVertex to)
 	EdgeMapWithSends::iterator k = find_in_from_to_with_sends (from, to);
 	assert (k != _from_to_with_sends.end ());
 	_from_to_with_sends.erase (k);
+
+	k = find_in_to_from_with_sends (to, from);
+	assert (k != _to_from_with_sends.end ());
+	_to_from_with_sends.erase (k);
+}
+
+void
+GraphEdges::remove_edges_of (GraphVertex v)
+{
+	/* copy, remove() modifies the maps */
+	set<GraphVertex> const out (from (v));
+	for (auto const& i : out) {
+		remove (v, i);
+	}
+
+	EdgeMap::const_iterator t = _to_from.find (v);
+	if (t != _to_from.end ()) {
+		set<GraphVertex> const in (t->second);
+		for (auto const& i : in) {
+			remove (i, v);
+		}
+	}
+}
+
+void
+GraphEdges::remove_vertex (GraphVertex v)
+{
+	remove_edges_of (v);
+	_vertices.erase (v);
+}
+
+bool
+GraphEdges::reachable (GraphVertex from, GraphVertex to) const
+{
+	/* breadth first, every vertex is visited at most once */
+	set<GraphVertex> visited;
+	std::list<GraphVertex> queue;
+
+	queue.push_back (from);
+	visited.insert (from);
+
+	while (!queue.empty ()) {
+		EdgeMap::const_iterator i = _from_to.find (queue.front ());
+		queue.pop_front ();
+		if (i == _from_to.end ()) {
+			continue;
+		}
+		for (auto const& j : i->second) {
+			if (j == to) {
+				return true;
+			}
+			if (visited.insert (j).second) {
+				queue.push_back (j);
+			}
+		}
+	}
+	return false;
 }
 
 /** @param to `To' route.
@@ -274,33 +331,12 @@ struct RouteRecEnabledComparator
 	}
 };
 
-/** Perform a topological sort of a list of routes using a directed graph representing connections.
- *  @return Sorted list of routes, or 0 if the graph contains cycles (feedback loops).
+/** Order nodes using a directed graph representing connections.
+ *  @return false if the graph contains cycles (feedback loops).
  */
-bool
-ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges)
+static bool
+sort_nodes (GraphNodeList& nodes, GraphEdges const& edges)
 {
-	/* Collect the edges of the  graph.  Each of these edges
-	 * is a pair of nodes, one of which directly feeds the other
-	 * either by a port connection or by an internal send.
-	 */
-
-	for (auto const& i : nodes) {
-
-		for (auto const& j : nodes) {
-
-			bool via_sends_only = false;
-
-			/* See if this *j feeds *i according to the current state of
-			 * port connections and internal sends.
-			 */
-			if (j->direct_feeds_according_to_reality (i, &via_sends_only)) {
-				/* add the edge to the graph (part #1) */
-				edges.add (j, i, via_sends_only);
-			}
-		}
-	}
-
 	GraphNodeList queue;
 
 	/* initial queue has routes that are not fed by anything */
@@ -344,3 +380,106 @@ ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges)
 
 	return true;
 }
+
+/** Perform a topological sort of a list of routes using a directed graph representing connections.
+ *  @return Sorted list of routes, or 0 if the graph contains cycles (feedback loops).
+ */
+bool
+ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges)
+{
+	/* Collect the edges of the  graph.  Each of these edges
+	 * is a pair of nodes, one of which directly feeds the other
+	 * either by a port connection or by an internal send.
+	 */
+
+	for (auto const& i : nodes) {
+
+		edges.add_vertex (i);
+
+		for (auto const& j : nodes) {
+
+			bool via_sends_only = false;
+
+			/* See if this *j feeds *i according to the current state of
+			 * port connections and internal sends.
+			 */
+			if (j->direct_feeds_according_to_reality (i, &via_sends_only)) {
+				/* add the edge to the graph (part #1) */
+				edges.add (j, i, via_sends_only);
+			}
+		}
+	}
+
+	return sort_nodes (nodes, edges);
+}
+
+bool
+ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges, set<GraphVertex> const& dirty)
+{
+	/* Collect the vertices whose edges need to be re-evaluated:
+	 * new nodes and nodes that were flagged as modified.
+	 */
+	set<GraphVertex> const current (nodes.begin (), nodes.end ());
+	set<GraphVertex>       changed;
+
+	for (auto const& i : nodes) {
+		if (!edges.has_vertex (i) || dirty.find (i) != dirty.end ()) {
+			changed.insert (i);
+		}
+	}
+
+	if (changed.size () == nodes.size ()) {
+		/* nothing to re-use */
+		edges = GraphEdges ();
+		return topological_sort (nodes, edges);
+	}
+
+	/* drop nodes that were removed */
+	set<GraphVertex> const previous (edges.vertices ());
+	for (auto const& i : previous) {
+		if (current.find (i) == current.end ()) {
+			edges.remove_vertex (i);
+		}
+	}
+
+	/* Remove all edges of modified nodes first. What remains is a
+	 * sub-graph of the previous graph, which had no cycles.
+	 */
+	for (auto const& i : changed) {
+		edges.add_vertex (i);
+		edges.remove_edges_of (i);
+	}
+
+	/* Re-evaluate edges from and to the modified nodes. Edges between
+	 * two modified nodes are found when looking at the feeding node.
+	 * Since the remaining graph is acyclic, a new edge a -> b can only
+	 * create a cycle if there already is a path from b to a.
+	 */
+	for (auto const& i : changed) {
+		for (auto const& j : nodes) {
+			bool via_sends_only = false;
+
+			if (i->direct_feeds_according_to_reality (j, &via_sends_only)) {
+				if (j == i || edges.reachable (j, i)) {
+					return false;
+				}
+				edges.add (i, j, via_sends_only);
+			}
+
+			if (changed.find (j) != changed.end ()) {
+				continue;
+			}
+
+			via_sends_only = false;
+
+			if (j->direct_feeds_according_to_reality (i, &via_sends_only)) {
+				if (edges.reachable (i, j)) {
+					return false;
+				}
+				edges.add (j, i, via_sends_only);
+			}
+		}
+	}
+
+	return sort_nodes (nodes, edges);
+}
@@ -19,6 +19,7 @@
  */
 
 #include "pbd/atomic.h"
+#include "pbd/microseconds.h"
 
 #include "ardour/graphnode.h"
 #include "ardour/graph.h"
@@ -52,6 +53,8 @@ GraphNode::GraphNode (std::shared_ptr<Graph> graph)
 	: _graph (graph)
 {
 	_refcount.store (0);
+	_cost_avg.store (0);
+	_critical_path.store (0);
 }
 
 void
@@ -64,40 +67,62 @@ GraphNode::prep (GraphChain const* chain)
 void
 GraphNode::run (GraphChain const* chain)
 {
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
 	process ();
+	float dt  = PBD::get_microseconds () - t0;
+	float avg = _cost_avg.load (std::memory_order_relaxed);
+	_cost_avg.store (avg + .05f * (dt - avg), std::memory_order_relaxed);
+
 	finish (chain);
 }
 
-/** Called by an upstream node, when it has completed processing */
-void
-GraphNode::trigger ()
+/** Called by an upstream node, when it has completed processing.
+ * @return true if all nodes that feed this node have completed,
+ * and this node can be processed now.
+ */
+bool
+GraphNode::release ()
 {
-	/* check if we can run */
-	if (PBD::atomic_dec_and_test (_refcount)) {
-#if 0 // TODO optimize: remove prep()
-		/* reset reference count for next cycle */
-		_refcount.store (_init_refcount[chain]);
-#endif
-		/* All nodes that feed this node have completed, so this node be processed now. */
-		_graph->trigger (this);
-	}
+	return PBD::atomic_dec_and_test (_refcount);
 }
 
 void
 GraphNode::finish (GraphChain const* chain)
 {
-	node_set_t::iterator i;
-	bool                 feeds = false;
-
-	/* Notify downstream nodes that depend on this node */
-	for (auto const& i : activation_set (chain)) {
-		i->trigger ();
-		feeds = true;
-	}
+	node_set_t const& as (activation_set (chain));
 
-	if (!feeds) {
+	if (as.empty ()) {
 		/* This node is a terminal node that does not feed another note,
 		 * so notify the graph to decrement the the finished count */
 		_graph->reached_terminal_node ();
+		return;
 	}
+
+	/* Notify downstream nodes that depend on this node, and
+	 * dispatch the ones that are ready, longest critical path first.
+	 */
+	ProcessNode* ready[16];
+	float        cp[16];
+	size_t       n_ready = 0;
+
+	for (auto const& i : as) {
+		if (!i->release ()) {
+			continue;
+		}
+		if (n_ready == 16) {
+			_graph->trigger (i.get ());
+			continue;
+		}
+		float  c = i->critical_path ();
+		size_t k = n_ready++;
+		while (k > 0 && cp[k - 1] < c) {
+			ready[k] = ready[k - 1];
+			cp[k]    = cp[k - 1];
+			--k;
+		}
+		ready[k] = i.get ();
+		cp[k]    = c;
+	}
+
+	_graph->trigger (ready, n_ready);
 }
@@ -46,6 +46,8 @@
 
 #include "pbd/basename.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
+#include "pbd/pthread_utils.h"
 
 #include "evoral/SMF.h"
 
@@ -252,8 +254,13 @@ compose_status_message (const string& path,
 	return string_compose (_("Copying %1"), Glib::path_get_basename (path));
 }
 
+/** Copy (and if needed normalize) all data from \a source to \a newfiles.
+ * Peak-files are written along with the data, see prepare_for_peakfile_writes().
+ * This is called concurrently for different files, \a progress is the
+ * progress of this file only.
+ */
 static void
-write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
+write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status, volatile float& progress,
                                vector<std::shared_ptr<Source> >& newfiles)
 {
 	const samplecnt_t nframes = ResampledImportableSource::blocksize;
@@ -275,19 +282,21 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 	std::shared_ptr<AudioSource> s = std::dynamic_pointer_cast<AudioSource> (newfiles[0]);
 	assert (s);
 
-	status.progress = 0.0f;
+	progress = 0.0f;
 	float progress_multiplier = 1;
 	float progress_base = 0;
 	const float progress_length = source->ratio() * source->length();
 
-	if (!source->clamped_at_unity() && s->clamped_at_unity()) {
+	float peak = 0;
+
+	if (!source->clamped_at_unity() && s->clamped_at_unity() && !source->get_signal_max (peak)) {
 
 		/* The source we are importing from can return sample values with a magnitude greater than 1,
 		   and the file we are writing the imported data to cannot handle such values.  Compute the gain
 		   factor required to normalize the input sources to have a magnitude of less than 1.
+		   This requires reading the source twice, unless the file header provides the peak.
 		*/
 
-		float peak = 0;
 		uint32_t read_count = 0;
 
 		while (!status.cancel) {
@@ -299,12 +308,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 			peak = compute_peak (data.get(), nread, peak);
 
 			read_count += nread / channels;
-			status.progress = 0.5 * read_count / progress_length;
-		}
-
-		if (peak >= 1) {
-			/* we are out of range: compute a gain to fix it */
-			gain = (1 - FLT_EPSILON) / peak;
+			progress = 0.5 * read_count / progress_length;
 		}
 
 		source->seek (0);
@@ -312,12 +316,16 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		progress_base = 0.5;
 	}
 
+	if (peak >= 1) {
+		/* we are out of range: compute a gain to fix it */
+		gain = (1 - FLT_EPSILON) / peak;
+	}
+
 	samplecnt_t read_count = 0;
 
 	while (!status.cancel) {
 
 		samplecnt_t nread, nfread;
-		uint32_t x;
 		uint32_t chn;
 
 		if ((nread = source->read (data.get(), nframes * channels)) == 0) {
@@ -342,11 +350,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		/* de-interleave */
 
 		for (chn = 0; chn < channels; ++chn) {
-
-			samplecnt_t n;
-			for (x = chn, n = 0; n < nfread; x += channels, ++n) {
-				channel_data[chn][n] = (Sample) data[x];
-			}
+			deinterleave (channel_data[chn].get(), data.get(), nfread, chn, channels);
 		}
 
 		/* flush to disk */
@@ -358,10 +362,214 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		}
 
 		read_count += nfread;
-		status.progress = progress_base + progress_multiplier * read_count / progress_length;
+		progress = progress_base + progress_multiplier * read_count / progress_length;
+	}
+}
+
+namespace {
+
+/** Writes the data of several audio files concurrently.
+ *
+ * The new files are created serially by Session::import_files().
+ * Decoding, sample-rate conversion, writing and peak-file creation of
+ * each file only involves the file's own objects and can run in
+ * parallel.
+ *
+ * Every job opens the file to import, and closes it as well as the new
+ * files (and their peak-files) when done. That way only the files
+ * currently being imported are open.
+ */
+class ImportWriter
+{
+public:
+	ImportWriter (ImportStatus& status, samplecnt_t session_rate)
+		: _status (status)
+		, _session_rate (session_rate)
+		, _next (0)
+		, _n_active (0)
+		, _n_done (0)
+	{}
+
+	void add (std::string const& path, std::string const& msg, vector<std::shared_ptr<Source> > const& newfiles) {
+		_jobs.push_back (Job (path, msg, newfiles));
+	}
+
+	void run ();
+
+private:
+	struct Job {
+		Job (std::string const& p, std::string const& m, vector<std::shared_ptr<Source> > const& nf)
+			: path (p), doing_what (m), newfiles (nf), progress (0) {}
+
+		std::string                       path;
+		std::string                       doing_what;
+		vector<std::shared_ptr<Source> >  newfiles;
+		volatile float                    progress;
+	};
+
+	void run_serial ();
+	void thread_work ();
+	void write (Job&, volatile float& progress);
+
+	ImportStatus&        _status;
+	samplecnt_t          _session_rate;
+	time_t               _xnow;
+	struct tm            _now;
+	vector<Job>          _jobs;
+	Glib::Threads::Mutex _lock;
+	size_t               _next;
+	uint32_t             _n_active;
+	size_t               _n_done;
+};
+
+void
+ImportWriter::write (Job& j, volatile float& progress)
+{
+	std::shared_ptr<ImportableSource> source;
+
+	try {
+		source = open_importable_source (j.path, _session_rate, _status.quality);
+	} catch (...) {
+		error << string_compose(_("Import: cannot open input sound file \"%1\""), j.path) << endmsg;
+		_status.cancel = true;
+		return;
+	}
+
+	std::shared_ptr<AudioFileSource> afs;
+
+	for (auto const& s : j.newfiles) {
+		if ((afs = std::dynamic_pointer_cast<AudioFileSource> (s)) != 0) {
+			afs->prepare_for_peakfile_writes ();
+		}
+	}
+
+	write_audio_data_to_new_files (source.get(), _status, progress, j.newfiles);
+
+	/* close the file, and free resampler buffers */
+	source.reset ();
+
+	/* flush the final length to the header, and close the new files */
+	for (auto const& s : j.newfiles) {
+		if ((afs = std::dynamic_pointer_cast<AudioFileSource> (s)) != 0) {
+			if (!_status.cancel) {
+				struct tm now (_now);
+				afs->update_header (s->natural_position().samples(), now, _xnow);
+			}
+			afs->done_with_peakfile_writes (!_status.cancel);
+			afs->close ();
+		}
 	}
 }
 
+void
+ImportWriter::run ()
+{
+	/* all files get the same timestamp, as when written serially */
+	time (&_xnow);
+	_now = *localtime (&_xnow);
+
+	uint32_t n_threads = Config->get_import_jobs ();
+	if (n_threads == 0) {
+		n_threads = std::max<uint32_t> (1, std::min<uint32_t> (4, hardware_concurrency ()));
+	}
+	n_threads = std::min<size_t> (n_threads, _jobs.size ());
+
+	if (n_threads < 2) {
+		run_serial ();
+		return;
+	}
+
+	_status.doing_what = string_compose (_("Importing %1 files"), _jobs.size ());
+	_status.progress   = 0;
+
+	vector<PBD::Thread*> threads;
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
+		{
+			Glib::Threads::Mutex::Lock lm (_lock);
+			++_n_active;
+		}
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&ImportWriter::thread_work, this), string_compose ("import %1", n));
+		if (!t) {
+			Glib::Threads::Mutex::Lock lm (_lock);
+			--_n_active;
+			break;
+		}
+		threads.push_back (t);
+	}
+
+	if (threads.empty ()) {
+		run_serial ();
+		return;
+	}
+
+	uint32_t const current = _status.current;
+	bool           running = true;
+
+	while (running) {
+		Glib::usleep (100000);
+
+		size_t n_done;
+		{
+			Glib::Threads::Mutex::Lock lm (_lock);
+			running = _n_active > 0;
+			n_done  = _n_done;
+		}
+
+		float progress = 0;
+		for (auto const& j : _jobs) {
+			progress += j.progress;
+		}
+		_status.progress = progress / _jobs.size ();
+		_status.current  = current + n_done;
+	}
+
+	for (auto& t : threads) {
+		t->join ();
+		delete t;
+	}
+
+	_status.progress = 0;
+}
+
+void
+ImportWriter::run_serial ()
+{
+	for (auto& j : _jobs) {
+		if (_status.cancel) {
+			break;
+		}
+		_status.doing_what = j.doing_what;
+		write (j, _status.progress);
+		++_status.current;
+		_status.progress = 0;
+	}
+}
+
+void
+ImportWriter::thread_work ()
+{
+	SessionEvent::create_per_thread_pool (X_("import events"), 64);
+	Temporal::TempoMap::fetch ();
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	while (_next < _jobs.size () && !_status.cancel) {
+		Job& j (_jobs[_next++]);
+
+		lm.release ();
+		write (j, j.progress);
+		j.progress = 1;
+		lm.acquire ();
+
+		++_n_done;
+	}
+
+	--_n_active;
+}
+
+} // anonymous namespace
+
 static void
 write_midi_data_to_new_files (Evoral::SMF* source, ImportStatus& status,
                               vector<std::shared_ptr<Source> >& newfiles,
@@ -635,6 +843,7 @@ Session::import_files (ImportStatus& status)
 	std::shared_ptr<SMFSource> smfs;
 	uint32_t num_channels = 0;
 	vector<string> smf_names;
+	ImportWriter writer (status, sample_rate());
 
 	status.sources.clear ();
 
@@ -731,6 +940,13 @@ Session::import_files (ImportStatus& status)
 		vector<string> new_paths = get_paths_for_new_sources (status.replace_existing_source, *p, num_channels, smf_names);
 		Sources newfiles;
 		samplepos_t natural_position = source ? source->natural_position() : 0;
+		string doing_what;
+
+		if (source) {
+			/* reopened when the data is written, do not keep many files open */
+			doing_what = compose_status_message (*p, source->samplerate(), sample_rate(), status.current, status.total);
+			source.reset ();
+		}
 
 
 		if (status.replace_existing_source) {
@@ -747,16 +963,10 @@ Session::import_files (ImportStatus& status)
 			break;
 		}
 
-		for (Sources::iterator i = newfiles.begin(); i != newfiles.end(); ++i) {
-			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(*i)) != 0) {
-				afs->prepare_for_peakfile_writes ();
-			}
-		}
-
-		if (source) { // audio
-			status.doing_what = compose_status_message (*p, source->samplerate(),
-			                                            sample_rate(), status.current, status.total);
-			write_audio_data_to_new_files (source.get(), status, newfiles);
+		if (type == DataType::AUDIO) {
+			/* written below, concurrently with other files */
+			writer.add (*p, doing_what, newfiles);
+			continue;
 		} else if (smf_reader) { // midi
 			status.doing_what = string_compose(_("Loading MIDI file %1"), *p);
 			write_midi_data_to_new_files (smf_reader.get(), status, newfiles, status.split_midi_channels);
@@ -776,20 +986,17 @@ Session::import_files (ImportStatus& status)
 	}
 
 	if (!status.cancel) {
-		struct tm* now;
-		time_t xnow;
-		time (&xnow);
-		now = localtime (&xnow);
+		writer.run ();
+	}
+
+	if (!status.cancel) {
 		status.freeze = true;
 
-		/* flush the final length(s) to the header(s) */
+		/* headers and peak-files of audio files were finished by the writer */
 
 		for (Sources::iterator x = all_new_sources.begin(); x != all_new_sources.end(); ) {
 
 			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(*x)) != 0) {
-				afs->update_header((*x)->natural_position().samples(), *now, xnow);
-				afs->done_with_peakfile_writes ();
-
 				/* now that there is data there, requeue the file for analysis */
 
 				if (Config->get_auto_analyse_audio()) {
@@ -1475,6 +1475,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("monitoring_control", &Route::monitoring_control)
 		.addFunction ("surround_send", &Route::surround_send)
 		.addFunction ("surround_return", &Route::surround_return)
+		.addFunction ("dsp_cost_avg", (float (Route::*)() const)&Route::dsp_cost_avg)
+		.addFunction ("critical_path", (float (Route::*)() const)&Route::critical_path)
 		.endClass ()
 
 		.deriveWSPtrClass <Playlist, SessionObject> ("Playlist")
@@ -3016,6 +3018,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("get_stripables", (StripableList (Session::*)() const)&Session::get_stripables)
 		.addFunction ("get_routelist", &Session::get_routelist)
 		.addFunction ("plot_process_graph", &Session::plot_process_graph)
+		.addRefFunction ("process_graph_stats", &Session::process_graph_stats)
 
 		.addFunction ("bundles", &Session::bundles)
 
@@ -3251,6 +3254,10 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("run_mono_buffered", &ARDOUR::DSP::Convolution::run_mono_buffered)
 		.addFunction ("run_mono_no_latency", &ARDOUR::DSP::Convolution::run_mono_no_latency)
 		.addFunction ("restart", &ARDOUR::DSP::Convolution::restart)
+		.addFunction ("set_partitioning", &ARDOUR::DSP::Convolution::set_partitioning)
+		.addFunction ("partitioning", &ARDOUR::DSP::Convolution::partitioning)
+		.addFunction ("set_tail_threads", &ARDOUR::DSP::Convolution::set_tail_threads)
+		.addFunction ("tail_threads", &ARDOUR::DSP::Convolution::tail_threads)
 		.addFunction ("ready", &ARDOUR::DSP::Convolution::ready)
 		.addFunction ("latency", &ARDOUR::DSP::Convolution::latency)
 		.addFunction ("n_inputs", &ARDOUR::DSP::Convolution::n_inputs)
@@ -3309,6 +3316,12 @@ LuaBindings::common (lua_State* L)
 		.addConst ("Stereo", DSP::Convolver::Stereo)
 		.endNamespace ()
 
+		.beginNamespace ("ConvolutionPartitioning")
+		.addConst ("LowLatency", DSP::Convolution::LowLatency)
+		.addConst ("Balanced", DSP::Convolution::Balanced)
+		.addConst ("LowCPU", DSP::Convolution::LowCPU)
+		.endNamespace ()
+
 		.beginClass <DSP::DspShm> ("DspShm")
 		.addConstructor<void (*) (size_t)> ()
 		.addFunction ("allocate", &DSP::DspShm::allocate)
@@ -61,11 +61,25 @@ using namespace PBD;
 MidiModel::MidiModel (MidiSource& s)
 	: AutomatableSequence<TimeType> (s.session(), Temporal::TimeDomainProvider (Temporal::BeatTime))
 	, _midi_source (s)
+	, _changed_range_valid (false)
 {
 	_midi_source.InterpolationChanged.connect_same_thread (_midi_source_connections, boost::bind (&MidiModel::source_interpolation_changed, this, _1, _2));
 	_midi_source.AutomationStateChanged.connect_same_thread (_midi_source_connections, boost::bind (&MidiModel::source_automation_state_changed, this, _1, _2));
 }
 
+static void
+extend_range (Temporal::Beats& start, Temporal::Beats& end, bool& valid, Temporal::Beats const& s, Temporal::Beats const& e)
+{
+	if (!valid) {
+		start = s;
+		end   = e;
+		valid = true;
+	} else {
+		start = std::min (start, s);
+		end   = std::max (end, e);
+	}
+}
+
 MidiModel::NoteDiffCommand*
 MidiModel::new_note_diff_command (const string& name)
 {
@@ -330,7 +344,14 @@ MidiModel::NoteDiffCommand::operator() ()
 		}
 	}
 
-	_model->ContentsChanged(); /* EMIT SIGNAL */
+	TimeType start;
+	TimeType end;
+
+	if (affected_range (start, end)) {
+		_model->contents_changed (start, end);
+	} else {
+		_model->ContentsChanged(); /* EMIT SIGNAL */
+	}
 }
 
 void
@@ -440,7 +461,74 @@ MidiModel::NoteDiffCommand::undo ()
 		}
 	}
 
-	_model->ContentsChanged(); /* EMIT SIGNAL */
+	TimeType start;
+	TimeType end;
+
+	if (affected_range (start, end)) {
+		_model->contents_changed (start, end);
+	} else {
+		_model->ContentsChanged (); /* EMIT SIGNAL */
+	}
+}
+
+/** Find the range of model time covered by the note-ons and note-offs
+ * of all notes touched by this command, both before and after it is applied.
+ */
+bool
+MidiModel::NoteDiffCommand::affected_range (TimeType& start, TimeType& end) const
+{
+	struct Extent {
+		Extent (TimeType const& t, TimeType const& l) : first (t), last (t), length (l) {}
+		TimeType first;
+		TimeType last;
+		TimeType length;
+	};
+
+	typedef std::map<NotePtr, Extent> Extents;
+
+	Extents extents;
+	bool    valid = false;
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (!i->note) {
+			return false;
+		}
+
+		Extents::iterator e = extents.find (i->note);
+		if (e == extents.end ()) {
+			e = extents.insert (std::make_pair (i->note, Extent (i->note->time (), i->note->length ()))).first;
+		}
+
+		switch (i->property) {
+		case StartTime:
+			e->second.first  = std::min (e->second.first, std::min (i->old_value.get_beats (), i->new_value.get_beats ()));
+			e->second.last   = std::max (e->second.last, std::max (i->old_value.get_beats (), i->new_value.get_beats ()));
+			break;
+		case Length:
+			e->second.length = std::max (e->second.length, std::max (i->old_value.get_beats (), i->new_value.get_beats ()));
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (Extents::const_iterator e = extents.begin (); e != extents.end (); ++e) {
+		extend_range (start, end, valid, e->second.first, e->second.last + e->second.length);
+	}
+
+	for (NoteList::const_iterator i = _added_notes.begin(); i != _added_notes.end(); ++i) {
+		extend_range (start, end, valid, (*i)->time (), (*i)->end_time ());
+	}
+
+	for (NoteList::const_iterator i = _removed_notes.begin(); i != _removed_notes.end(); ++i) {
+		extend_range (start, end, valid, (*i)->time (), (*i)->end_time ());
+	}
+
+	for (set<NotePtr>::const_iterator i = side_effect_removals.begin(); i != side_effect_removals.end(); ++i) {
+		extend_range (start, end, valid, (*i)->time (), (*i)->end_time ());
+	}
+
+	return valid;
 }
 
 XMLNode&
@@ -726,7 +814,14 @@ MidiModel::SysExDiffCommand::operator() ()
 		}
 	}
 
-	_model->ContentsChanged (); /* EMIT SIGNAL */
+	TimeType start;
+	TimeType end;
+
+	if (affected_range (start, end)) {
+		_model->contents_changed (start, end);
+	} else {
+		_model->ContentsChanged (); /* EMIT SIGNAL */
+	}
 }
 
 void
@@ -758,7 +853,30 @@ MidiModel::SysExDiffCommand::undo ()
 
 	}
 
-	_model->ContentsChanged(); /* EMIT SIGNAL */
+	TimeType start;
+	TimeType end;
+
+	if (affected_range (start, end)) {
+		_model->contents_changed (start, end);
+	} else {
+		_model->ContentsChanged (); /* EMIT SIGNAL */
+	}
+}
+
+bool
+MidiModel::SysExDiffCommand::affected_range (TimeType& start, TimeType& end) const
+{
+	bool valid = false;
+
+	for (list<SysExPtr>::const_iterator i = _removed.begin(); i != _removed.end(); ++i) {
+		extend_range (start, end, valid, (*i)->time (), (*i)->time ());
+	}
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		extend_range (start, end, valid, std::min (i->old_time, i->new_time), std::max (i->old_time, i->new_time));
+	}
+
+	return valid;
 }
 
 void
@@ -985,7 +1103,14 @@ MidiModel::PatchChangeDiffCommand::operator() ()
 		}
 	}
 
-	_model->ContentsChanged (); /* EMIT SIGNAL */
+	TimeType start;
+	TimeType end;
+
+	if (affected_range (start, end)) {
+		_model->contents_changed (start, end);
+	} else {
+		_model->ContentsChanged (); /* EMIT SIGNAL */
+	}
 }
 
 void
@@ -1043,7 +1168,41 @@ MidiModel::PatchChangeDiffCommand::undo ()
 
 	}
 
-	_model->ContentsChanged (); /* EMIT SIGNAL */
+	TimeType start;
+	TimeType end;
+
+	if (affected_range (start, end)) {
+		_model->contents_changed (start, end);
+	} else {
+		_model->ContentsChanged (); /* EMIT SIGNAL */
+	}
+}
+
+bool
+MidiModel::PatchChangeDiffCommand::affected_range (TimeType& start, TimeType& end) const
+{
+	bool valid = false;
+
+	for (list<PatchChangePtr>::const_iterator i = _added.begin(); i != _added.end(); ++i) {
+		extend_range (start, end, valid, (*i)->time (), (*i)->time ());
+	}
+
+	for (list<PatchChangePtr>::const_iterator i = _removed.begin(); i != _removed.end(); ++i) {
+		extend_range (start, end, valid, (*i)->time (), (*i)->time ());
+	}
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (!i->patch) {
+			return false;
+		}
+		if (i->property == Time) {
+			extend_range (start, end, valid, std::min (i->old_time, i->new_time), std::max (i->old_time, i->new_time));
+		} else {
+			extend_range (start, end, valid, i->patch->time (), i->patch->time ());
+		}
+	}
+
+	return valid;
 }
 
 XMLNode &
@@ -1765,6 +1924,29 @@ MidiModel::transpose (NoteDiffCommand* c, const NotePtr note_ptr, int semitones)
 	c->change (note_ptr, NoteDiffCommand::NoteNumber, (uint8_t) new_note);
 }
 
+void
+MidiModel::contents_changed (TimeType const& start, TimeType const& end)
+{
+	_changed_start       = start;
+	_changed_end         = end;
+	_changed_range_valid = true;
+
+	ContentsChanged (); /* EMIT SIGNAL */
+
+	_changed_range_valid = false;
+}
+
+bool
+MidiModel::changed_range (TimeType& start, TimeType& end) const
+{
+	if (!_changed_range_valid) {
+		return false;
+	}
+	start = _changed_start;
+	end   = _changed_end;
+	return true;
+}
+
 void
 MidiModel::control_list_marked_dirty ()
 {
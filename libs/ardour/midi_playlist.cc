@@ -29,6 +29,7 @@
 #include "evoral/Control.h"
 
 #include "ardour/debug.h"
+#include "ardour/midi_channel_filter.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_region.h"
@@ -50,7 +51,13 @@ using namespace std;
 MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
+	, _rendered_channel_mode (AllChannels)
+	, _rendered_channel_mask (0xffff)
+	, _rendered_layered (false)
+	, _render_all (true)
 {
+	Temporal::TempoMap::MapChanged.connect_same_thread (_tempo_map_connection, boost::bind (&MidiPlaylist::tempo_map_changed, this));
+
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
 	assert(prop && DataType(prop->value()) == DataType::MIDI);
@@ -68,13 +75,23 @@ MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
+	, _rendered_channel_mode (AllChannels)
+	, _rendered_channel_mask (0xffff)
+	, _rendered_layered (false)
+	, _render_all (true)
 {
+	Temporal::TempoMap::MapChanged.connect_same_thread (_tempo_map_connection, boost::bind (&MidiPlaylist::tempo_map_changed, this));
 }
 
 MidiPlaylist::MidiPlaylist (std::shared_ptr<const MidiPlaylist> other, string name, bool hidden)
 	: Playlist (other, name, hidden)
 	, _note_mode(other->_note_mode)
+	, _rendered_channel_mode (AllChannels)
+	, _rendered_channel_mask (0xffff)
+	, _rendered_layered (false)
+	, _render_all (true)
 {
+	Temporal::TempoMap::MapChanged.connect_same_thread (_tempo_map_connection, boost::bind (&MidiPlaylist::tempo_map_changed, this));
 }
 
 MidiPlaylist::MidiPlaylist (std::shared_ptr<const MidiPlaylist> other,
@@ -84,7 +101,12 @@ MidiPlaylist::MidiPlaylist (std::shared_ptr<const MidiPlaylist> other,
                             bool                                  hidden)
 	: Playlist (other, start, dur, name, hidden)
 	, _note_mode(other->_note_mode)
+	, _rendered_channel_mode (AllChannels)
+	, _rendered_channel_mask (0xffff)
+	, _rendered_layered (false)
+	, _render_all (true)
 {
+	Temporal::TempoMap::MapChanged.connect_same_thread (_tempo_map_connection, boost::bind (&MidiPlaylist::tempo_map_changed, this));
 }
 
 MidiPlaylist::~MidiPlaylist ()
@@ -168,6 +190,7 @@ MidiPlaylist::destroy_region (std::shared_ptr<Region> region)
 
 			if ((*i) == region) {
 				regions.erase (i);
+				remove_region_from_index (region);
 				changed = true;
 			}
 
@@ -276,7 +299,7 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- MidiPlaylist::render (regions: %1)-----\n", regions.size()));
 
-	std::list<std::shared_ptr<MidiRegion>> regs;
+	MidiRegionList regs;
 
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 
@@ -298,9 +321,50 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 		regs.push_back (mr);
 	}
 
+	RegionSortByLayer cmp;
+	regs.sort (cmp);
+
+	bool all_transparent = true;
+	bool no_layers = true;
+
+	if (!regs.empty ()) {
+		layer_t layer = regs.front()->layer ();
+
+		/* skip bottom-most region, transparency is irrelevant */
+		for (auto i = ++regs.begin(); i != regs.end(); ++i) {
+			if ((*i)->opaque ()) {
+				all_transparent = false;
+			}
+			if ((*i)->layer () != layer) {
+				no_layers = false;
+			}
+			if (!all_transparent && !no_layers) {
+				/* no need to check further */
+				break;
+			}
+		}
+	}
+
 	/* RAII */
 	RTMidiBuffer::WriteProtectRender wpr (_rendered);
 
+	/* Unless regions are layered, the result is simply all events of all
+	 * regions, and only the time ranges that changed since the last render
+	 * need to be replaced.
+	 */
+	DirtyRanges dirty;
+
+	if (!find_dirty_ranges (regs, filter, !(all_transparent || no_layers), dirty)) {
+		if (dirty.empty ()) {
+			DEBUG_TRACE (DEBUG::MidiPlaylistIO, "---- End MidiPlaylist::render, nothing changed\n");
+			return;
+		}
+		if (render_ranges (regs, filter, dirty, wpr)) {
+			DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, %1 range(s), events: %2\n", dirty.size (), _rendered.size()));
+			return;
+		}
+	}
+
 	if (regs.empty()) {
 		wpr.acquire ();
 		_rendered.clear ();
@@ -318,28 +382,6 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 		return;
 	}
 
-	RegionSortByLayer cmp;
-	regs.sort (cmp);
-
-	bool all_transparent = true;
-	bool no_layers = true;
-
-	layer_t layer = regs.front()->layer ();
-
-	/* skip bottom-most region, transparency is irrelevant */
-	for (auto i = ++regs.begin(); i != regs.end(); ++i) {
-		if ((*i)->opaque ()) {
-			all_transparent = false;
-		}
-		if ((*i)->layer () != layer) {
-			no_layers = false;
-		}
-		if (!all_transparent && !no_layers) {
-			/* no need to check further */
-			break;
-		}
-	}
-
 	Evoral::EventList<samplepos_t> evlist;
 
 	if (all_transparent || no_layers) {
@@ -429,6 +471,179 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
 }
 
+MidiPlaylist::RenderedRegion::RenderedRegion (MidiRegion const& mr)
+	: position (mr.position_sample ())
+	, end (mr.end ().samples ())
+	, start (mr.start_sample ())
+{
+}
+
+/** Compare the regions to be rendered with those of the last render,
+ * and collect the time ranges that need to be rendered again.
+ * @return true if everything needs to be rendered.
+ */
+bool
+MidiPlaylist::find_dirty_ranges (MidiRegionList const& regs, MidiChannelFilter* filter, bool layered, DirtyRanges& dirty)
+{
+	ChannelMode mode = AllChannels;
+	uint16_t    mask = 0xffff;
+
+	if (filter) {
+		filter->get_mode_and_mask (&mode, &mask);
+	}
+
+	RenderedRegions current;
+
+	for (auto const& mr : regs) {
+		current.insert (std::make_pair (mr->id (), RenderedRegion (*mr)));
+	}
+
+	bool render_all;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_dirty_lock);
+		render_all  = _render_all;
+		_render_all = false;
+		dirty.swap (_dirty);
+	}
+
+	if (layered || _rendered_layered || _rendered.reversed () || mode != _rendered_channel_mode || mask != _rendered_channel_mask) {
+		/* opaque regions hide parts of the ones below them, a change
+		 * anywhere can change the result elsewhere.
+		 */
+		render_all = true;
+	}
+
+	if (!render_all) {
+		/* regions that were added, removed, moved or trimmed */
+		RenderedRegions::const_iterator i = _rendered_regions.begin ();
+		RenderedRegions::const_iterator j = current.begin ();
+
+		while (i != _rendered_regions.end () || j != current.end ()) {
+			if (j == current.end () || (i != _rendered_regions.end () && i->first < j->first)) {
+				dirty.push_back (std::make_pair (i->second.position, i->second.end + 1));
+				++i;
+			} else if (i == _rendered_regions.end () || j->first < i->first) {
+				dirty.push_back (std::make_pair (j->second.position, j->second.end + 1));
+				++j;
+			} else {
+				if (i->second != j->second) {
+					dirty.push_back (std::make_pair (i->second.position, i->second.end + 1));
+					dirty.push_back (std::make_pair (j->second.position, j->second.end + 1));
+				}
+				++i;
+				++j;
+			}
+		}
+	}
+
+	_rendered_regions.swap (current);
+	_rendered_layered      = layered;
+	_rendered_channel_mode = mode;
+	_rendered_channel_mask = mask;
+
+	return render_all;
+}
+
+/** Replace the events in the given time ranges of _rendered with those
+ * of the regions overlapping them.
+ * @return false if that was not possible, and everything needs to be rendered.
+ */
+bool
+MidiPlaylist::render_ranges (MidiRegionList const& regs, MidiChannelFilter* filter, DirtyRanges& dirty, RTMidiBuffer::WriteProtectRender& wpr)
+{
+	/* merge overlapping ranges */
+	std::sort (dirty.begin (), dirty.end ());
+
+	DirtyRanges ranges;
+
+	for (auto const& d : dirty) {
+		if (d.first >= d.second) {
+			continue;
+		}
+		if (!ranges.empty () && d.first <= ranges.back ().second) {
+			ranges.back ().second = std::max (ranges.back ().second, d.second);
+		} else {
+			ranges.push_back (d);
+		}
+	}
+
+	dirty.swap (ranges);
+
+	/* render without holding the lock, the process thread continues to
+	 * read the previous state meanwhile.
+	 */
+	std::vector<Evoral::EventList<samplepos_t> > evlists (dirty.size ());
+	EventsSortByTimeAndType<samplepos_t>         cmp;
+	bool                                         ok = true;
+
+	for (size_t n = 0; n < dirty.size () && ok; ++n) {
+		/* same order as in the full render, top-most region first */
+		for (auto i = regs.rbegin (); i != regs.rend (); ++i) {
+			DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render %1 .. %2 from %3\n", dirty[n].first, dirty[n].second, (*i)->name ()));
+			if ((*i)->render_section (evlists[n], 0, _note_mode, dirty[n].first, dirty[n].second, filter)) {
+				ok = false;
+				break;
+			}
+		}
+		if (regs.size () > 1) {
+			evlists[n].sort (cmp);
+		}
+	}
+
+	if (ok) {
+		wpr.acquire ();
+		for (size_t n = 0; n < dirty.size (); ++n) {
+			_rendered.splice (dirty[n].first, dirty[n].second, evlists[n]);
+		}
+	}
+
+	for (auto& evlist : evlists) {
+		for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin(); e != evlist.end(); ++e) {
+			delete *e;
+		}
+	}
+
+	return ok;
+}
+
+bool
+MidiPlaylist::region_changed (const PBD::PropertyChange& what_changed, std::shared_ptr<Region> region)
+{
+	if (what_changed.contains (Properties::contents)) {
+		std::shared_ptr<MidiRegion> mr = std::dynamic_pointer_cast<MidiRegion> (region);
+
+		samplepos_t start;
+		samplepos_t end;
+
+		if (!mr || !mr->take_changed_range (start, end)) {
+			start = region->position_sample ();
+			end   = region->end ().samples () + 1;
+		}
+
+		Glib::Threads::Mutex::Lock lm (_dirty_lock);
+
+		if (_dirty.size () > 1024) {
+			/* not rendered in a long time, don't bother to keep track */
+			_dirty.clear ();
+			_render_all = true;
+		} else if (!_render_all) {
+			_dirty.push_back (std::make_pair (start, end));
+		}
+	}
+
+	return Playlist::region_changed (what_changed, region);
+}
+
+void
+MidiPlaylist::tempo_map_changed ()
+{
+	/* the position of every event may have changed */
+	Glib::Threads::Mutex::Lock lm (_dirty_lock);
+	_dirty.clear ();
+	_render_all = true;
+}
+
 RTMidiBuffer*
 MidiPlaylist::rendered ()
 {
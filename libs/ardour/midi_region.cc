@@ -39,6 +39,8 @@
 #include "pbd/basename.h"
 #include "pbd/types_convert.h"
 
+#include "evoral/EventList.h"
+
 #include "ardour/automation_control.h"
 #include "ardour/midi_cursor.h"
 #include "ardour/midi_model.h"
@@ -69,6 +71,8 @@ namespace PBD {
 MidiRegion::MidiRegion (const SourceList& srcs)
 	: Region (srcs)
 	, _ignore_shift (false)
+	, _changed_pending (false)
+	, _changed_known (false)
 {
 	/* by default MIDI regions are transparent,
 	 * this should probably be set depending on use-case,
@@ -85,6 +89,8 @@ MidiRegion::MidiRegion (const SourceList& srcs)
 MidiRegion::MidiRegion (std::shared_ptr<const MidiRegion> other)
 	: Region (other)
 	, _ignore_shift (false)
+	, _changed_pending (false)
+	, _changed_known (false)
 {
 	assert(_name.val().find("/") == string::npos);
 	midi_source(0)->ModelChanged.connect_same_thread (_source_connection, boost::bind (&MidiRegion::model_changed, this));
@@ -95,6 +101,8 @@ MidiRegion::MidiRegion (std::shared_ptr<const MidiRegion> other)
 MidiRegion::MidiRegion (std::shared_ptr<const MidiRegion> other, timecnt_t const & offset)
 	: Region (other, offset)
 	, _ignore_shift (false)
+	, _changed_pending (false)
+	, _changed_known (false)
 {
 
 	assert(_name.val().find("/") == string::npos);
@@ -309,7 +317,8 @@ MidiRegion::render_range (Evoral::EventSink<samplepos_t>& dst,
                           NoteMode                        mode,
                           timepos_t const &               read_start,
                           timecnt_t const &               read_length,
-                          MidiChannelFilter*              filter) const
+                          MidiChannelFilter*              filter,
+                          bool                            resolve_notes) const
 {
 	/* precondition: caller has verified that we cover the desired section */
 
@@ -355,8 +364,91 @@ MidiRegion::render_range (Evoral::EventSink<samplepos_t>& dst,
 	 * Note-Off's get inserted at the end of the region
 	 */
 
-	const timepos_t end = source_position() + read_start + read_length;
-	tracker.resolve_notes (dst, end.samples());
+	if (resolve_notes) {
+		const timepos_t end = source_position() + read_start + read_length;
+		tracker.resolve_notes (dst, end.samples());
+	}
+
+	return 0;
+}
+
+int
+MidiRegion::render_section (Evoral::EventSink<samplepos_t>& dst,
+                            uint32_t                        chan_n,
+                            NoteMode                        mode,
+                            samplepos_t                     from,
+                            samplepos_t                     to,
+                            MidiChannelFilter*              filter) const
+{
+	if (muted()) {
+		return 0;
+	}
+
+	const samplepos_t region_start = position_sample ();
+	const samplepos_t region_end   = end ().samples ();
+
+	if (to <= region_start || from > region_end) {
+		return 0;
+	}
+
+	if (from <= region_start && to > region_end) {
+		return render (dst, chan_n, mode, filter);
+	}
+
+	std::shared_ptr<const MidiModel> m = model ();
+
+	if (!m) {
+		return -1;
+	}
+
+	const Temporal::Beats src_pos      = source_position ().beats ();
+	const Temporal::Beats first        = start ().beats ();
+	const Temporal::Beats last         = first + _length.val ().beats ();
+	const Temporal::Beats from_beats   = std::max (first, timepos_t (std::max (region_start, from - 1)).beats () - src_pos);
+	Temporal::Beats       read_beats   = from_beats;
+
+	/* Note-offs in the section belong to notes that start in it, or to
+	 * notes that are still sounding at its start. Begin reading at the
+	 * earliest of the latter, so that they are read (and tracked) the same
+	 * way as when rendering the whole region.
+	 */
+	{
+		MidiModel::ReadLock lm (m->read_lock ());
+		for (MidiModel::Notes::const_iterator n = m->notes ().begin (); n != m->notes ().end () && (*n)->time () < from_beats; ++n) {
+			if ((*n)->end_time () >= from_beats) {
+				read_beats = std::min (read_beats, (*n)->time ());
+				break;
+			}
+		}
+	}
+
+	read_beats = std::max (first, read_beats);
+
+	/* read a little past the end of the section, events are clipped below */
+	Temporal::Beats end_beats = last;
+	bool            resolve   = true;
+
+	if (to <= region_end) {
+		end_beats = std::min (last, timepos_t (to).beats () - src_pos + Temporal::Beats::ticks (1));
+		resolve   = (end_beats == last);
+	}
+
+	if (end_beats <= read_beats) {
+		return 0;
+	}
+
+	Evoral::EventList<samplepos_t> evlist;
+
+	timepos_t const read_start (read_beats);
+	render_range (evlist, chan_n, mode, read_start, read_start.distance (timepos_t (end_beats)), filter, resolve);
+
+	for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin (); e != evlist.end (); ++e) {
+		Evoral::Event<samplepos_t>* ev (*e);
+		if (ev->time () >= from && ev->time () < to) {
+			dst.write (ev->time (), ev->event_type (), ev->size (), ev->buffer ());
+		}
+		delete ev;
+	}
 
 	return 0;
 }
@@ -472,9 +564,53 @@ MidiRegion::model_changed ()
 void
 MidiRegion::model_contents_changed ()
 {
+	Temporal::Beats start;
+	Temporal::Beats end;
+
+	if (!model()->changed_range (start, end)) {
+		_changed_known = false;
+	} else if (!_changed_pending) {
+		_changed_start = start;
+		_changed_end   = end;
+		_changed_known = true;
+	} else if (_changed_known) {
+		_changed_start = std::min (_changed_start, start);
+		_changed_end   = std::max (_changed_end, end);
+	}
+
+	_changed_pending = true;
+
 	send_change (Properties::contents);
 }
 
+bool
+MidiRegion::take_changed_range (samplepos_t& start, samplepos_t& end)
+{
+	const bool known = _changed_pending && _changed_known;
+
+	_changed_pending = false;
+
+	if (!known) {
+		return false;
+	}
+
+	/* map model (source) time to the timeline, the same way
+	 * MidiSource::midi_read() does for the events it reads.
+	 */
+	const Temporal::Beats src_pos = source_position ().beats ();
+
+	const samplepos_t region_end = Region::end ().samples ();
+
+	start = timepos_t (src_pos + _changed_start).samples ();
+	end   = timepos_t (src_pos + _changed_end).samples () + 1;
+
+	/* include resolved note-offs at the end of the region */
+	start = std::max (start, position_sample ());
+	end   = std::min (end, region_end + 1);
+
+	return true;
+}
+
 void
 MidiRegion::model_shifted (timecnt_t distance)
 {
@@ -491,6 +627,8 @@ MidiRegion::model_shifted (timecnt_t distance)
 		_start = _start.val() + distance;
 		what_changed.add (Properties::start);
 		what_changed.add (Properties::contents);
+		_changed_pending = true;
+		_changed_known   = false;
 		send_change (what_changed);
 	} else {
 		_ignore_shift = false;
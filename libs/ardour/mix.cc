@@ -145,6 +145,96 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+float
+default_apply_gain_ramp (ARDOUR::Sample * buf, pframes_t nframes, float gain, float target, float coeff)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] *= gain;
+		gain += coeff * (target - gain);
+	}
+	return gain;
+}
+
+void
+default_interleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t chn, uint32_t n_chn)
+{
+	dst += chn;
+	for (pframes_t i = 0; i < nframes; ++i, dst += n_chn) {
+		*dst = src[i];
+	}
+}
+
+void
+default_deinterleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t chn, uint32_t n_chn)
+{
+	src += chn;
+	for (pframes_t i = 0; i < nframes; ++i, src += n_chn) {
+		dst[i] = *src;
+	}
+}
+
+void
+default_float_to_int16 (int16_t * dst, const ARDOUR::Sample * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		const float s = min (32767.f, max (-32768.f, src[i] * 32768.f));
+		dst[i] = (int16_t) lrintf (s);
+	}
+}
+
+void
+default_int16_to_float (ARDOUR::Sample * dst, const int16_t * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] = src[i] * (1.f / 32768.f);
+	}
+}
+
+void
+default_float_to_int24 (int32_t * dst, const ARDOUR::Sample * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		const float s = min (8388607.f, max (-8388608.f, src[i] * 8388608.f));
+		dst[i] = (int32_t) lrintf (s);
+	}
+}
+
+void
+default_int24_to_float (ARDOUR::Sample * dst, const int32_t * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] = src[i] * (1.f / 8388608.f);
+	}
+}
+
+void
+default_invert_polarity (ARDOUR::Sample * buf, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] = -buf[i];
+	}
+}
+
+void
+default_mix_buffers_inverted (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] -= src[i];
+	}
+}
+
+void
+default_mix_buffers_with_gain_ramp (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, float gain, float target)
+{
+	if (nframes == 0) {
+		return;
+	}
+	const float delta = (target - gain) / nframes;
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] += src[i] * (gain + i * delta);
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
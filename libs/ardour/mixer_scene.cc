@@ -54,15 +54,32 @@ MixerScene::set_name (std::string const& name)
 void
 MixerScene::clear ()
 {
-	_ctrl_map.clear ();
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_ctrl_map.clear ();
+	}
 	_name.clear ();
 	Change (); /* EMIT SIGNAL */
 }
 
+bool
+MixerScene::empty () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _ctrl_map.empty ();
+}
+
+MixerScene::ControllableValueMap
+MixerScene::values () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _ctrl_map;
+}
+
 void
 MixerScene::snapshot ()
 {
-	_ctrl_map.clear ();
+	ControllableValueMap cvm;
 	for (auto const& c : Controllable::registered_controllables ()) {
 		if (!std::dynamic_pointer_cast<AutomationControl> (c)) {
 			continue;
@@ -70,95 +87,130 @@ MixerScene::snapshot ()
 		if (c->flags () & Controllable::HiddenControl) {
 			continue;
 		}
-		_ctrl_map[c->id ()] = c->get_save_value ();
+		cvm[c->id ()] = c->get_save_value ();
+	}
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_ctrl_map.swap (cvm);
 	}
 	_session.set_dirty ();
 	Change (); /* EMIT SIGNAL */
 }
 
 bool
-MixerScene::recurse_to_master (std::shared_ptr<PBD::Controllable> c, std::set <PBD::ID>& done, AutomationTypeSet const& ts) const
+MixerScene::has_values (ControllableValueMap const& cvm, PBD::ControllableSet const& acs)
+{
+	for (auto const& c : acs) {
+		if (cvm.find (c->id ()) != cvm.end ()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+MixerScene::recurse_to_master (ControllableValueMap const& cvm, std::shared_ptr<PBD::Controllable> c, std::set <PBD::ID>& done, AutomationTypeSet const& ts, StagedValues& sv)
 {
 	if (done.find (c->id()) != done.end ()) {
 		return false;
 	}
 
+	/* only automation controls are part of a snapshot */
 	auto ac = std::dynamic_pointer_cast<AutomationControl> (c);
+	if (!ac) {
+		done.insert (c->id ());
+		return false;
+	}
 #if 1 /* ignore controls in Write, or Touch + touching() state */
-	if (ac && ac->automation_write ()) {
+	if (ac->automation_write ()) {
 		done.insert (c->id ());
 		return false;
 	}
 #endif
-	if (!ts.empty ()) {
-		if (!ac) {
-			done.insert (c->id ());
-			return false;
-		}
-		if (ts.find (ac->desc().type) == ts.end ()) {
-			done.insert (c->id ());
-			return false;
-		}
+	if (!ts.empty () && ts.find (ac->desc().type) == ts.end ()) {
+		done.insert (c->id ());
+		return false;
 	}
 
 	auto sc = std::dynamic_pointer_cast<SlavableAutomationControl> (c);
 	if (sc && sc->slaved ()) {
 		/* first set masters, then set own value */
 		for (auto const& m : sc->masters ()) {
-			recurse_to_master (m, done, ts);
+			recurse_to_master (cvm, m, done, ts, sv);
 		}
 	}
 
-	ControllableValueMap::const_iterator it = _ctrl_map.find (c->id ());
-	if (it == _ctrl_map.end ()) {
+	ControllableValueMap::const_iterator it = cvm.find (c->id ());
+	if (it == cvm.end ()) {
 		done.insert (c->id ());
 		return false;
 	}
 
-	double old_value = ac ? ac->get_double () : c->get_value ();
-
-	if (sc && sc->slaved ()) {
-		double x = sc->reduce_by_masters (1.0);
-		if (x == 0) {
-			x = 0;
-		} else {
-			x = it->second / x;
-		}
-		if (x != old_value) {
-			c->set_value (x, Controllable::NoGroup);
-		}
-	} else if (it->second != old_value) {
-		c->set_value (it->second, Controllable::NoGroup);
-	}
+	sv.push_back (StagedValue (ac, it->second, sc && sc->slaved ()));
 
 	done.insert (it->first);
 	return true;
 }
 
 bool
-MixerScene::apply () const
+MixerScene::stage (ControllableValueMap const& cvm, StagedValues& sv, PBD::ControllableSet const& acs, AutomationTypeSet const& ts)
 {
 	bool rv = false;
 	std::set<PBD::ID> done;
-	AutomationTypeSet ts;
 
-	for (auto const& c : Controllable::registered_controllables ()) {
-		rv |= recurse_to_master (c, done, ts);
+	for (auto const& c : acs) {
+		rv |= recurse_to_master (cvm, c, done, ts, sv);
 	}
-
-	Change (); /* EMIT SIGNAL */
 	return rv;
 }
 
 bool
-MixerScene::apply (PBD::ControllableSet const& acs, AutomationTypeSet const& ts) const
+MixerScene::apply_staged (StagedValues const& sv, size_t first, size_t count)
 {
 	bool rv = false;
-	std::set<PBD::ID> done;
 
-	for (auto const& c : acs) {
-		rv |= recurse_to_master (c, done, ts);
+	size_t const end = first + std::min (count, sv.size () - std::min (first, sv.size ()));
+
+	for (size_t n = first; n < end; ++n) {
+		StagedValue const& v (sv[n]);
+		std::shared_ptr<AutomationControl> ac = v.ctrl.lock ();
+		if (!ac) {
+			continue;
+		}
+
+		double x = v.value;
+
+		if (v.slaved) {
+			/* masters have been set before, so this is up to date */
+			auto sc = std::dynamic_pointer_cast<SlavableAutomationControl> (ac);
+			double m = sc ? sc->reduce_by_masters (1.0) : 1.0;
+			if (m != 0) {
+				x = v.value / m;
+			} else {
+				x = 0;
+			}
+		}
+
+		if (x != ac->get_double ()) {
+			ac->set_value (x, Controllable::NoGroup);
+			rv = true;
+		}
 	}
+	return rv;
+}
+
+bool
+MixerScene::apply () const
+{
+	return apply (Controllable::registered_controllables ());
+}
+
+bool
+MixerScene::apply (PBD::ControllableSet const& acs, AutomationTypeSet const& ts) const
+{
+	StagedValues sv;
+	bool rv = stage (values (), sv, acs, ts);
+	apply_staged (sv);
 
 	Change (); /* EMIT SIGNAL */
 	return rv;
@@ -171,7 +223,7 @@ MixerScene::get_state () const
 	root->set_property ("id", id ());
 	root->set_property ("name", name ());
 
-	for (auto const& c : _ctrl_map) {
+	for (auto const& c : values ()) {
 		XMLNode* node = new XMLNode ("ControlValue");
 		node->set_property (X_("id"), c.first);
 		node->set_property (X_("value"), c.second);
@@ -183,7 +235,7 @@ MixerScene::get_state () const
 int
 MixerScene::set_state (XMLNode const& node, int /* version */)
 {
-	_ctrl_map.clear ();
+	ControllableValueMap cvm;
 
 	std::string name;
 	if (node.get_property ("name", name)) {
@@ -202,7 +254,10 @@ MixerScene::set_state (XMLNode const& node, int /* version */)
 		if (!n->get_property (X_("value"), value)) {
 			continue;
 		}
-		_ctrl_map[id] = value;
+		cvm[id] = value;
 	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_ctrl_map.swap (cvm);
 	return 0;
 }
@@ -334,6 +334,7 @@ Playlist::init (bool hide)
 	_xml_node_name = X_("Playlist");
 
 	block_notifications.store (0);
+	_region_write_locked.store (0);
 	pending_contents_change     = false;
 	pending_layering            = false;
 	first_set_state             = true;
@@ -789,6 +790,11 @@ Playlist::add_region_internal (std::shared_ptr<Region> region, timepos_t const &
 	regions.insert (upper_bound (regions.begin (), regions.end (), region, cmp), region);
 	all_regions.insert (region);
 
+	{
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		_region_index.add (region);
+	}
+
 	if (!holding_state ()) {
 		/* layers get assigned from XML state, and are not reset during undo/redo */
 		relayer ();
@@ -847,6 +853,7 @@ Playlist::remove_region_internal (std::shared_ptr<Region> region, ThawList& thaw
 		if (*i == region) {
 
 			regions.erase (i);
+			remove_region_from_index (region);
 
 			if (!holding_state ()) {
 				relayer ();
@@ -1679,6 +1686,14 @@ Playlist::region_changed_proxy (const PropertyChange& what_changed, std::weak_pt
 		return;
 	}
 
+	/* a change of time-domain changes the key, and may move the
+	 * region to a different tree of the index.
+	 */
+	if (what_changed.contains (Properties::start) || what_changed.contains (Properties::length) || what_changed.contains (Properties::time_domain)) {
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		_region_index.update (region);
+	}
+
 	/* this makes a virtual call to the right kind of playlist ... */
 
 	region_changed (what_changed, region);
@@ -1691,6 +1706,9 @@ Playlist::region_changed (const PropertyChange& what_changed, std::shared_ptr<Re
 	PropertyChange bounds;
 	bool           save = false;
 
+	bounds.add (Properties::start);
+	bounds.add (Properties::length);
+
 	if (in_set_state || in_flush) {
 		return false;
 	}
@@ -1701,9 +1719,6 @@ Playlist::region_changed (const PropertyChange& what_changed, std::shared_ptr<Re
 	our_interests.add (Properties::contents);
 	our_interests.add (Properties::time_domain);
 
-	bounds.add (Properties::start);
-	bounds.add (Properties::length);
-
 	bool send_contents = false;
 
 	if (what_changed.contains (bounds)) {
@@ -1748,6 +1763,9 @@ Playlist::drop_regions ()
 	RegionWriteLock rl (this);
 	regions.clear ();
 	all_regions.clear ();
+
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	_region_index.clear ();
 }
 
 void
@@ -1776,6 +1794,9 @@ Playlist::clear (bool with_signals)
 		}
 
 		regions.clear ();
+
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		_region_index.clear ();
 	}
 
 	if (with_signals) {
@@ -1821,10 +1842,13 @@ Playlist::regions_at (timepos_t const & pos)
 uint32_t
 Playlist::count_regions_at (timepos_t const & pos) const
 {
-	RegionReadLock rlock (const_cast<Playlist*> (this));
-	uint32_t       cnt = 0;
+	RegionReadLock   rlock (const_cast<Playlist*> (this));
+	RegionCandidates rc;
+	uint32_t         cnt = 0;
 
-	for (auto const & r : regions) {
+	region_candidates (QueryTouched, pos, pos, rc);
+
+	for (auto const & r : rc) {
 		if (r->covers (pos)) {
 			cnt++;
 		}
@@ -1938,14 +1962,51 @@ Playlist::region_is_audible_at (std::shared_ptr<Region> r, timepos_t const& pos)
 	return false;
 }
 
+void
+Playlist::remove_region_from_index (std::shared_ptr<Region> region)
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	_region_index.remove (region);
+}
+
+/** Collect regions that may match the given query, sorted by position.
+ * The exact condition must be checked by the caller.
+ * Caller must hold the region_lock.
+ */
+void
+Playlist::region_candidates (RegionQuery q, timepos_t const& start, timepos_t const& end, RegionCandidates& rc) const
+{
+	if (_region_write_locked.load () > 0) {
+		rc.assign (regions.begin (), regions.end ());
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	switch (q) {
+		case QueryTouched:
+			_region_index.touched (start, end, rc);
+			break;
+		case QueryStartWithin:
+			_region_index.starting_within (start, end, rc);
+			break;
+		case QueryEndWithin:
+			_region_index.ending_within (start, end, rc);
+			break;
+	}
+}
+
 std::shared_ptr<RegionList>
 Playlist::find_regions_at (timepos_t const & pos)
 {
 	/* Caller must hold lock */
 
 	std::shared_ptr<RegionList> rlist (new RegionList);
+	RegionCandidates            rc;
 
-	for (auto & r : regions) {
+	region_candidates (QueryTouched, pos, pos, rc);
+
+	for (auto const & r : rc) {
 		if (r->covers (pos)) {
 			rlist->push_back (r);
 		}
@@ -1959,8 +2020,11 @@ Playlist::regions_with_start_within (Temporal::Range range)
 {
 	RegionReadLock              rlock (this);
 	std::shared_ptr<RegionList> rlist (new RegionList);
+	RegionCandidates            rc;
 
-	for (auto & r : regions) {
+	region_candidates (QueryStartWithin, range.start (), range.end (), rc);
+
+	for (auto const & r : rc) {
 		if (r->position() >= range.start() && r->position() < range.end()) {
 			rlist->push_back (r);
 		}
@@ -1974,8 +2038,11 @@ Playlist::regions_with_end_within (Temporal::Range range)
 {
 	RegionReadLock              rlock (this);
 	std::shared_ptr<RegionList> rlist (new RegionList);
+	RegionCandidates            rc;
 
-	for (auto & r : regions) {
+	region_candidates (QueryEndWithin, range.start (), range.end (), rc);
+
+	for (auto const & r : rc) {
 		if (r->nt_last() >= range.start() && r->nt_last() < range.end()) {
 			rlist->push_back (r);
 		}
@@ -1994,9 +2061,14 @@ Playlist::regions_touched (timepos_t const & start, timepos_t const & end)
 std::shared_ptr<RegionList>
 Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end)
 {
+	/* Caller must hold lock */
+
 	std::shared_ptr<RegionList> rlist (new RegionList);
+	RegionCandidates            rc;
 
-	for (auto & r : regions) {
+	region_candidates (QueryTouched, start, end, rc);
+
+	for (auto const & r : rc) {
 		if (r->coverage (start, end) != Temporal::OverlapNone) {
 			rlist->push_back (r);
 		}
@@ -2070,6 +2142,14 @@ Playlist::find_next_region (timepos_t const & pos, RegionPoint point, int dir)
 	std::shared_ptr<Region> ret;
 	timecnt_t closest = timecnt_t::max (pos.time_domain());
 
+	if (point == Start && _region_write_locked.load () == 0) {
+		/* regions are sorted by position, use the index to
+		 * directly find the next/previous region.
+		 */
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		return _region_index.next_start (pos, dir);
+	}
+
 	bool end_iter = false;
 
 	for (auto const & r : regions) {
@@ -973,7 +973,19 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 				}
 
 #if 1
-				/* 2. VST3: events between now and end. */
+				/* 2. VST3: events between now and end.
+				 *
+				 * Evaluate the list once for the whole cycle, rather
+				 * than looking up each event's value separately.
+				 */
+				gain_t* cycle_vals = 0;
+				if (end > start && end - start <= (samplecnt_t) nframes) {
+					cycle_vals = _session.scratch_automation_buffer ();
+					if (!clist->rt_safe_eval_block (timepos_t (start), timepos_t (end), cycle_vals, end - start)) {
+						cycle_vals = 0;
+					}
+				}
+
 				timepos_t start_time (start);
 				timepos_t now (start_time);
 				while (true) {
@@ -984,7 +996,13 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 						break;
 					}
 					now = next_event.when;
-					const float val = c.list()->rt_safe_eval (now, valid);
+					float val;
+					if (cycle_vals) {
+						val = cycle_vals[now.samples() - start];
+						valid = true;
+					} else {
+						val = c.list()->rt_safe_eval (now, valid);
+					}
 					if (valid) {
 						for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 							(*i)->set_parameter (clist->parameter().id(), val, now.samples() - start);
@@ -32,8 +32,11 @@
 #include <sys/types.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 
+#include <boost/function.hpp>
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 
@@ -69,6 +72,7 @@
 #include <glibmm/fileutils.h>
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/file_utils.h"
 #include "pbd/tokenizer.h"
 #include "pbd/whitespace.h"
@@ -85,6 +89,8 @@
 #include "ardour/plugin_manager.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/search_paths.h"
+#include "ardour/system_exec.h"
+#include "ardour/utils.h"
 
 #if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
 #include "ardour/system_exec.h"
@@ -695,6 +701,251 @@ PluginManager::reset_scan_cancel_state (bool single)
 	_enable_scan_timeout     = false;
 }
 
+/* ****************************************************************************
+ * Out-of-process scans
+ *
+ * Scanner apps are started and monitored from the thread that performs
+ * the plugin discovery, the scan-log and blacklist are only modified
+ * from that thread.
+ */
+
+struct PluginManager::ScannerJob {
+	ScannerJob (std::string const& k, std::string const& bin, char** argp, PSLEPtr p)
+		: key (k)
+		, psle (p)
+		, scanner (bin, argp)
+		, timeout (0)
+		, notime (true)
+	{}
+
+	std::string           key;
+	PSLEPtr               psle;
+	ARDOUR::SystemExec    scanner;
+	std::stringstream     log;
+	PBD::ScopedConnection log_connection;
+	int                   timeout; /* deciseconds */
+	bool                  notime;
+
+	/** called before the scanner app is launched */
+	boost::function<void ()> started;
+	/** called when the scanner app exited */
+	boost::function<void ()> completed;
+	/** called when the scan timed out or was cancelled, to remove partial results */
+	boost::function<void ()> aborted;
+};
+
+static void scanner_log (std::string msg, std::stringstream* ss)
+{
+	*ss << msg;
+}
+
+void
+PluginManager::run_scanner_apps (ScannerJobList& pending, std::string const& type)
+{
+	uint32_t n_jobs = Config->get_plugin_scan_jobs ();
+	if (n_jobs == 0) {
+		n_jobs = std::max<uint32_t> (1, std::min<uint32_t> (8, hardware_concurrency ()));
+	}
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("%1: scan %2 plugins using %3 scanner app(s)\n", type, pending.size (), n_jobs));
+
+	size_t const   n_total = pending.size ();
+	size_t         n       = 0;
+	ScannerJobList running;
+
+	while (!pending.empty () || !running.empty ()) {
+
+		while (!pending.empty () && running.size () < n_jobs && !_cancel_scan_all) {
+			ScannerJobPtr j = pending.front ();
+			pending.pop_front ();
+
+			ARDOUR::PluginScanMessage (string_compose (_("%1 (%2 / %3)"), type, ++n, n_total), j->key, true);
+
+			if (j->started) {
+				j->started ();
+			}
+
+			j->scanner.ReadStdout.connect_same_thread (j->log_connection, boost::bind (&scanner_log, _1, &j->log));
+
+			if (j->scanner.start (ARDOUR::SystemExec::MergeWithStdin)) {
+				j->psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch scanner app '%1': %2"), j->scanner.to_s (), strerror (errno)));
+				_scanner_results[j->key] = false;
+				continue;
+			}
+
+			j->timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0;
+			j->notime  = (j->timeout <= 0);
+			running.push_back (j);
+		}
+
+		if (_cancel_scan_all) {
+			/* remaining plugins are scanned next time */
+			pending.clear ();
+		}
+
+		if (running.empty ()) {
+			continue;
+		}
+
+		Glib::usleep (100000);
+
+		/* cancel-one and skip-timeout apply to all scans that are currently running */
+		bool const cancel = cancelled ();
+
+		for (ScannerJobList::iterator i = running.begin (); i != running.end ();) {
+			ScannerJobPtr j = *i;
+
+			if (!j->notime && no_timeout ()) {
+				j->notime  = true;
+				j->timeout = -1;
+			} else if (j->notime && !no_timeout() && _enable_scan_timeout) {
+				j->notime  = false;
+				j->timeout = 1 + Config->get_plugin_scan_timeout ();
+			}
+
+			if (j->timeout > -864000) {
+				--j->timeout;
+			}
+
+			if (!j->scanner.is_running ()) {
+				j->psle->msg (PluginScanLogEntry::OK, j->log.str());
+				_scanner_results[j->key] = true;
+				if (j->completed) {
+					j->completed ();
+				}
+				i = running.erase (i);
+				continue;
+			}
+
+			if (cancel || (!j->notime && j->timeout == 0)) {
+				j->scanner.terminate ();
+				j->psle->msg (PluginScanLogEntry::OK, j->log.str());
+				if (cancel) {
+					j->psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
+				} else {
+					j->psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
+				}
+				if (j->aborted) {
+					j->aborted ();
+				}
+				_scanner_results[j->key] = false;
+				i = running.erase (i);
+				continue;
+			}
+			++i;
+		}
+
+		if (cancel) {
+			reset_scan_cancel_state (true);
+		}
+
+		if (!running.empty ()) {
+			/* the scan that was started first is the next to time out */
+			ARDOUR::PluginScanTimeout (running.front ()->timeout);
+		}
+	}
+}
+
+/** Look up and consume the result of run_scanner_apps ().
+ * @return false if the plugin was not scanned there.
+ */
+bool
+PluginManager::scanner_result (std::string const& key, bool& completed)
+{
+	std::map<std::string, bool>::iterator i = _scanner_results.find (key);
+	if (i == _scanner_results.end ()) {
+		return false;
+	}
+	completed = i->second;
+	_scanner_results.erase (i);
+	return true;
+}
+
+/* ****************************************************************************
+ * Shared scan cache
+ *
+ * Scan results are additionally stored by the checksum of the plugin
+ * binary. Machines with identical plugins can share the folder, and
+ * re-use scan results instead of loading the plugin.
+ */
+
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+
+static std::string
+shared_scan_cache_dir ()
+{
+	std::string dir = Config->get_plugin_scan_cache_path ();
+	if (dir.empty ()) {
+		dir = Glib::build_filename (ARDOUR::user_cache_directory (), "scan-cache");
+	}
+	if (!Glib::file_test (dir, Glib::FILE_TEST_IS_DIR)) {
+		if (g_mkdir_with_parents (dir.c_str (), 0755)) {
+			PBD::warning << string_compose (_("Cannot create plugin scan cache folder '%1'"), dir) << endmsg;
+			return "";
+		}
+	}
+	return dir;
+}
+
+/** @param tag format and architecture of the cached scan result
+ *  @return file in the shared cache for the given plugin binary, or an empty string
+ */
+static std::string
+shared_scan_cache_file (std::string const& binary, std::string const& tag)
+{
+	std::string const dir = shared_scan_cache_dir ();
+	if (dir.empty ()) {
+		return "";
+	}
+	std::string const hash = compute_sha1_of_file (binary);
+	if (hash.empty ()) {
+		return "";
+	}
+	return Glib::build_filename (dir, hash + "-" + tag + ".xml");
+}
+
+/** Copy a scan result from the shared cache to \a cache_file,
+ *  replacing the plugin's paths with the local ones.
+ */
+static bool
+shared_scan_cache_restore (std::string const& shared_file, std::string const& cache_file, std::map<std::string, std::string> const& paths)
+{
+	if (shared_file.empty () || !Glib::file_test (shared_file, Glib::FILE_TEST_IS_REGULAR)) {
+		return false;
+	}
+
+	XMLTree tree;
+	if (!tree.read (shared_file) || !tree.root ()) {
+		return false;
+	}
+	for (std::map<std::string, std::string>::const_iterator i = paths.begin (); i != paths.end (); ++i) {
+		tree.root ()->set_property (i->first.c_str (), i->second);
+	}
+	return tree.write (cache_file);
+}
+
+static void
+shared_scan_cache_store (std::string const& shared_file, std::string const& cache_file)
+{
+	if (shared_file.empty () || cache_file.empty ()) {
+		return;
+	}
+
+	std::string data;
+	try {
+		data = Glib::file_get_contents (cache_file);
+	} catch (Glib::FileError const& err) {
+		return;
+	}
+
+	/* atomically replaced, the folder may be shared */
+	if (!g_file_set_contents (shared_file.c_str (), data.c_str (), data.size (), NULL)) {
+		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Cannot write to shared scan cache '%1'\n", shared_file));
+	}
+}
+
+#endif
+
 void
 PluginManager::clear_vst_cache ()
 {
@@ -1178,11 +1429,11 @@ static void auv2_scanner_log (std::string msg, std::stringstream* ss)
 	*ss << msg;
 }
 
-bool
-PluginManager::run_auv2_scanner_app (CAComponentDescription const& desc, AUv2DescStr const& d, PSLEPtr psle) const
+static char**
+auv2_scanner_argp (std::string const& bin, AUv2DescStr const& d)
 {
 	char **argp= (char**) calloc (8, sizeof (char*));
-	argp[0] = strdup (auv2_scanner_bin_path.c_str ());
+	argp[0] = strdup (bin.c_str ());
 	argp[1] = strdup ("-f");
 	if (Config->get_verbose_plugin_scan()) {
 		argp[2] = strdup ("-v");
@@ -1194,6 +1445,61 @@ PluginManager::run_auv2_scanner_app (CAComponentDescription const& desc, AUv2Des
 	argp[5] = strdup (d.subt.c_str());
 	argp[6] = strdup (d.manu.c_str());
 	argp[7] = 0;
+	return argp;
+}
+
+static void
+auv2_scan_started (std::string const& dstr)
+{
+	auv2_blacklist (dstr);
+}
+
+static void
+auv2_scan_aborted (AUv2DescStr const& d)
+{
+	/* may be partially written */
+	g_unlink (auv2_cache_file (d.desc ()).c_str ());
+	auv2_whitelist (d.to_s ());
+}
+
+/** Run the scanner app for all plugins that need to be scanned,
+ * before auv2_discover () reads the cache files.
+ */
+void
+PluginManager::auv2_parallel_scan (std::vector<AUv2DescStr> const& audesc)
+{
+	if (auv2_scanner_bin_path.empty ()) {
+		/* scan in host context, one at a time */
+		return;
+	}
+
+	ScannerJobList jobs;
+
+	for (std::vector<AUv2DescStr>::const_iterator i = audesc.begin (); i != audesc.end (); ++i) {
+		if (!i->valid ()) {
+			continue;
+		}
+		std::string const dstr = i->to_s ();
+		if (auv2_is_blacklisted (dstr) || !auv2_valid_cache_file (i->desc ()).empty ()) {
+			continue;
+		}
+
+		PSLEPtr psle (scan_log_entry (AudioUnit, dstr));
+		psle->reset ();
+
+		ScannerJobPtr j (new ScannerJob (dstr, auv2_scanner_bin_path, auv2_scanner_argp (auv2_scanner_bin_path, *i), psle));
+		j->started = boost::bind (&auv2_scan_started, dstr);
+		j->aborted = boost::bind (&auv2_scan_aborted, *i);
+		jobs.push_back (j);
+	}
+
+	run_scanner_apps (jobs, _("AUv2"));
+}
+
+bool
+PluginManager::run_auv2_scanner_app (CAComponentDescription const& desc, AUv2DescStr const& d, PSLEPtr psle) const
+{
+	char **argp = auv2_scanner_argp (auv2_scanner_bin_path, d);
 
 	stringstream scan_log;
 	ARDOUR::SystemExec scanner (auv2_scanner_bin_path, argp);
@@ -1317,11 +1623,19 @@ PluginManager::auv2_discover (AUv2DescStr const& d, bool cache_only)
 
 	if (!cache_only && run_scan) {
 		/* re/generate cache file */
-		psle->reset ();
-		auv2_blacklist (dstr);
+		bool completed;
+		if (scanner_result (dstr, completed)) {
+			/* scanner app already ran, see auv2_parallel_scan */
+			if (!completed) {
+				return -1;
+			}
+		} else {
+			psle->reset ();
+			auv2_blacklist (dstr);
 
-		if (!run_auv2_scanner_app (desc, d, psle)) {
-			return -1;
+			if (!run_auv2_scanner_app (desc, d, psle)) {
+				return -1;
+			}
 		}
 
 		cache_file = auv2_cache_file (desc);
@@ -1398,6 +1712,10 @@ PluginManager::au_refresh (bool cache_only)
 
 	::g_unlink (aucrsh.c_str());
 
+	if (!cache_only && !cancelled ()) {
+		auv2_parallel_scan (audesc);
+	}
+
 	size_t n = 1;
 	size_t all_modules = audesc.size ();
 	for (std::vector<AUv2DescStr>::const_iterator i = audesc.begin (); i != audesc.end (); ++i, ++n) {
@@ -1406,6 +1724,8 @@ PluginManager::au_refresh (bool cache_only)
 		auv2_discover (*i, cache_only || cancelled ());
 	}
 
+	_scanner_results.clear ();
+
 	for (PluginInfoList::iterator i = _au_plugin_info->begin(); i != _au_plugin_info->end(); ++i) {
 		set_tags ((*i)->type, (*i)->unique_id, (*i)->category, (*i)->name, FromPlug);
 	}
@@ -1477,11 +1797,11 @@ static void vst2_scanner_log (std::string msg, std::stringstream* ss)
 	*ss << msg;
 }
 
-bool
-PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle) const
+static char**
+vst2_scanner_argp (std::string const& bin, std::string const& path)
 {
 	char **argp= (char**) calloc (5, sizeof (char*));
-	argp[0] = strdup (vst2_scanner_bin_path.c_str ());
+	argp[0] = strdup (bin.c_str ());
 	argp[1] = strdup ("-f");
 	if (Config->get_verbose_plugin_scan()) {
 		argp[2] = strdup ("-v");
@@ -1490,6 +1810,75 @@ PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle) const
 	}
 	argp[3] = strdup (path.c_str ());
 	argp[4] = 0;
+	return argp;
+}
+
+static void
+vst2_scan_started (std::string const& path)
+{
+	vst2_blacklist (path);
+}
+
+static void
+vst2_scan_completed (std::string const& path, std::string const& shared_file)
+{
+	shared_scan_cache_store (shared_file, vst2_valid_cache_file (path));
+}
+
+static void
+vst2_scan_aborted (std::string const& path)
+{
+	/* may be partially written */
+	g_unlink (vst2_cache_file (path).c_str ());
+	vst2_whitelist (path);
+}
+
+/** Run the scanner app for all plugins that need to be scanned,
+ * before vst2_discover () reads the cache files.
+ */
+void
+PluginManager::vst2_parallel_scan (std::vector<std::string> const& plugins, ARDOUR::PluginType type)
+{
+	if (vst2_scanner_bin_path.empty ()) {
+		/* scan in host context, one at a time */
+		return;
+	}
+
+	ScannerJobList jobs;
+
+	for (vector<string>::const_iterator i = plugins.begin(); i != plugins.end (); ++i) {
+		if (vst2_is_blacklisted (*i) || !vst2_valid_cache_file (*i).empty ()) {
+			continue;
+		}
+
+		PSLEPtr      psle (scan_log_entry (type, *i));
+		string const shared_file = shared_scan_cache_file (*i, string_compose ("vst2-%1", vst2_arch ()));
+
+		std::map<std::string, std::string> paths;
+		paths["binary"] = *i;
+
+		if (shared_scan_cache_restore (shared_file, vst2_cache_file (*i), paths) && !vst2_valid_cache_file (*i).empty ()) {
+			psle->reset ();
+			psle->msg (PluginScanLogEntry::OK, string_compose (_("Using VST2 scan result of identical plugin '%1'"), shared_file));
+			continue;
+		}
+
+		psle->reset ();
+
+		ScannerJobPtr j (new ScannerJob (*i, vst2_scanner_bin_path, vst2_scanner_argp (vst2_scanner_bin_path, *i), psle));
+		j->started   = boost::bind (&vst2_scan_started, *i);
+		j->completed = boost::bind (&vst2_scan_completed, *i, shared_file);
+		j->aborted   = boost::bind (&vst2_scan_aborted, *i);
+		jobs.push_back (j);
+	}
+
+	run_scanner_apps (jobs, _("VST2"));
+}
+
+bool
+PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle) const
+{
+	char **argp = vst2_scanner_argp (vst2_scanner_bin_path, path);
 
 	stringstream scan_log;
 	ARDOUR::SystemExec scanner (vst2_scanner_bin_path, argp);
@@ -1663,11 +2052,19 @@ PluginManager::vst2_discover (string path, ARDOUR::PluginType type, bool cache_o
 
 	if (!cache_only && run_scan) {
 		/* re/generate cache file */
-		psle->reset ();
-		vst2_blacklist (path);
+		bool completed;
+		if (scanner_result (path, completed)) {
+			/* scanner app already ran, see vst2_parallel_scan */
+			if (!completed) {
+				return -1;
+			}
+		} else {
+			psle->reset ();
+			vst2_blacklist (path);
 
-		if (!run_vst2_scanner_app (path, psle)) {
-			return -1;
+			if (!run_vst2_scanner_app (path, psle)) {
+				return -1;
+			}
 		}
 
 		cache_file = vst2_valid_cache_file (path);
@@ -1779,6 +2176,10 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	if (!cache_only && !cancelled ()) {
+		vst2_parallel_scan (plugin_objects, Windows_VST);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
@@ -1787,6 +2188,8 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 		vst2_discover (*x, Windows_VST, cache_only || cancelled());
 	}
 
+	_scanner_results.clear ();
+
 	return ret;
 }
 #endif // WINDOWS_VST_SUPPORT
@@ -1862,6 +2265,10 @@ PluginManager::mac_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	if (!cache_only && !cancelled ()) {
+		vst2_parallel_scan (plugin_objects, MacVST);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
@@ -1870,6 +2277,8 @@ PluginManager::mac_vst_discover_from_path (string path, bool cache_only)
 		vst2_discover (*x, MacVST, cache_only || cancelled());
 	}
 
+	_scanner_results.clear ();
+
 	return 0;
 }
 
@@ -1922,6 +2331,10 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	if (!cache_only && !cancelled ()) {
+		vst2_parallel_scan (plugin_objects, LXVST);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
@@ -1930,6 +2343,8 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 		vst2_discover (*x, LXVST, cache_only || cancelled());
 	}
 
+	_scanner_results.clear ();
+
 	return 0;
 }
 
@@ -2028,6 +2443,48 @@ static void vst3_whitelist (string module_path)
 	Glib::file_set_contents (fn, bl);
 }
 
+static char**
+vst3_scanner_argp (std::string const& bin, std::string const& bundle_path)
+{
+	char **argp= (char**) calloc (5, sizeof (char*));
+	argp[0] = strdup (bin.c_str ());
+	argp[1] = strdup ("-f");
+	if (Config->get_verbose_plugin_scan()) {
+		argp[2] = strdup ("-v");
+	} else {
+		argp[2] = strdup ("-f");
+	}
+	argp[3] = strdup (bundle_path.c_str ());
+	argp[4] = 0;
+	return argp;
+}
+
+#if defined __APPLE__ && defined __aarch64__
+# define VST3_SCAN_CACHE_TAG "vst3-arm64"
+#else
+# define VST3_SCAN_CACHE_TAG "vst3"
+#endif
+
+static void
+vst3_scan_started (std::string const& module_path)
+{
+	vst3_blacklist (module_path);
+}
+
+static void
+vst3_scan_completed (std::string const& module_path, std::string const& shared_file)
+{
+	shared_scan_cache_store (shared_file, vst3_valid_cache_file (module_path));
+}
+
+static void
+vst3_scan_aborted (std::string const& module_path)
+{
+	/* may be partially written */
+	g_unlink (vst3_cache_file (module_path).c_str ());
+	vst3_whitelist (module_path);
+}
+
 static bool vst3_filter (const string& str, void*)
 {
 	return str[0] != '.' && (str.length() > 4 && str.find (".vst3") == (str.length() - 5));
@@ -2072,6 +2529,10 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	if (!cache_only && !cancelled ()) {
+		vst3_parallel_scan (plugin_objects);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i, ++n) {
@@ -2081,9 +2542,59 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 		vst3_discover (*i, cache_only || cancelled ());
 	}
 
+	_scanner_results.clear ();
+
 	return cancelled() ? -1 : 0;
 }
 
+/** Run the scanner app for all bundles that need to be scanned,
+ * before vst3_discover () reads the cache files.
+ */
+void
+PluginManager::vst3_parallel_scan (std::vector<std::string> const& bundles)
+{
+	if (vst3_scanner_bin_path.empty ()) {
+		/* scan in host context, one at a time */
+		return;
+	}
+
+	ScannerJobList jobs;
+
+	for (vector<string>::const_iterator i = bundles.begin(); i != bundles.end (); ++i) {
+		string const module_path = module_path_vst3 (*i);
+		if (module_path.empty () || module_path == "-1" || vst3_is_blacklisted (module_path)) {
+			continue;
+		}
+		if (!vst3_valid_cache_file (module_path).empty ()) {
+			continue;
+		}
+
+		PSLEPtr      psle (scan_log_entry (VST3, *i));
+		string const shared_file = shared_scan_cache_file (module_path, VST3_SCAN_CACHE_TAG);
+
+		std::map<std::string, std::string> paths;
+		paths["bundle"] = *i;
+		paths["module"] = module_path;
+
+		if (shared_scan_cache_restore (shared_file, vst3_cache_file (module_path), paths) && !vst3_valid_cache_file (module_path).empty ()) {
+			psle->reset ();
+			psle->msg (PluginScanLogEntry::OK, string_compose (_("Using VST3 scan result of identical plugin '%1'"), shared_file));
+			continue;
+		}
+
+		psle->reset ();
+		psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", module_path));
+
+		ScannerJobPtr j (new ScannerJob (*i, vst3_scanner_bin_path, vst3_scanner_argp (vst3_scanner_bin_path, *i), psle));
+		j->started   = boost::bind (&vst3_scan_started, module_path);
+		j->completed = boost::bind (&vst3_scan_completed, module_path, shared_file);
+		j->aborted   = boost::bind (&vst3_scan_aborted, module_path);
+		jobs.push_back (j);
+	}
+
+	run_scanner_apps (jobs, _("VST3"));
+}
+
 void
 PluginManager::vst3_plugin (string const& module_path, string const& bundle_path, VST3Info const& i)
 {
@@ -2170,11 +2681,19 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 
 	if (!cache_only && run_scan) {
 		/* re/generate cache file */
-		psle->reset ();
-		vst3_blacklist (module_path);
-		psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", module_path));
-		if (!run_vst3_scanner_app (path, psle)) {
-			return -1;
+		bool completed;
+		if (scanner_result (path, completed)) {
+			/* scanner app already ran, see vst3_parallel_scan */
+			if (!completed) {
+				return -1;
+			}
+		} else {
+			psle->reset ();
+			vst3_blacklist (module_path);
+			psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", module_path));
+			if (!run_vst3_scanner_app (path, psle)) {
+				return -1;
+			}
 		}
 
 		cache_file = vst3_valid_cache_file (module_path);
@@ -2235,16 +2754,7 @@ static void vst3_scanner_log (std::string msg, std::stringstream* ss)
 bool
 PluginManager::run_vst3_scanner_app (std::string bundle_path, PSLEPtr psle) const
 {
-	char **argp= (char**) calloc (5, sizeof (char*));
-	argp[0] = strdup (vst3_scanner_bin_path.c_str ());
-	argp[1] = strdup ("-f");
-	if (Config->get_verbose_plugin_scan()) {
-		argp[2] = strdup ("-v");
-	} else {
-		argp[2] = strdup ("-f");
-	}
-	argp[3] = strdup (bundle_path.c_str ());
-	argp[4] = 0;
+	char **argp = vst3_scanner_argp (vst3_scanner_bin_path, bundle_path);
 
 	stringstream scan_log;
 	ARDOUR::SystemExec scanner (vst3_scanner_bin_path, argp);
@@ -256,8 +256,11 @@ PortManager::PortManager ()
 	, _midi_info_dirty (true)
 	, _audio_input_ports (new AudioInputPorts)
 	, _midi_input_ports (new MIDIInputPorts)
+	, _input_resample_groups (new InputResampleGroups)
+	, _resample_cycle (0)
 {
 	_reset_meters.store (1);
+	_input_resample_groups_dirty.store (true);
 	load_port_info ();
 }
 
@@ -302,6 +305,8 @@ PortManager::remove_session_ports ()
 
 	_ports.flush ();
 
+	update_input_resample_groups ();
+
 	/* clear out pending port deletion list. we know this is safe because
 	 * the auto connect thread in Session is already dead when this is
 	 * done. It doesn't use shared_ptr<Port> anyway.
@@ -713,6 +718,9 @@ PortManager::unregister_port (std::shared_ptr<Port> port)
 
 	_ports.flush ();
 
+	/* drop references to the port */
+	update_input_resample_groups ();
+
 	return 0;
 }
 
@@ -1001,6 +1009,8 @@ PortManager::connect_callback (const string& a, const string& b, bool conn)
 		}
 	}
 
+	_input_resample_groups_dirty.store (true);
+
 	PortConnectedOrDisconnected (
 	    port_a, a,
 	    port_b, b,
@@ -1017,6 +1027,7 @@ PortManager::registration_callback ()
 	}
 
 	update_input_ports (false);
+	update_input_resample_groups ();
 
 	PortRegisteredOrUnregistered (); /* EMIT SIGNAL */
 }
@@ -1249,86 +1260,235 @@ PortManager::graph_order_callback ()
 	DEBUG_TRACE (DEBUG::BackendCallbacks, "graph order callback\n");
 
 	if (!_port_remove_in_progress) {
+		if (_input_resample_groups_dirty.load ()) {
+			update_input_resample_groups ();
+		}
 		GraphReordered (); /* EMIT SIGNAL */
 	}
 
 	return 0;
 }
 
+/** Group audio input ports that are connected to the same set of
+ * ports. All ports of a group receive identical data, so it only
+ * needs to be resampled once.
+ */
 void
-PortManager::cycle_start (pframes_t nframes, Session* s)
+PortManager::update_input_resample_groups ()
 {
-	Port::set_global_port_buffer_offset (0);
-	Port::set_cycle_samplecnt (nframes);
+	Glib::Threads::Mutex::Lock lm (_input_resample_groups_lock);
 
-	_cycle_ports = _ports.reader ();
+	/* clear the flag first, connections may change while we're here */
+	_input_resample_groups_dirty.store (false);
 
-	/* pre-calc/cache value */
-	falloff_cache.calc (nframes, s ? s->nominal_sample_rate () : 0);
+	std::map<std::vector<std::string>, InputResampleGroup> by_connections;
 
-	/* TODO optimize
-	 *  - when speed == 1.0, the resampler copies data without processing
-	 *   it may (or may not) be more efficient to just run all in sequence.
-	 *
-	 *  - single sequential task for 'lightweight' tasks would make sense
-	 *    (run it in parallel with 'heavy' resampling.
-	 *    * output ports (sends_output()) only set a flag
-	 *    * midi-ports only scale event timestamps
-	 *
-	 *  - a threshold parallel vs searial processing may be appropriate.
-	 *    amount of work (how many connected ports are there, how
-	 *    many resamplers need to run) vs. available CPU cores and semaphore
-	 *    synchronization overhead.
-	 *
-	 *  - input ports: it would make sense to resample each input only once
-	 *    (rather than resample into each ardour-owned input port).
-	 *    A single external source-port may be connected to many ardour
-	 *    input-ports. Currently re-sampling is per input.
-	 */
+	for (auto const& p : *_ports.reader ()) {
+		std::shared_ptr<AudioPort> ap = std::dynamic_pointer_cast<AudioPort> (p.second);
+		if (!ap || ap->sends_output () || !ap->externally_connected () || (ap->flags () & TransportSyncPort)) {
+			continue;
+		}
+		std::vector<std::string> c;
+		if (ap->get_connections (c) == 0) {
+			continue;
+		}
+		std::sort (c.begin (), c.end ());
+		by_connections[c].push_back (ap);
+	}
+
+	{
+		RCUWriter<InputResampleGroups>        writer (_input_resample_groups);
+		std::shared_ptr<InputResampleGroups> g = writer.get_copy ();
+		g->clear ();
+		for (auto& i : by_connections) {
+			if (i.second.size () > 1) {
+				DEBUG_TRACE (DEBUG::Ports, string_compose ("%1 input ports share resampler with %2\n", i.second.size () - 1, i.second.front ()->name ()));
+				g->push_back (i.second);
+			}
+		}
+	}
+
+	_input_resample_groups.flush ();
+}
+
+PortManager::ResampleMode
+PortManager::resample_mode (Port const* p, bool input) const
+{
+	if ((p->flags () & TransportSyncPort) || p->type () != DataType::AUDIO || !p->externally_connected ()) {
+		return NoResample;
+	}
+	if (p->sends_output () == input) {
+		return NoResample;
+	}
+	if (input && static_cast<AudioPort const*> (p)->_shared_src_cycle == _resample_cycle) {
+		return SharedResample;
+	}
+	return Resample;
+}
+
+void
+PortManager::resample_input_group (InputResampleGroup const* g, pframes_t nframes)
+{
+	std::shared_ptr<AudioPort> const& src (g->front ());
+	src->cycle_start (nframes);
+	for (auto i = g->begin () + 1; i != g->end (); ++i) {
+		(*i)->cycle_start_shared (nframes, *src);
+	}
+}
+
+/** cycle_start() of all ports that do not resample, and input metering.
+ * This is light-weight and executed as single task.
+ */
+void
+PortManager::cycle_start_no_resample (pframes_t nframes, samplecnt_t sr)
+{
+	for (auto const& p : *_cycle_ports) {
+		if (!(p.second->flags () & TransportSyncPort) && resample_mode (p.second.get (), true) == NoResample) {
+			p.second->cycle_start (nframes);
+		}
+	}
+	run_input_meters (nframes, sr);
+}
+
+void
+PortManager::cycle_end_no_resample (pframes_t nframes)
+{
+	for (auto const& p : *_cycle_ports) {
+		if (!(p.second->flags () & TransportSyncPort) && resample_mode (p.second.get (), false) == NoResample) {
+			p.second->cycle_end (nframes);
+		}
+	}
+}
+
+void
+PortManager::cycle_end_ports (pframes_t nframes, Session* s)
+{
+	/* see ::cycle_start() */
 	std::shared_ptr<RTTaskList> tl;
 	if (s) {
 		tl = s->rt_tasklist ();
 	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
+
+	size_t n_jobs = 0;
+	for (auto const& p : *_cycle_ports) {
+		if (resample_mode (p.second.get (), false) == Resample) {
+			++n_jobs;
+		}
+	}
+
+	if (tl && fabs (Port::resample_ratio ()) != 1.0 && parallel_resample (*tl, n_jobs, nframes)) {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (boost::bind (&Port::cycle_start, p.second, nframes));
+			if (resample_mode (p.second.get (), false) == Resample) {
+				tl->push_back (boost::bind (&Port::cycle_end, p.second, nframes));
 			}
 		}
-		tl->push_back (boost::bind (&PortManager::run_input_meters, this, nframes, s ? s->nominal_sample_rate () : 0));
+		tl->push_back (boost::bind (&PortManager::cycle_end_no_resample, this, nframes));
 		tl->process ();
 	} else {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				p.second->cycle_start (nframes);
+			if (resample_mode (p.second.get (), false) == Resample) {
+				p.second->cycle_end (nframes);
 			}
 		}
-		run_input_meters (nframes, s ? s->nominal_sample_rate () : 0);
+		cycle_end_no_resample (nframes);
+	}
+}
+
+/** Decide if resampling is worth to be processed in parallel.
+ *
+ * Cost of resampling is approx. proportional to the number of samples
+ * times the filter length (resampler quality). Every task that runs
+ * in parallel implies some synchronization overhead per thread.
+ */
+bool
+PortManager::parallel_resample (RTTaskList const& tl, size_t n_jobs, pframes_t nframes) const
+{
+	/* ~ 64k multiply-accumulate operations per thread
+	 * out-weigh the semaphore signal/wake-up overhead */
+	static const uint64_t min_work_per_thread = 65536;
+
+	uint32_t const n_threads = tl.n_threads ();
+	if (n_threads < 2 || n_jobs < 2) {
+		return false;
 	}
+	uint64_t const work = (uint64_t) n_jobs * nframes * Port::resampler_quality ();
+	return work >= min_work_per_thread * std::min<uint64_t> (n_threads, n_jobs);
 }
 
 void
-PortManager::cycle_end (pframes_t nframes, Session* s)
+PortManager::cycle_start (pframes_t nframes, Session* s)
 {
-	// see optimzation note in ::cycle_start()
+	Port::set_global_port_buffer_offset (0);
+	Port::set_cycle_samplecnt (nframes);
+
+	_cycle_ports = _ports.reader ();
+
+	/* pre-calc/cache value */
+	falloff_cache.calc (nframes, s ? s->nominal_sample_rate () : 0);
+
 	std::shared_ptr<RTTaskList> tl;
 	if (s) {
 		tl = s->rt_tasklist ();
 	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
+
+	samplecnt_t const sr = s ? s->nominal_sample_rate () : 0;
+
+	/* Input ports connected to the same external port(s) receive
+	 * identical data. Resample it only once and share the result.
+	 * Ports that are part of a group are tagged for this cycle.
+	 */
+	std::shared_ptr<InputResampleGroups const> groups = _input_resample_groups.reader ();
+
+	if (++_resample_cycle == 0) {
+		++_resample_cycle;
+	}
+
+	for (auto const& g : *groups) {
+		for (auto const& p : g) {
+			p->_shared_src_cycle = _resample_cycle;
+		}
+	}
+
+	size_t n_jobs = groups->size ();
+
+	for (auto const& p : *_cycle_ports) {
+		if (resample_mode (p.second.get (), true) == Resample) {
+			++n_jobs;
+		}
+	}
+
+	/* When speed == 1.0, the resampler only copies data.
+	 * Otherwise distribute resampling if there is sufficient work,
+	 * ports that do not resample are handled by a single task.
+	 */
+	if (tl && fabs (Port::resample_ratio ()) != 1.0 && parallel_resample (*tl, n_jobs, nframes)) {
+		for (auto const& g : *groups) {
+			tl->push_back (boost::bind (&PortManager::resample_input_group, this, &g, nframes));
+		}
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (boost::bind (&Port::cycle_end, p.second, nframes));
+			if (resample_mode (p.second.get (), true) == Resample) {
+				tl->push_back (boost::bind (&Port::cycle_start, p.second, nframes));
 			}
 		}
+		tl->push_back (boost::bind (&PortManager::cycle_start_no_resample, this, nframes, sr));
 		tl->process ();
 	} else {
+		for (auto const& g : *groups) {
+			resample_input_group (&g, nframes);
+		}
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				p.second->cycle_end (nframes);
+			if (resample_mode (p.second.get (), true) == Resample) {
+				p.second->cycle_start (nframes);
 			}
 		}
+		cycle_start_no_resample (nframes, sr);
 	}
+}
+
+void
+PortManager::cycle_end (pframes_t nframes, Session* s)
+{
+	cycle_end_ports (nframes, s);
 
 	for (auto const& p : *_cycle_ports) {
 		/* AudioEngine::split_cycle flushes buffers until Port::port_offset.
@@ -1428,25 +1588,7 @@ PortManager::check_monitoring ()
 void
 PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t nframes, Session* s)
 {
-	// see optimzation note in ::cycle_start()
-	std::shared_ptr<RTTaskList> tl;
-	if (s) {
-		tl = s->rt_tasklist ();
-	}
-	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
-		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (boost::bind (&Port::cycle_end, p.second, nframes));
-			}
-		}
-		tl->process ();
-	} else {
-		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				p.second->cycle_end (nframes);
-			}
-		}
-	}
+	cycle_end_ports (nframes, s);
 
 	for (auto const& p : *_cycle_ports) {
 		p.second->flush_buffers (nframes);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <algorithm>
+#include <climits>
+
+#include <fcntl.h>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/read_ahead.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+
+/* ranges of the same file closer than this are merged,
+ * reading the gap is cheaper than an additional seek.
+ */
+static const off_t merge_gap = 65536;
+
+ReadAhead::ReadAhead (uint32_t n_threads)
+	: _queued (0)
+	, _next (0)
+	, _pending (0)
+	, _run (true)
+{
+	/* with a single thread, advice is given by the caller */
+	for (uint32_t n = 0; n_threads > 1 && n < n_threads; ++n) {
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&ReadAhead::thread_work, this), string_compose ("read ahead %1", n));
+		if (!t) {
+			error << _("Session: could not create read-ahead thread") << endmsg;
+			break;
+		}
+		_threads.push_back (t);
+	}
+}
+
+ReadAhead::~ReadAhead ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_run = false;
+		_cond.broadcast ();
+	}
+
+	for (auto& t : _threads) {
+		t->join ();
+		delete t;
+	}
+}
+
+void
+ReadAhead::add (int fd, uint64_t file, off_t offset, off_t len)
+{
+	if (fd < 0 || len <= 0) {
+		return;
+	}
+	_ranges.push_back (Range (fd, file, offset, len));
+}
+
+void
+ReadAhead::commit ()
+{
+	if (_ranges.empty ()) {
+		return;
+	}
+
+	std::sort (_ranges.begin (), _ranges.end ());
+
+	/* merge overlapping and nearby ranges */
+	std::vector<Range>::iterator o = _ranges.begin ();
+	for (std::vector<Range>::const_iterator i = _ranges.begin () + 1; i != _ranges.end (); ++i) {
+		if (i->file == o->file && i->fd == o->fd && i->offset <= o->offset + o->len + merge_gap) {
+			o->len = std::max (o->offset + o->len, i->offset + i->len) - o->offset;
+		} else {
+			*(++o) = *i;
+		}
+	}
+	_ranges.erase (++o, _ranges.end ());
+
+	if (_threads.empty () || _ranges.size () < 2) {
+		for (auto const& r : _ranges) {
+			advise (r);
+		}
+		_ranges.clear ();
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	_queued  = _ranges.size ();
+	_next    = 0;
+	_pending = _queued;
+	_cond.broadcast ();
+
+	while (_pending > 0) {
+		_done.wait (_lock);
+	}
+
+	_queued = _next = 0;
+	_ranges.clear ();
+}
+
+void
+ReadAhead::advise (Range const& r)
+{
+#if defined __APPLE__
+	struct radvisory ra;
+	ra.ra_offset = r.offset;
+	ra.ra_count  = std::min<off_t> (r.len, INT_MAX);
+	fcntl (r.fd, F_RDADVISE, &ra);
+#elif defined __linux__
+	posix_fadvise (r.fd, r.offset, r.len, POSIX_FADV_WILLNEED);
+#endif
+}
+
+void
+ReadAhead::thread_work ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	while (true) {
+		while (_run && _next >= _queued) {
+			_cond.wait (_lock);
+		}
+
+		if (!_run) {
+			break;
+		}
+
+		Range const& r (_ranges[_next++]);
+
+		lm.release ();
+		advise (r);
+		lm.acquire ();
+
+		if (--_pending == 0) {
+			_done.signal ();
+		}
+	}
+}
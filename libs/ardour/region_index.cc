@@ -0,0 +1,427 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "ardour/region.h"
+#include "ardour/region_index.h"
+
+using namespace ARDOUR;
+using namespace Temporal;
+
+RegionIndex::RegionIndex ()
+	: _seq (0)
+{
+}
+
+RegionIndex::~RegionIndex ()
+{
+	clear ();
+}
+
+void
+RegionIndex::clear ()
+{
+	for (auto& n : _nodes) {
+		delete n.second;
+	}
+	_nodes.clear ();
+	_unindexed.clear ();
+
+	for (auto& t : _trees) {
+		t.root = 0;
+		t.by_last.clear ();
+	}
+}
+
+int64_t
+RegionIndex::key (timepos_t const& pos, int tree)
+{
+	if (tree == AudioTree) {
+		return pos.superclocks ();
+	}
+	return pos.beats ().to_ticks ();
+}
+
+void
+RegionIndex::add (std::shared_ptr<Region> const& r)
+{
+	if (_nodes.find (r.get ()) != _nodes.end ()) {
+		update (r);
+		return;
+	}
+
+	Node* n   = new Node;
+	n->region = r;
+	n->seq    = _seq++;
+	n->prio   = _rand ();
+
+	_nodes[r.get ()] = n;
+	insert (n);
+}
+
+void
+RegionIndex::remove (std::shared_ptr<Region> const& r)
+{
+	auto i = _nodes.find (r.get ());
+	if (i == _nodes.end ()) {
+		return;
+	}
+
+	erase (i->second);
+	delete i->second;
+	_nodes.erase (i);
+}
+
+void
+RegionIndex::update (std::shared_ptr<Region> const& r)
+{
+	auto i = _nodes.find (r.get ());
+	if (i == _nodes.end ()) {
+		return;
+	}
+
+	/* the playlist re-inserts a moved region after all other
+	 * regions at the same position, do likewise.
+	 */
+	Node* n = i->second;
+	erase (n);
+	n->seq = _seq++;
+	insert (n);
+}
+
+void
+RegionIndex::insert (Node* n)
+{
+	timepos_t const pos (n->region->position ());
+
+	if (pos.time_domain () != n->region->length ().time_domain ()) {
+		/* the end depends on the tempo-map */
+		n->tree = -1;
+		_unindexed[n->seq] = n;
+		return;
+	}
+
+	n->tree  = pos.time_domain () == AudioTime ? AudioTree : BeatTree;
+	n->start = key (pos, n->tree);
+	n->last  = key (n->region->nt_last (), n->tree);
+
+	_trees[n->tree].insert (n);
+}
+
+void
+RegionIndex::erase (Node* n)
+{
+	if (n->tree < 0) {
+		_unindexed.erase (n->seq);
+	} else {
+		_trees[n->tree].erase (n);
+	}
+}
+
+void
+RegionIndex::pull (Node* n)
+{
+	n->max_last = n->last;
+	if (n->left) {
+		n->max_last = std::max (n->max_last, n->left->max_last);
+	}
+	if (n->right) {
+		n->max_last = std::max (n->max_last, n->right->max_last);
+	}
+}
+
+/** split t into nodes before (start, seq) and the rest */
+void
+RegionIndex::split (Node* t, int64_t start, uint64_t seq, Node*& l, Node*& r)
+{
+	if (!t) {
+		l = r = 0;
+		return;
+	}
+
+	if (t->start < start || (t->start == start && t->seq < seq)) {
+		split (t->right, start, seq, t->right, r);
+		l = t;
+	} else {
+		split (t->left, start, seq, l, t->left);
+		r = t;
+	}
+
+	pull (t);
+}
+
+RegionIndex::Node*
+RegionIndex::merge (Node* l, Node* r)
+{
+	if (!l) {
+		return r;
+	}
+	if (!r) {
+		return l;
+	}
+
+	if (l->prio > r->prio) {
+		l->right = merge (l->right, r);
+		pull (l);
+		return l;
+	}
+
+	r->left = merge (l, r->left);
+	pull (r);
+	return r;
+}
+
+void
+RegionIndex::Tree::insert (Node* n)
+{
+	Node* l;
+	Node* r;
+
+	n->left     = 0;
+	n->right    = 0;
+	n->max_last = n->last;
+
+	split (root, n->start, n->seq, l, r);
+	root = merge (merge (l, n), r);
+
+	n->by_last = by_last.insert (std::make_pair (n->last, n));
+}
+
+void
+RegionIndex::Tree::erase (Node* n)
+{
+	Node* l;
+	Node* m;
+	Node* r;
+
+	split (root, n->start, n->seq, l, m);
+	split (m, n->start, n->seq + 1, m, r);
+	assert (m == n);
+	root = merge (l, r);
+
+	by_last.erase (n->by_last);
+}
+
+void
+RegionIndex::Tree::touched (Node* t, int64_t start, int64_t end, std::vector<Node const*>& rv) const
+{
+	if (!t || t->max_last < start) {
+		/* no region in this subtree reaches start */
+		return;
+	}
+
+	touched (t->left, start, end, rv);
+
+	if (t->start > end) {
+		/* this and all regions in the right subtree begin after end */
+		return;
+	}
+
+	if (t->last >= start) {
+		rv.push_back (t);
+	}
+
+	touched (t->right, start, end, rv);
+}
+
+void
+RegionIndex::Tree::starting_within (Node* t, int64_t start, int64_t end, std::vector<Node const*>& rv) const
+{
+	if (!t) {
+		return;
+	}
+	if (t->start >= start) {
+		starting_within (t->left, start, end, rv);
+	}
+	if (t->start >= start && t->start <= end) {
+		rv.push_back (t);
+	}
+	if (t->start <= end) {
+		starting_within (t->right, start, end, rv);
+	}
+}
+
+/** @return the first node at or after (start, seq) */
+RegionIndex::Node const*
+RegionIndex::Tree::ceil (int64_t start, uint64_t seq) const
+{
+	Node const* rv = 0;
+	for (Node const* t = root; t;) {
+		if (t->start > start || (t->start == start && t->seq >= seq)) {
+			rv = t;
+			t  = t->left;
+		} else {
+			t = t->right;
+		}
+	}
+	return rv;
+}
+
+/** @return the last node before (start, seq) */
+RegionIndex::Node const*
+RegionIndex::Tree::floor_below (int64_t start, uint64_t seq) const
+{
+	Node const* rv = 0;
+	for (Node const* t = root; t;) {
+		if (t->start < start || (t->start == start && t->seq < seq)) {
+			rv = t;
+			t  = t->right;
+		} else {
+			t = t->left;
+		}
+	}
+	return rv;
+}
+
+void
+RegionIndex::result (std::vector<Node const*>& nodes, Result& rv) const
+{
+	std::sort (nodes.begin (), nodes.end (), [] (Node const* a, Node const* b) {
+		if (a->tree >= 0 && a->tree == b->tree) {
+			return a->start < b->start || (a->start == b->start && a->seq < b->seq);
+		}
+		timepos_t const pa (a->region->position ());
+		timepos_t const pb (b->region->position ());
+		return pa < pb || (pa == pb && a->seq < b->seq);
+	});
+
+	rv.reserve (rv.size () + nodes.size ());
+	for (auto const& n : nodes) {
+		rv.push_back (n->region);
+	}
+}
+
+/* Query ranges are converted to the key of each tree using the tempo-map
+ * of the calling thread, and widened by one to allow for rounding.
+ */
+
+void
+RegionIndex::touched (timepos_t const& start, timepos_t const& end, Result& rv) const
+{
+	std::vector<Node const*> nodes;
+
+	for (int i = 0; i < 2; ++i) {
+		Tree const& t (_trees[i]);
+		if (t.root) {
+			t.touched (t.root, key (start, i) - 1, key (end, i) + 1, nodes);
+		}
+	}
+	for (auto const& n : _unindexed) {
+		nodes.push_back (n.second);
+	}
+
+	result (nodes, rv);
+}
+
+void
+RegionIndex::starting_within (timepos_t const& start, timepos_t const& end, Result& rv) const
+{
+	std::vector<Node const*> nodes;
+
+	for (int i = 0; i < 2; ++i) {
+		Tree const& t (_trees[i]);
+		if (t.root) {
+			t.starting_within (t.root, key (start, i) - 1, key (end, i) + 1, nodes);
+		}
+	}
+	for (auto const& n : _unindexed) {
+		nodes.push_back (n.second);
+	}
+
+	result (nodes, rv);
+}
+
+void
+RegionIndex::ending_within (timepos_t const& start, timepos_t const& end, Result& rv) const
+{
+	std::vector<Node const*> nodes;
+
+	for (int i = 0; i < 2; ++i) {
+		Tree const& t (_trees[i]);
+		if (t.by_last.empty ()) {
+			continue;
+		}
+		int64_t const e = key (end, i) + 1;
+		for (auto n = t.by_last.lower_bound (key (start, i) - 1); n != t.by_last.end () && n->first <= e; ++n) {
+			nodes.push_back (n->second);
+		}
+	}
+	for (auto const& n : _unindexed) {
+		nodes.push_back (n.second);
+	}
+
+	result (nodes, rv);
+}
+
+RegionIndex::Node const*
+RegionIndex::next_start (Tree const& t, int tree, timepos_t const& pos, int dir) const
+{
+	int64_t const k = key (pos, tree);
+
+	if (dir > 0) {
+		for (Node const* n = t.ceil (k - 1, 0); n; n = t.ceil (n->start, n->seq + 1)) {
+			if (n->region->position () > pos) {
+				return n;
+			}
+		}
+	} else {
+		for (Node const* n = t.floor_below (k + 2, 0); n; n = t.floor_below (n->start, n->seq)) {
+			if (n->region->position () < pos) {
+				/* of all regions at this position, use the first one */
+				return t.ceil (n->start, 0);
+			}
+		}
+	}
+	return 0;
+}
+
+std::shared_ptr<Region>
+RegionIndex::next_start (timepos_t const& pos, int dir) const
+{
+	std::vector<Node const*> nodes;
+
+	for (int i = 0; i < 2; ++i) {
+		Node const* n = next_start (_trees[i], i, pos, dir);
+		if (n) {
+			nodes.push_back (n);
+		}
+	}
+	for (auto const& n : _unindexed) {
+		timepos_t const p (n.second->region->position ());
+		if (dir > 0 ? p > pos : p < pos) {
+			nodes.push_back (n.second);
+		}
+	}
+
+	Node const* rv = 0;
+	for (auto const& n : nodes) {
+		if (!rv) {
+			rv = n;
+			continue;
+		}
+		timepos_t const p (n->region->position ());
+		timepos_t const b (rv->region->position ());
+		if ((dir > 0 ? p < b : p > b) || (p == b && n->seq < rv->seq)) {
+			rv = n;
+		}
+	}
+
+	return rv ? rv->region : std::shared_ptr<Region> ();
+}
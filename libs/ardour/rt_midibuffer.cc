@@ -24,6 +24,8 @@
 #include "pbd/error.h"
 #include "pbd/debug.h"
 
+#include "evoral/EventList.h"
+
 #include "ardour/debug.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/midi_state_tracker.h"
@@ -200,38 +202,44 @@ RTMidiBuffer::write (TimeType time, Evoral::EventType /*type*/, uint32_t size, c
 		}
 	}
 
-	_data[_size].timestamp = time;
+	set_item (_data[_size], time, size, buf);
+
+	++_size;
+
+	return size;
+}
+
+void
+RTMidiBuffer::set_item (Item& item, TimeType time, uint32_t size, const uint8_t* buf)
+{
+	item.timestamp = time;
 
 	if (size > 3) {
 
 		uint32_t off = store_blob (size, buf);
 
 		/* non-zero MSbit indicates that the data (more than 3 bytes) is not inline */
-		_data[_size].offset = (off | (1<<(CHAR_BIT-1)));
+		item.offset = (off | (1<<(CHAR_BIT-1)));
 
 	} else {
 
 		assert ((int) size == Evoral::midi_event_size (buf[0]));
 
 		/* zero MSbit indicates that the data (up to 3 bytes) is inline */
-		_data[_size].bytes[0] = 0;
+		item.bytes[0] = 0;
 
 		switch (size) {
 		case 3:
-			_data[_size].bytes[3] = buf[2];
+			item.bytes[3] = buf[2];
 			/* fallthru */
 		case 2:
-			_data[_size].bytes[2] = buf[1];
+			item.bytes[2] = buf[1];
 			/* fallthru */
 		case 1:
-			_data[_size].bytes[1] = buf[0];
+			item.bytes[1] = buf[0];
 			break;
 		}
 	}
-
-	++_size;
-
-	return size;
 }
 
 /* requires C++20 to be usable */
@@ -251,6 +259,40 @@ item_item_earlier (ARDOUR::RTMidiBuffer::Item const & item, ARDOUR::RTMidiBuffer
 	return item.timestamp < other.timestamp;
 }
 
+void
+RTMidiBuffer::splice (samplepos_t start, samplepos_t end, Evoral::EventList<TimeType> const& events)
+{
+	Item key;
+
+	key.timestamp = start;
+	Item* first = lower_bound (_data, _data + _size, key, item_item_earlier);
+	key.timestamp = end;
+	Item* last = lower_bound (first, _data + _size, key, item_item_earlier);
+
+	const size_t pos      = first - _data;
+	const size_t tail     = (_data + _size) - last;
+	const size_t removed  = last - first;
+	const size_t added    = events.size ();
+	const size_t new_size = _size - removed + added;
+
+	if (new_size >= _capacity) {
+		resize (new_size + 1024);
+	}
+
+	if (added != removed && tail) {
+		memmove (&_data[pos + added], &_data[pos + removed], tail * sizeof (Item));
+	}
+
+	size_t n = pos;
+
+	for (Evoral::EventList<TimeType>::const_iterator e = events.begin (); e != events.end (); ++e, ++n) {
+		assert ((*e)->time () >= start && (*e)->time () < end);
+		set_item (_data[n], (*e)->time (), (*e)->size (), (*e)->buffer ());
+	}
+
+	_size = new_size;
+}
+
 void
 RTMidiBuffer::track (MidiStateTracker& mst, samplepos_t start, samplepos_t end)
 {
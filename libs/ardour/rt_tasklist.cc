@@ -33,6 +33,12 @@ RTTaskList::push_back (boost::function<void ()> fn)
 	_tasks.push_back (RTTask (_graph.get(), fn));
 }
 
+uint32_t
+RTTaskList::n_threads () const
+{
+	return _graph->n_threads ();
+}
+
 void
 RTTaskList::process ()
 {
@@ -329,6 +329,7 @@ Session::Session (AudioEngine &eng,
 	, have_looped (false)
 	, _step_editors (0)
 	,  _speakers (new Speakers)
+	, _graph_dirty_all (false)
 	, _ignore_route_processor_changes (0)
 	, _ignored_a_processor_change (0)
 	, midi_clock (0)
@@ -2556,8 +2557,17 @@ Session::rechain_process_graph (GraphNodeList& g)
 	 * Or it may be called from the engine when connections are changed.
 	 * In that case processing is blocked until the graph change is handled.
 	 */
-	GraphEdges edges;
-	if (topological_sort (g, edges)) {
+	std::set<GraphVertex> dirty;
+	GraphEdges            edges;
+
+	/* Start from the current graph, and only re-evaluate edges of
+	 * nodes that were added or whose connections changed.
+	 */
+	if (!collect_dirty_graph_nodes (g, dirty)) {
+		edges = _current_route_graph;
+	}
+
+	if (topological_sort (g, edges, dirty)) {
 		/* We got a satisfactory topological sort, so there is no feedback;
 		 * use this new graph.
 		 *
@@ -2565,6 +2575,13 @@ Session::rechain_process_graph (GraphNodeList& g)
 		 * topologically-sorted list, but hey ho.
 		 */
 		if (_process_graph->n_threads () > 1) {
+			if (_graph_chain && _graph_chain->_nodes_rt == g && edges.same_edges (_current_route_graph)) {
+				/* nothing changed that is relevant for the chain,
+				 * e.g. a connection to a physical port.
+				 */
+				_current_route_graph = edges;
+				return true;
+			}
 			/* Ideally we'd use a memory pool to allocate the GraphChain, however node_lists
 			 * inside the change are STL list/set. It was never rt-safe to re-chain the graph.
 			 * Furthermore graph-changes are usually caused by connection changes, which are not
@@ -2583,6 +2600,126 @@ Session::rechain_process_graph (GraphNodeList& g)
 		return true;
 	}
 
+	/* the changes are still pending, retry with a complete sort next time */
+	Glib::Threads::Mutex::Lock lm (_graph_dirty_lock);
+	_graph_dirty_all = true;
+
+	return false;
+}
+
+/** Called by the backend, for every connection change */
+void
+Session::graph_port_connection_changed (std::weak_ptr<Port> wa, std::string const& a, std::weak_ptr<Port> wb, std::string const& b)
+{
+	GraphPortChange pa;
+	GraphPortChange pb;
+
+	pa.port = wa;
+	pa.ours = _engine.port_is_mine (a);
+	pb.port = wb;
+	pb.ours = _engine.port_is_mine (b);
+
+	if (!pa.ours && !pb.ours) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_graph_dirty_lock);
+	_graph_dirty_ports.push_back (std::make_pair (pa, pb));
+}
+
+/** Find nodes of \a g whose edges may have changed since the last sort.
+ *  @return true if the graph needs to be rebuilt from scratch.
+ */
+bool
+Session::collect_dirty_graph_nodes (GraphNodeList const& g, std::set<GraphVertex>& dirty)
+{
+	bool                                                      all;
+	std::vector<std::weak_ptr<Route> >                        routes;
+	std::vector<std::pair<GraphPortChange, GraphPortChange> > ports;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_graph_dirty_lock);
+		all = _graph_dirty_all;
+		_graph_dirty_all = false;
+		routes.swap (_graph_dirty_routes);
+		ports.swap (_graph_dirty_ports);
+	}
+
+	if (all || ports.size () > g.size ()) {
+		/* mapping ports to nodes is no cheaper than a complete sort */
+		return true;
+	}
+
+	for (auto const& wr : routes) {
+		std::shared_ptr<Route> r (wr.lock ());
+		if (r) {
+			dirty.insert (r);
+		}
+	}
+
+	if (ports.empty ()) {
+		return false;
+	}
+
+	/* map ports to the routes that own them, including ports of
+	 * sends, inserts and sidechains.
+	 */
+	std::map<std::shared_ptr<Port>, GraphVertex> owner;
+	for (auto const& p : ports) {
+		std::shared_ptr<Port> a (p.first.port.lock ());
+		std::shared_ptr<Port> b (p.second.port.lock ());
+		if (a) {
+			owner[a] = GraphVertex ();
+		}
+		if (b) {
+			owner[b] = GraphVertex ();
+		}
+	}
+
+	for (auto const& n : g) {
+		std::shared_ptr<Route> r (std::dynamic_pointer_cast<Route> (n));
+		if (!r) {
+			continue;
+		}
+		IOVector ios (r->all_inputs ());
+		IOVector const outs (r->all_outputs ());
+		ios.insert (ios.end (), outs.begin (), outs.end ());
+
+		for (auto& o : owner) {
+			if (o.second) {
+				continue;
+			}
+			for (auto const& io : ios) {
+				if (io && io->has_port (o.first)) {
+					o.second = n;
+					break;
+				}
+			}
+		}
+	}
+
+	for (auto const& p : ports) {
+		std::shared_ptr<Port> a (p.first.port.lock ());
+		std::shared_ptr<Port> b (p.second.port.lock ());
+		GraphVertex na = a ? owner[a] : GraphVertex ();
+		GraphVertex nb = b ? owner[b] : GraphVertex ();
+
+		if (na) {
+			dirty.insert (na);
+		}
+		if (nb) {
+			dirty.insert (nb);
+		}
+
+		/* One of our ports was removed, and the other end does not
+		 * belong to a route either. The edge that was removed cannot
+		 * be found this way.
+		 */
+		if (!na && !nb && ((p.first.ours && !a) || (p.second.ours && !b))) {
+			return true;
+		}
+	}
+
 	return false;
 }
 
@@ -3527,7 +3664,7 @@ Session::add_routes_inner (RouteList& new_routes, bool input_auto_connect, bool
 			r->solo_isolate_control()->Changed.connect_same_thread (*this, boost::bind (&Session::route_solo_isolated_changed, this, wpr));
 			r->mute_control()->Changed.connect_same_thread (*this, boost::bind (&Session::route_mute_changed, this));
 
-			r->processors_changed.connect_same_thread (*this, boost::bind (&Session::route_processors_changed, this, _1));
+			r->processors_changed.connect_same_thread (*this, boost::bind (&Session::route_processors_changed, this, _1, wpr));
 			r->processor_latency_changed.connect_same_thread (*this, boost::bind (&Session::queue_latency_recompute, this));
 
 			if (r->is_master()) {
@@ -6614,6 +6751,19 @@ Session::plot_process_graph (std::string const& file_name) const {
 	return _graph_chain ? _graph_chain->plot (file_name) : false;
 }
 
+/** Scheduler statistics of the most recent process cycle.
+ * @return true if the cycle used the work-stealing scheduler
+ */
+bool
+Session::process_graph_stats (uint32_t& steals, uint32_t& idle_wakeups, uint32_t& max_queue_depth) const
+{
+	Graph::CycleStats s (_process_graph->cycle_stats ());
+	steals          = s.steals;
+	idle_wakeups    = s.idle_wakeups;
+	max_queue_depth = s.max_queue_depth;
+	return s.work_stealing;
+}
+
 void
 Session::add_automation_list(AutomationList *al)
 {
@@ -8006,7 +8156,7 @@ Session::apply_nth_mixer_scene (size_t nth)
 	assert (scene);
 
 	_last_touched_mixer_scene_idx = nth;
-	return scene->apply ();
+	return recall_mixer_scene (scene, std::shared_ptr<ControllableSet const> ());
 }
 
 bool
@@ -8025,13 +8175,108 @@ Session::apply_nth_mixer_scene (size_t nth, RouteList const& rl)
 	}
 	assert (scene);
 
-	ControllableSet acs;
+	std::shared_ptr<ControllableSet> acs (new ControllableSet);
 	for (auto const& r : rl) {
-		r->automatables (acs);
+		r->automatables (*acs);
 	}
 
 	_last_touched_mixer_scene_idx = nth;
-	return scene->apply (acs);
+	return recall_mixer_scene (scene, acs);
+}
+
+/* setting a value emits signals, limit the work done in a single cycle */
+static const size_t mixer_scene_values_per_cycle = 64;
+
+struct Session::MixerSceneRecall {
+	MixerSceneRecall (MixerScene::ControllableValueMap const& v, std::shared_ptr<ControllableSet const> c, PBD::EventLoop* el)
+		: scene_values (v), controls (c), event_loop (el), applied (0) {}
+
+	MixerScene::ControllableValueMap       scene_values;
+	std::shared_ptr<ControllableSet const> controls; // all registered controllables if null
+	PBD::EventLoop*                        event_loop;
+	MixerScene::StagedValues               values;
+	size_t                                 applied;
+	std::vector<SessionEvent*>             events; // one per cycle, not yet queued
+};
+
+bool
+Session::recall_mixer_scene (std::shared_ptr<MixerScene> scene, std::shared_ptr<ControllableSet const> acs)
+{
+	PBD::EventLoop* event_loop = PBD::EventLoop::get_event_loop_for_thread ();
+
+	if (!event_loop) {
+		/* no way to clean up the rt event, apply directly */
+		return acs ? scene->apply (*acs) : scene->apply ();
+	}
+
+	/* The scene may be modified (snapshot, clear) while the recall
+	 * is in progress, the butler only uses this copy.
+	 */
+	MixerScene::ControllableValueMap values (scene->values ());
+
+	if (!MixerScene::has_values (values, acs ? *acs : Controllable::registered_controllables ())) {
+		return false;
+	}
+
+	std::shared_ptr<MixerSceneRecall> msr (new MixerSceneRecall (values, acs, event_loop));
+
+	/* Controls are looked up by the butler, which then queues the
+	 * first rt event. Values are set at the start of a cycle, without
+	 * blocking the GUI while doing so.
+	 */
+	if (!_butler->delegate (boost::bind (&Session::stage_mixer_scene, this, msr))) {
+		stage_mixer_scene (msr);
+	}
+
+	MixerScene::Change (); /* EMIT SIGNAL */
+	return true;
+}
+
+void
+Session::stage_mixer_scene (std::shared_ptr<MixerSceneRecall> msr)
+{
+	MixerScene::stage (msr->scene_values, msr->values, msr->controls ? *msr->controls : Controllable::registered_controllables ());
+
+	if (msr->values.empty ()) {
+		return;
+	}
+
+	/* Allocate all events here, the process thread only queues the next one */
+	size_t const n_events = (msr->values.size () + mixer_scene_values_per_cycle - 1) / mixer_scene_values_per_cycle;
+
+	for (size_t n = 0; n < n_events; ++n) {
+		SessionEvent* ev = new SessionEvent (SessionEvent::RealTimeOperation, SessionEvent::Add, SessionEvent::Immediate, 0, 0.0);
+		ev->rt_slot    = boost::bind (&Session::rt_apply_mixer_scene, this, msr);
+		ev->rt_return  = Session::rt_cleanup;
+		ev->event_loop = msr->event_loop;
+		msr->events.push_back (ev);
+	}
+
+	std::reverse (msr->events.begin (), msr->events.end ());
+
+	SessionEvent* ev = msr->events.back ();
+	msr->events.pop_back ();
+	queue_event (ev);
+}
+
+void
+Session::rt_apply_mixer_scene (std::shared_ptr<MixerSceneRecall> msr)
+{
+	size_t const n = std::min (msr->values.size () - msr->applied, mixer_scene_values_per_cycle);
+
+	if (MixerScene::apply_staged (msr->values, msr->applied, n)) {
+		/* solo controls were set directly, not via rt_set_controls () */
+		update_route_solo_state ();
+	}
+
+	msr->applied += n;
+
+	if (!msr->events.empty ()) {
+		/* continue in the next cycle */
+		SessionEvent* ev = msr->events.back ();
+		msr->events.pop_back ();
+		queue_event (ev);
+	}
 }
 
 void
@@ -270,6 +270,7 @@ Session::post_engine_init ()
 		/* crossfades require sample rate knowledge */
 
 		_engine.GraphReordered.connect_same_thread (*this, boost::bind (&Session::graph_reordered, this, true));
+		_engine.PortConnectedOrDisconnected.connect_same_thread (*this, boost::bind (&Session::graph_port_connection_changed, this, _1, _2, _3, _4));
 		_engine.MidiSelectionPortsChanged.connect_same_thread (*this, boost::bind (&Session::rewire_midi_selection_ports, this));
 
 		DiskReader::allocate_working_buffers();
@@ -557,6 +558,13 @@ Session::ensure_subdirs ()
 		return -1;
 	}
 
+	dir = cache_dir ();
+
+	if (g_mkdir_with_parents (dir.c_str(), 0755) < 0) {
+		error << string_compose(_("Session: cannot create session cache folder \"%1\" (%2)"), dir, strerror (errno)) << endmsg;
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -3143,6 +3151,12 @@ Session::externals_dir () const
 	return Glib::build_filename (_path, externals_dir_name);
 }
 
+string
+Session::cache_dir () const
+{
+	return Glib::build_filename (_path, cache_dir_name);
+}
+
 int
 Session::load_bundles (XMLNode const & node)
 {
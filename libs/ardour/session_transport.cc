@@ -57,6 +57,7 @@
 #include "ardour/location.h"
 #include "ardour/playlist.h"
 #include "ardour/profile.h"
+#include "ardour/read_ahead.h"
 #include "ardour/scene_changer.h"
 #include "ardour/session.h"
 #include "ardour/tempo.h"
@@ -1283,6 +1284,17 @@ Session::non_realtime_locate ()
 		tf = _transport_sample;
 		start = get_microseconds ();
 
+		if (ReadAhead* ra = _butler->read_ahead ()) {
+			/* queue the reads of all tracks, before they seek one by one */
+			for (auto const& i : *rl) {
+				std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (i);
+				if (tr) {
+					tr->read_ahead (*ra, tf);
+				}
+			}
+			ra->commit ();
+		}
+
 		for (auto const& i : *rl) {
 			++nt;
 			i->non_realtime_locate (tf);
@@ -1901,8 +1913,19 @@ Session::reset_xrun_count ()
 }
 
 void
-Session::route_processors_changed (RouteProcessorChange c)
+Session::route_processors_changed (RouteProcessorChange c, std::weak_ptr<Route> wr)
 {
+	std::shared_ptr<Route> r (wr.lock ());
+
+	if (r && c.type != RouteProcessorChange::MeterPointChange && c.type != RouteProcessorChange::RealTimeChange) {
+		/* sends or inserts may have been added or removed,
+		 * re-evaluate the edges of this route with the next resort.
+		 * This is done even if the change is ignored for now.
+		 */
+		Glib::Threads::Mutex::Lock lm (_graph_dirty_lock);
+		_graph_dirty_routes.push_back (r);
+	}
+
 	if (_ignore_route_processor_changes.load () > 0) {
 		(void) _ignored_a_processor_change.fetch_or (c.type);
 		return;
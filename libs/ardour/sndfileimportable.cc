@@ -145,3 +145,14 @@ SndFileImportableSource::clamped_at_unity () const
 	/* XXX: this may not be the full list of formats that are unclamped */
 	return (sub != SF_FORMAT_FLOAT && sub != SF_FORMAT_DOUBLE && type != SF_FORMAT_OGG);
 }
+
+bool
+SndFileImportableSource::get_signal_max (float& peak) const
+{
+	double max = 0;
+	if (sf_command (in.get(), SFC_GET_SIGNAL_MAX, &max, sizeof (max)) != SF_TRUE) {
+		return false;
+	}
+	peak = max;
+	return true;
+}
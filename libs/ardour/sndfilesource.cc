@@ -26,14 +26,24 @@
 #include "libardour-config.h"
 #endif
 
+#include <atomic>
 #include <cstring>
 #include <cerrno>
 #include <climits>
 #include <cstdarg>
 #include <fcntl.h>
+#include <list>
+#include <map>
+#include <set>
+#include <memory>
+#include <vector>
 
 #include <sys/stat.h>
 
+#if defined __linux__ || defined __APPLE__
+#include <unistd.h>
+#endif
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 #include "pbd/progress.h"
@@ -47,7 +57,10 @@
 #include <glibmm/convert.h>
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
+#include <glibmm/threads.h>
 
+#include "ardour/rc_configuration.h"
+#include "ardour/read_ahead.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -61,6 +74,258 @@ using namespace ARDOUR;
 using namespace PBD;
 using std::string;
 
+namespace ARDOUR {
+
+/** Cache of interleaved sample data read from a multi-channel file.
+ *
+ * Every channel of a multi-channel file is a separate SndFileSource,
+ * and each of them has to read (and decode) all channels to extract its
+ * own. Blocks read by one channel are kept here, so that the sibling
+ * channels only have to de-interleave the data.
+ *
+ * There is one cache for each file, shared by all sources of that file,
+ * with its own lock. It is dropped when the last of them goes away.
+ *
+ * Memory is bounded in bytes, regardless of the number of channels:
+ * each file holds at most max_file_bytes, and all files together at
+ * most max_total_bytes. When the total is used up, blocks of the least
+ * recently used file are dropped.
+ */
+class SndFileBlockCache
+{
+public:
+	static const samplecnt_t block_size = 8192; // per channel
+
+	struct Block {
+		Block () : frames (-1) {}
+
+		Glib::Threads::Mutex lock;
+		samplecnt_t          frames; ///< valid frames, -1 if not yet read
+		std::vector<Sample>  data;
+	};
+
+	typedef std::shared_ptr<Block> BlockPtr;
+
+	~SndFileBlockCache ()
+	{
+		_total_bytes.fetch_sub (_bytes.load ());
+	}
+
+	/** @return the cache of the file at \p path, to be returned by calling release () */
+	static std::shared_ptr<SndFileBlockCache>
+	acquire (std::string const& path, uint32_t channels)
+	{
+		Glib::Threads::Mutex::Lock lm (_registry_lock);
+
+		std::shared_ptr<SndFileBlockCache>& c (_registry[path]);
+		if (!c) {
+			c.reset (new SndFileBlockCache (channels));
+		}
+		c->_users.fetch_add (1);
+		return c;
+	}
+
+	static void
+	release (std::shared_ptr<SndFileBlockCache>& c, std::string const& path)
+	{
+		Glib::Threads::Mutex::Lock lm (_registry_lock);
+
+		if (c->_users.fetch_sub (1) == 1) {
+			Registry::iterator i = _registry.find (path);
+			if (i != _registry.end () && i->second == c) {
+				_registry.erase (i);
+			}
+		}
+		c.reset ();
+	}
+
+	/** @return the given block, creating an empty one if needed.
+	 * If there is no room, the returned block is not cached.
+	 */
+	BlockPtr
+	get (samplepos_t block)
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		_last_use.store (_clock.fetch_add (1));
+
+		BlockMap::iterator i = _blocks.find (block);
+
+		if (i != _blocks.end ()) {
+			_lru.splice (_lru.begin (), _lru, i->second);
+			return i->second->second;
+		}
+
+		BlockPtr b (new Block);
+
+		if (!make_room ()) {
+			return b;
+		}
+
+		_lru.push_front (std::make_pair (block, b));
+		_blocks[block] = _lru.begin ();
+		_bytes.fetch_add (_block_bytes);
+		_total_bytes.fetch_add (_block_bytes);
+
+		return b;
+	}
+
+private:
+	SndFileBlockCache (uint32_t channels)
+		: _block_bytes (block_size * channels * sizeof (Sample))
+		, _max_blocks (std::max<size_t> (2, max_file_bytes / _block_bytes))
+		, _users (0)
+		, _bytes (0)
+		, _last_use (0)
+	{}
+
+	static const size_t max_file_bytes  = 16 * 1048576;
+	static const size_t max_total_bytes = 256 * 1048576;
+
+	/* Evict the least recently used block. Readers that still
+	 * hold a block keep it alive until they're done with it.
+	 * Called with _lock held.
+	 */
+	void
+	evict_one ()
+	{
+		_blocks.erase (_lru.back ().first);
+		_lru.pop_back ();
+		_bytes.fetch_sub (_block_bytes);
+		_total_bytes.fetch_sub (_block_bytes);
+	}
+
+	bool
+	over_budget () const
+	{
+		return _total_bytes.load () + _block_bytes > max_total_bytes;
+	}
+
+	/** make room for one more block. Called with _lock held.
+	 * @return false if there is no room
+	 */
+	bool
+	make_room ()
+	{
+		while (!_lru.empty () && _lru.size () >= _max_blocks) {
+			evict_one ();
+		}
+
+		if (!over_budget ()) {
+			return true;
+		}
+
+		{
+			/* drop the blocks of the least recently used other files.
+			 * Caches are not locked in a given order, so skip busy ones.
+			 */
+			Glib::Threads::Mutex::Lock lm (_registry_lock);
+
+			std::set<SndFileBlockCache*> busy;
+
+			while (over_budget ()) {
+				SndFileBlockCache* victim = 0;
+
+				for (auto const& r : _registry) {
+					SndFileBlockCache* c = r.second.get ();
+					if (c == this || c->_bytes.load () == 0 || busy.find (c) != busy.end ()) {
+						continue;
+					}
+					if (!victim || c->_last_use.load () < victim->_last_use.load ()) {
+						victim = c;
+					}
+				}
+
+				if (!victim) {
+					break;
+				}
+
+				Glib::Threads::Mutex::Lock vl (victim->_lock, Glib::Threads::TRY_LOCK);
+				if (!vl.locked ()) {
+					busy.insert (victim);
+					continue;
+				}
+				while (!victim->_lru.empty ()) {
+					victim->evict_one ();
+				}
+			}
+		}
+
+		while (!_lru.empty () && over_budget ()) {
+			evict_one ();
+		}
+
+		return !over_budget ();
+	}
+
+	typedef std::list<std::pair<samplepos_t, BlockPtr> > LRUList;
+	typedef std::map<samplepos_t, LRUList::iterator>     BlockMap;
+
+	size_t const          _block_bytes;
+	size_t const          _max_blocks;
+	Glib::Threads::Mutex  _lock;
+	LRUList               _lru;
+	BlockMap              _blocks;
+	std::atomic<size_t>   _users;
+	std::atomic<size_t>   _bytes;
+	std::atomic<uint64_t> _last_use;
+
+	typedef std::map<std::string, std::shared_ptr<SndFileBlockCache> > Registry;
+
+	static Glib::Threads::Mutex  _registry_lock;
+	static Registry              _registry;
+	static std::atomic<size_t>   _total_bytes;
+	static std::atomic<uint64_t> _clock;
+};
+
+Glib::Threads::Mutex        SndFileBlockCache::_registry_lock;
+SndFileBlockCache::Registry SndFileBlockCache::_registry;
+std::atomic<size_t>         SndFileBlockCache::_total_bytes (0);
+std::atomic<uint64_t>       SndFileBlockCache::_clock (0);
+
+}
+
+namespace {
+
+/** Return the size of a sample in bytes, if the file is uncompressed
+ * and the position of a sample in the file can be calculated, otherwise 0.
+ */
+int
+uncompressed_sample_size (int format)
+{
+	switch (format & SF_FORMAT_TYPEMASK) {
+	case SF_FORMAT_WAV:
+	case SF_FORMAT_WAVEX:
+	case SF_FORMAT_AIFF:
+	case SF_FORMAT_CAF:
+	case SF_FORMAT_W64:
+	case SF_FORMAT_RF64:
+	case SF_FORMAT_RAW:
+		break;
+	default:
+		return 0;
+	}
+
+	switch (format & SF_FORMAT_SUBMASK) {
+	case SF_FORMAT_PCM_S8:
+	case SF_FORMAT_PCM_U8:
+		return 1;
+	case SF_FORMAT_PCM_16:
+		return 2;
+	case SF_FORMAT_PCM_24:
+		return 3;
+	case SF_FORMAT_PCM_32:
+	case SF_FORMAT_FLOAT:
+		return 4;
+	case SF_FORMAT_DOUBLE:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+}
+
 const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::Writable |
 		Source::Removable |
@@ -340,6 +605,13 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd                = -1;
+	_write_behind      = false;
+	_write_behind_prev = 0;
+	_write_behind_pos  = 0;
+	_data_offset       = -1;
+	_file_id           = 0;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, boost::bind (&SndFileSource::handle_header_position_change, this));
 }
 
@@ -349,6 +621,7 @@ SndFileSource::close ()
 	if (_sndfile) {
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_fd = -1;
 		file_closed ();
 	}
 }
@@ -389,18 +662,40 @@ SndFileSource::open ()
 		return -1;
 	}
 
+	/* libsndfile closes the descriptor with the file */
+	_fd                = fd;
+	_write_behind_prev = 0;
+	_write_behind_pos  = 0;
+	_data_offset       = -1;
+
 	if (_channel >= _info.channels) {
 #ifndef HAVE_COREAUDIO
 		error << string_compose(_("SndFileSource: file only contains %1 channels; %2 is invalid as a channel number"), _info.channels, _channel) << endmsg;
 #endif
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_fd = -1;
 		return -1;
 	}
 
 
 	_length = timecnt_t (_info.frames);
 
+	if (!_block_cache && _info.channels > 1 && !writable () && Config->get_multichannel_read_cache ()) {
+		_block_cache = SndFileBlockCache::acquire (_path, _info.channels);
+	}
+
+#if defined __linux__ || defined __APPLE__
+	/* libsndfile seeks to the start of the audio data */
+	if (!writable () && uncompressed_sample_size (_info.format) > 0 && sf_seek (_sndfile, 0, SEEK_SET) == 0) {
+		struct stat st;
+		if (fstat (fd, &st) == 0) {
+			_data_offset = lseek (fd, 0, SEEK_CUR);
+			_file_id     = st.st_ino;
+		}
+	}
+#endif
+
 #ifdef HAVE_RF64_RIFF
 	if (_file_is_new && _length == 0 && writable()) {
 		if (_flags & RF64_RIFF) {
@@ -492,6 +787,9 @@ SndFileSource::open ()
 SndFileSource::~SndFileSource ()
 {
 	close ();
+	if (_block_cache) {
+		SndFileBlockCache::release (_block_cache, _path);
+	}
 	delete _broadcast_info;
 }
 
@@ -507,7 +805,6 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	assert (cnt >= 0);
 
 	samplecnt_t nread;
-	float *ptr;
 	samplecnt_t real_cnt;
 	samplepos_t file_cnt;
 
@@ -550,6 +847,11 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 
 	if (file_cnt) {
 
+		if (_block_cache && !writable ()) {
+			/* de-interleave from data shared with the other channels of this file */
+			return read_cached (dst, start, file_cnt);
+		}
+
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
 			char errbuf[256];
 			sf_error_str (0, errbuf, sizeof (errbuf) - 1);
@@ -578,20 +880,83 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	Sample* interleave_buf = get_interleave_buffer (real_cnt);
 
 	nread = sf_read_float (_sndfile, interleave_buf, real_cnt);
-	ptr = interleave_buf + _channel;
 	nread /= _info.channels;
 
-	/* stride through the interleaved data */
+	/* pick our channel from the interleaved data */
+
+	deinterleave (dst, interleave_buf, nread, _channel, _info.channels);
 
 	if (_gain != 1.f) {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr * _gain;
-			ptr += _info.channels;
+		apply_gain_to_buffer (dst, nread, _gain);
+	}
+
+	return nread;
+}
+
+samplecnt_t
+SndFileSource::read_cached (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	samplecnt_t const bs    = SndFileBlockCache::block_size;
+	int const         nchn  = _info.channels;
+	samplecnt_t       nread = 0;
+
+	while (nread < cnt) {
+		samplepos_t const pos    = start + nread;
+		samplepos_t const block  = pos / bs;
+		samplecnt_t const offset = pos - block * bs;
+
+		SndFileBlockCache::BlockPtr b = _block_cache->get (block);
+		Glib::Threads::Mutex::Lock lm (b->lock);
+
+		bool keep = true;
+
+		if (b->frames < 0) {
+			/* first channel to get here reads the block */
+			sf_count_t const bstart = block * bs;
+
+			if (sf_seek (_sndfile, bstart, SEEK_SET|SFM_READ) != bstart) {
+				char errbuf[256];
+				sf_error_str (0, errbuf, sizeof (errbuf) - 1);
+				error << string_compose(_("SndFileSource: could not seek to sample %1 within %2 (%3)"), bstart, _name, errbuf) << endmsg;
+				return nread;
+			}
+
+			b->data.resize (bs * nchn);
+
+			sf_count_t const expected = std::min<sf_count_t> (bs, _info.frames - bstart);
+			sf_count_t const ret      = sf_readf_float (_sndfile, &b->data[0], bs);
+
+			if (ret < expected) {
+				char errbuf[256];
+				sf_error_str (0, errbuf, sizeof (errbuf) - 1);
+				error << string_compose(_("SndFileSource: @ %1 could not read %2 within %3 (%4) (len = %5, ret was %6)"), bstart, expected, _name, errbuf, _length, ret) << endl;
+				/* do not share incomplete data */
+				keep = false;
+			}
+
+			b->frames = std::max<sf_count_t> (0, ret);
 		}
-	} else {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr;
-			ptr += _info.channels;
+
+		samplecnt_t const n = std::min (cnt - nread, b->frames - offset);
+
+		if (n > 0) {
+			Sample* out = dst + nread;
+
+			deinterleave (out, &b->data[offset * nchn], n, _channel, nchn);
+
+			if (_gain != 1.f) {
+				apply_gain_to_buffer (out, n, _gain);
+			}
+			nread += n;
+		}
+
+		if (!keep) {
+			b->frames = -1;
+		}
+
+		if (n <= 0 || !keep) {
+			/* end of file, or read error */
+			break;
 		}
 	}
 
@@ -632,6 +997,10 @@ SndFileSource::nondestructive_write_unlocked (Sample *data, samplecnt_t cnt)
 	assert (_length.time_domain() == Temporal::AudioTime);
 	update_length (timepos_t (_length.samples() + cnt));
 
+	if (_write_behind) {
+		write_behind ();
+	}
+
 	if (_build_peakfiles) {
 		compute_and_write_peaks (data, sample_pos, cnt, true, true);
 	}
@@ -639,6 +1008,55 @@ SndFileSource::nondestructive_write_unlocked (Sample *data, samplecnt_t cnt)
 	return cnt;
 }
 
+void
+SndFileSource::read_ahead (ReadAhead& ra, samplepos_t start, samplecnt_t cnt) const
+{
+	if (_fd < 0 || _data_offset < 0 || start >= _length.samples ()) {
+		return;
+	}
+
+	cnt = std::min (cnt, _length.samples () - start);
+
+	off_t const frame_size = (off_t) uncompressed_sample_size (_info.format) * _info.channels;
+
+	ra.add (_fd, _file_id, _data_offset + start * frame_size, cnt * frame_size);
+}
+
+void
+SndFileSource::write_behind ()
+{
+#ifdef __linux__
+	/* Start write-back of the data written since the last call, and
+	 * drop the range before that from the page-cache once it is on disk.
+	 * This prevents dirty pages from accumulating during long takes,
+	 * which would otherwise be written back in bursts that stall
+	 * other I/O, and keeps captured data from evicting playback data.
+	 */
+	static const off_t write_behind_size = 1048576;
+
+	if (_fd < 0) {
+		return;
+	}
+
+	off_t const end = lseek (_fd, 0, SEEK_CUR);
+
+	if (end < 0 || end - _write_behind_pos < write_behind_size) {
+		return;
+	}
+
+	sync_file_range (_fd, _write_behind_pos, end - _write_behind_pos, SYNC_FILE_RANGE_WRITE);
+
+	if (_write_behind_pos > _write_behind_prev) {
+		off_t const len = _write_behind_pos - _write_behind_prev;
+		sync_file_range (_fd, _write_behind_prev, len, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+		posix_fadvise (_fd, _write_behind_prev, len, POSIX_FADV_DONTNEED);
+	}
+
+	_write_behind_prev = _write_behind_pos;
+	_write_behind_pos  = end;
+#endif
+}
+
 int
 SndFileSource::update_header (samplepos_t when, struct tm& now, time_t tnow)
 {
@@ -846,5 +1264,11 @@ SndFileSource::file_closed ()
 void
 SndFileSource::set_path (const string& p)
 {
+	if (_block_cache) {
+		SndFileBlockCache::release (_block_cache, _path);
+	}
         FileSource::set_path (p);
+	if (_sndfile && _info.channels > 1 && !writable () && Config->get_multichannel_read_cache ()) {
+		_block_cache = SndFileBlockCache::acquire (_path, _info.channels);
+	}
 }
@@ -56,6 +56,7 @@ PBD::Signal1<void, std::shared_ptr<Source>> SourceFactory::SourceCreated;
 Glib::Threads::Cond                           SourceFactory::PeaksToBuild;
 Glib::Threads::Mutex                          SourceFactory::peak_building_lock;
 std::list<std::weak_ptr<AudioSource>>       SourceFactory::files_with_peaks;
+std::list<std::weak_ptr<AudioSource>>       SourceFactory::files_with_peak_mips;
 std::vector<PBD::Thread*>                     SourceFactory::peak_thread_pool;
 bool                                          SourceFactory::peak_thread_run = false;
 
@@ -71,7 +72,7 @@ peak_thread_work ()
 		SourceFactory::peak_building_lock.lock ();
 
 	wait:
-		if (SourceFactory::files_with_peaks.empty () && SourceFactory::peak_thread_run) {
+		if (SourceFactory::files_with_peaks.empty () && SourceFactory::files_with_peak_mips.empty () && SourceFactory::peak_thread_run) {
 			SourceFactory::PeaksToBuild.wait (SourceFactory::peak_building_lock);
 			(void) Temporal::TempoMap::fetch();
 		}
@@ -81,12 +82,21 @@ peak_thread_work ()
 			return;
 		}
 
-		if (SourceFactory::files_with_peaks.empty ()) {
+		/* peakfiles first, mipmaps are only an optimization */
+		std::list<std::weak_ptr<AudioSource>>* queue;
+
+		if (!SourceFactory::files_with_peaks.empty ()) {
+			queue = &SourceFactory::files_with_peaks;
+		} else if (!SourceFactory::files_with_peak_mips.empty ()) {
+			queue = &SourceFactory::files_with_peak_mips;
+		} else {
 			goto wait;
 		}
 
-		std::shared_ptr<AudioSource> as (SourceFactory::files_with_peaks.front ().lock ());
-		SourceFactory::files_with_peaks.pop_front ();
+		bool const mip = queue == &SourceFactory::files_with_peak_mips;
+
+		std::shared_ptr<AudioSource> as (queue->front ().lock ());
+		queue->pop_front ();
 		if (as) {
 			++active_threads;
 		}
@@ -96,7 +106,11 @@ peak_thread_work ()
 			continue;
 		}
 
-		as->setup_peakfile ();
+		if (mip) {
+			as->build_peak_mip ();
+		} else {
+			as->setup_peakfile ();
+		}
 		SourceFactory::peak_building_lock.lock ();
 		--active_threads;
 		SourceFactory::peak_building_lock.unlock ();
@@ -136,6 +150,14 @@ SourceFactory::terminate ()
 	}
 }
 
+void
+SourceFactory::build_peak_mip (std::shared_ptr<AudioSource const> as)
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+	files_with_peak_mips.push_back (std::const_pointer_cast<AudioSource> (as));
+	PeaksToBuild.signal ();
+}
+
 int
 SourceFactory::setup_peakfile (std::shared_ptr<Source> s, bool async)
 {
@@ -0,0 +1,215 @@
+#include <algorithm>
+
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
+
+#include <taglib/fileref.h>
+#include <taglib/tag.h>
+
+#include "pbd/xml++.h"
+
+#include "ardour/audioengine.h"
+#include "ardour/export_channel.h"
+#include "ardour/export_channel_configuration.h"
+#include "ardour/export_filename.h"
+#include "ardour/export_format_specification.h"
+#include "ardour/export_handler.h"
+#include "ardour/export_status.h"
+#include "ardour/export_timespan.h"
+#include "ardour/io.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+#include "ardour/session_metadata.h"
+
+#include "test_util.h"
+
+#include "export_batch_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ExportBatchTest);
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* const format_spec =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+"<ExportFormatSpecification name=\"TEST-WAV-CUE\" id=\"6a3e0d1c-2b5f-4f0e-9a43-7c1d2e9b8f10\" with-cue=\"true\">"
+"  <Encoding id=\"F_WAV\" type=\"T_Sndfile\" extension=\"wav\" name=\"WAV\" has-sample-format=\"true\" channel-limit=\"256\"/>"
+"  <SampleRate rate=\"1\"/>"
+"  <SRCQuality quality=\"SRC_SincBest\"/>"
+"  <EncodingOptions>"
+"    <Option name=\"sample-format\" value=\"SF_16\"/>"
+"    <Option name=\"dithering\" value=\"D_None\"/>"
+"    <Option name=\"tag-metadata\" value=\"true\"/>"
+"    <Option name=\"tag-support\" value=\"true\"/>"
+"    <Option name=\"broadcast-info\" value=\"false\"/>"
+"  </EncodingOptions>"
+"  <Processing>"
+"    <Normalize enabled=\"false\" target=\"0\"/>"
+"    <Silence>"
+"      <Start>"
+"        <Trim enabled=\"false\"/>"
+"        <Add enabled=\"false\">"
+"          <Duration format=\"Timecode\" hours=\"0\" minutes=\"0\" seconds=\"0\" frames=\"0\"/>"
+"        </Add>"
+"      </Start>"
+"      <End>"
+"        <Trim enabled=\"false\"/>"
+"        <Add enabled=\"false\">"
+"          <Duration format=\"Timecode\" hours=\"0\" minutes=\"0\" seconds=\"0\" frames=\"0\"/>"
+"        </Add>"
+"      </End>"
+"    </Silence>"
+"  </Processing>"
+"</ExportFormatSpecification>";
+
+/** Export two adjacent ranges, which are processed in the same pass, and
+ * check that each of them gets its own CUE file and tags.
+ */
+void
+ExportBatchTest::two_ranges_in_one_pass ()
+{
+	std::string const session_dir = Glib::build_filename (new_test_output_dir (), "export_batch");
+	std::string const export_dir  = Glib::build_filename (session_dir, "export");
+
+	create_and_start_dummy_backend ();
+
+	Session* session = load_session (session_dir, "export_batch");
+	CPPUNIT_ASSERT (session);
+
+	Config->set_export_timespans_in_one_pass (true);
+	SessionMetadata::Metadata ()->set_title ("Batch Export Test");
+
+	std::shared_ptr<ExportHandler> eh = session->get_export_handler ();
+
+	ExportChannelConfigPtr ccp = eh->add_channel_config ();
+	IO* master_out = session->master_out ()->output ().get ();
+	for (uint32_t n = 0; n < master_out->n_ports ().n_audio (); ++n) {
+		PortExportChannel* channel = new PortExportChannel ();
+		channel->add_port (master_out->audio (n));
+		ccp->register_channel (ExportChannelPtr (channel));
+	}
+
+	XMLTree tree;
+	tree.read_buffer (format_spec);
+	ExportFormatSpecPtr fmp = eh->add_format (*tree.root ());
+	fmp->set_soundcloud_upload (false);
+
+	ExportFilenamePtr fnp = eh->add_filename ();
+	fnp->set_folder (export_dir);
+	fnp->include_label = false;
+
+	samplecnt_t const sr = session->nominal_sample_rate ();
+	char const* names[] = { "range-a", "range-b" };
+	ExportTimespanPtr timespans[2];
+
+	for (int i = 0; i < 2; ++i) {
+		timespans[i] = eh->add_timespan ();
+		timespans[i]->set_range (i * sr, (i + 1) * sr);
+		timespans[i]->set_range_id (names[i]);
+		timespans[i]->set_name (names[i]);
+
+		CPPUNIT_ASSERT (eh->add_export_config (timespans[i], ccp, fmp, fnp, std::shared_ptr<BroadcastInfo> ()));
+	}
+
+	CPPUNIT_ASSERT_EQUAL (0, eh->do_export ());
+
+	std::shared_ptr<ExportStatus> status = session->get_export_status ();
+	while (status->running ()) {
+		Glib::usleep (10000);
+	}
+	status->finish (TRS_UI);
+
+	CPPUNIT_ASSERT (!status->aborted ());
+
+	/* do_export () enables include_timespan, so ask for the paths now */
+	std::string paths[2];
+	for (int i = 0; i < 2; ++i) {
+		fnp->set_timespan (timespans[i]);
+		fnp->set_channel_config (ccp);
+		paths[i] = fnp->get_path (fmp);
+	}
+
+	for (int i = 0; i < 2; ++i) {
+		CPPUNIT_ASSERT_MESSAGE (paths[i], Glib::file_test (paths[i], Glib::FILE_TEST_IS_REGULAR));
+
+		std::string const cue = eh->get_cd_marker_filename (paths[i], CDMarkerCUE);
+		CPPUNIT_ASSERT_MESSAGE (cue, Glib::file_test (cue, Glib::FILE_TEST_IS_REGULAR));
+
+		std::string const content = Glib::file_get_contents (cue);
+		CPPUNIT_ASSERT_MESSAGE (cue, content.find (Glib::path_get_basename (paths[i])) != std::string::npos);
+		CPPUNIT_ASSERT_MESSAGE (cue, content.find (Glib::path_get_basename (paths[1 - i])) == std::string::npos);
+
+		TagLib::FileRef file (paths[i].c_str ());
+		CPPUNIT_ASSERT (!file.isNull () && file.tag ());
+		CPPUNIT_ASSERT_EQUAL (std::string ("Batch Export Test"), file.tag ()->title ().to8Bit (true));
+	}
+
+	delete session;
+	stop_and_destroy_backend ();
+}
+
+static bool
+contains (std::vector<ExportTimespanPtr> const& v, ExportTimespanPtr ts)
+{
+	return std::find (v.begin (), v.end (), ts) != v.end ();
+}
+
+/** Batch ranges which are added out of order and partly far apart, and
+ * check that each batch only holds the ranges close to the current one.
+ */
+void
+ExportBatchTest::out_of_order_ranges ()
+{
+	std::string const session_dir = Glib::build_filename (new_test_output_dir (), "export_batch_order");
+
+	create_and_start_dummy_backend ();
+
+	Session* session = load_session (session_dir, "export_batch_order");
+	CPPUNIT_ASSERT (session);
+
+	std::shared_ptr<ExportHandler> eh = session->get_export_handler ();
+
+	samplecnt_t const sr = session->nominal_sample_rate ();
+	samplecnt_t const max_gap = 10 * sr;
+
+	/* start of each one second long range, in seconds */
+	samplepos_t const starts[] = { 3600, 0, 25, 12, 2 };
+	std::vector<ExportTimespanPtr> ts;
+
+	for (size_t i = 0; i < sizeof (starts) / sizeof (starts[0]); ++i) {
+		ts.push_back (eh->add_timespan ());
+		ts.back ()->set_range (starts[i] * sr, (starts[i] + 1) * sr);
+	}
+
+	/* 12s reaches down to 2s and from there to 0s, but not up to 25s */
+	std::vector<ExportTimespanPtr> b = ExportHandler::batch_timespans (ts, ts[3], max_gap, 32);
+	CPPUNIT_ASSERT_EQUAL (size_t (3), b.size ());
+	CPPUNIT_ASSERT (b.front () == ts[3]);
+	CPPUNIT_ASSERT (contains (b, ts[1]));
+	CPPUNIT_ASSERT (contains (b, ts[4]));
+
+	/* the same batch, grown upwards from 0s */
+	b = ExportHandler::batch_timespans (ts, ts[1], max_gap, 32);
+	CPPUNIT_ASSERT_EQUAL (size_t (3), b.size ());
+	CPPUNIT_ASSERT (b.front () == ts[1]);
+	CPPUNIT_ASSERT (contains (b, ts[3]));
+	CPPUNIT_ASSERT (contains (b, ts[4]));
+
+	/* far from everything else */
+	b = ExportHandler::batch_timespans (ts, ts[2], max_gap, 32);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), b.size ());
+	b = ExportHandler::batch_timespans (ts, ts[0], max_gap, 32);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), b.size ());
+
+	/* the closest range is taken first when the batch is limited */
+	b = ExportHandler::batch_timespans (ts, ts[3], max_gap, 2);
+	CPPUNIT_ASSERT_EQUAL (size_t (2), b.size ());
+	CPPUNIT_ASSERT (b.front () == ts[3]);
+	CPPUNIT_ASSERT (b.back () == ts[4]);
+
+	delete session;
+	stop_and_destroy_backend ();
+}
@@ -0,0 +1,15 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class ExportBatchTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (ExportBatchTest);
+	CPPUNIT_TEST (two_ranges_in_one_pass);
+	CPPUNIT_TEST (out_of_order_ranges);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+
+	void two_ranges_in_one_pass ();
+	void out_of_order_ranges ();
+};
@@ -0,0 +1,140 @@
+#ifndef __ardour_test_gain_matrix_reference_h__
+#define __ardour_test_gain_matrix_reference_h__
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "ardour/audio_buffer.h"
+#include "ardour/buffer_set.h"
+#include "ardour/gain_matrix.h"
+#include "ardour/runtime_functions.h"
+
+/* Helpers shared by the GainMatrix unit-test and the gain_matrix_timing
+ * profiling program.
+ */
+namespace GainMatrixReference {
+
+using namespace ARDOUR;
+
+/* per-signal VBAP distribution, as it was before the gain matrix */
+struct RefSignal {
+	std::vector<gain_t> gains;
+	int                 outputs[3];
+	int                 desired_outputs[3];
+	double              desired_gains[3];
+
+	RefSignal (uint32_t n_speakers)
+		: gains (n_speakers, 0)
+	{
+		outputs[0] = outputs[1] = outputs[2] = -1;
+		desired_outputs[0] = desired_outputs[1] = desired_outputs[2] = -1;
+		desired_gains[0] = desired_gains[1] = desired_gains[2] = 0;
+	}
+};
+
+inline void
+ref_ramp (Sample* dst, Sample const* src, pframes_t nframes, gain_t initial, gain_t target)
+{
+	if (initial == 0 && target == 0) {
+		return;
+	}
+	gain_t const delta = (target - initial) / nframes;
+	for (pframes_t n = 0; n < nframes; ++n) {
+		*dst++ += (*src++ * initial);
+		initial += delta;
+	}
+}
+
+inline void
+ref_distribute_one (RefSignal& signal, Sample const* src, BufferSet& obufs, gain_t gain_coefficient, pframes_t nframes)
+{
+	size_t const sz = signal.gains.size ();
+	int8_t       outputs[128];
+
+	assert (sz <= 128);
+	memset (outputs, 0, sz);
+
+	for (int o = 0; o < 3; ++o) {
+		if (signal.outputs[o] != -1) {
+			outputs[signal.outputs[o]] |= 1;
+		}
+		if (signal.desired_outputs[o] != -1) {
+			outputs[signal.desired_outputs[o]] |= 1 << 1;
+		}
+	}
+
+	for (int o = 0; o < 3; ++o) {
+		int const output = signal.desired_outputs[o];
+		if (output == -1) {
+			continue;
+		}
+
+		pan_t pan = gain_coefficient * signal.desired_gains[o];
+
+		if (pan == 0.0 && signal.gains[output] == 0.0) {
+			signal.gains[output] = 0.0;
+		} else if (fabs (pan - signal.gains[output]) > 0.00001) {
+			ref_ramp (obufs.get_audio (output).data (), src, nframes, signal.gains[output], pan);
+			signal.gains[output] = pan;
+		} else {
+			mix_buffers_with_gain (obufs.get_audio (output).data (), src, nframes, pan);
+			signal.gains[output] = pan;
+		}
+	}
+
+	for (uint32_t o = 0; o < sz; ++o) {
+		if (outputs[o] == 1) {
+			ref_ramp (obufs.get_audio (o).data (), src, nframes, signal.gains[o], 0.0);
+			signal.gains[o] = 0.0;
+		}
+	}
+
+	memcpy (signal.outputs, signal.desired_outputs, sizeof (signal.outputs));
+}
+
+/* 2D pairwise panning on a ring of speakers, like VBAP::compute_gains */
+inline void
+place (RefSignal& signal, double azi, uint32_t n_speakers)
+{
+	double const pos  = fmod (azi, 1.0) * n_speakers;
+	int const    s0   = (int)floor (pos) % n_speakers;
+	double const frac = pos - floor (pos);
+
+	signal.desired_outputs[0] = s0;
+	signal.desired_outputs[1] = (s0 + 1) % n_speakers;
+	signal.desired_outputs[2] = -1;
+	signal.desired_gains[0]   = cos (frac * M_PI / 2);
+	signal.desired_gains[1]   = sin (frac * M_PI / 2);
+	signal.desired_gains[2]   = 0;
+}
+
+inline void
+set_targets (GainMatrix& m, std::vector<RefSignal> const& signals, gain_t gain_coefficient)
+{
+	m.clear_targets ();
+	for (uint32_t n = 0; n < signals.size (); ++n) {
+		for (int o = 0; o < 3; ++o) {
+			if (signals[n].desired_outputs[o] != -1) {
+				m.set_target (n, signals[n].desired_outputs[o], gain_coefficient * signals[n].desired_gains[o]);
+			}
+		}
+	}
+}
+
+inline void
+fill_inputs (BufferSet& bufs, uint32_t n_signals, pframes_t nframes, uint32_t cycle)
+{
+	for (uint32_t n = 0; n < n_signals; ++n) {
+		Sample* d = bufs.get_audio (n).data ();
+		for (pframes_t i = 0; i < nframes; ++i) {
+			d[i] = sin ((cycle * nframes + i) * (.01 + .003 * n));
+		}
+		bufs.get_audio (n).set_written (true);
+	}
+}
+
+} // namespace GainMatrixReference
+
+#endif /* __ardour_test_gain_matrix_reference_h__ */
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <vector>
+
+#include "pbd/compose.h"
+
+#include "ardour/audio_buffer.h"
+#include "ardour/buffer_set.h"
+#include "ardour/gain_matrix.h"
+
+#include "gain_matrix_reference.h"
+#include "gain_matrix_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (GainMatrixTest);
+
+using namespace ARDOUR;
+using namespace GainMatrixReference;
+
+void
+GainMatrixTest::equivalenceTest ()
+{
+	pframes_t const nframes = 256;
+
+	for (uint32_t n_speakers = 4; n_speakers <= 32; n_speakers *= 2) {
+		for (uint32_t n_signals = 1; n_signals <= 4; ++n_signals) {
+			BufferSet ibufs;
+			BufferSet ref_out;
+			BufferSet mtx_out;
+
+			ibufs.ensure_buffers (DataType::AUDIO, n_signals, nframes);
+			ref_out.ensure_buffers (DataType::AUDIO, n_speakers, nframes);
+			mtx_out.ensure_buffers (DataType::AUDIO, n_speakers, nframes);
+
+			std::vector<RefSignal> signals (n_signals, RefSignal (n_speakers));
+			GainMatrix             matrix;
+			matrix.configure (n_signals, n_speakers);
+
+			for (uint32_t cycle = 0; cycle < 64; ++cycle) {
+				fill_inputs (ibufs, n_signals, nframes, cycle);
+				ref_out.silence (nframes, 0);
+				mtx_out.silence (nframes, 0);
+
+				/* move in steps that cross speaker boundaries, hold still every 4th cycle */
+				for (uint32_t n = 0; n < n_signals; ++n) {
+					if (cycle % 4) {
+						place (signals[n], .05 * cycle + n / (double)n_signals, n_speakers);
+					}
+				}
+
+				gain_t const gain = (cycle > 48) ? 0.5 : 1.0;
+
+				for (uint32_t n = 0; n < n_signals; ++n) {
+					ref_distribute_one (signals[n], ibufs.get_audio (n).data (), ref_out, gain, nframes);
+				}
+
+				set_targets (matrix, signals, gain);
+				matrix.apply (ibufs, mtx_out, nframes);
+
+				for (uint32_t o = 0; o < n_speakers; ++o) {
+					Sample const* a = ref_out.get_audio (o).data ();
+					Sample const* b = mtx_out.get_audio (o).data ();
+					for (pframes_t i = 0; i < nframes; ++i) {
+						CPPUNIT_ASSERT_MESSAGE (string_compose ("speakers: %1 signals: %2 cycle: %3 out: %4 sample: %5", n_speakers, n_signals, cycle, o, i),
+						                        fabsf (a[i] - b[i]) < 1e-5);
+					}
+				}
+			}
+		}
+	}
+}
+
+void
+GainMatrixTest::fadeOutTest ()
+{
+	pframes_t const nframes = 64;
+
+	BufferSet ibufs;
+	BufferSet obufs;
+	ibufs.ensure_buffers (DataType::AUDIO, 1, nframes);
+	obufs.ensure_buffers (DataType::AUDIO, 2, nframes);
+
+	for (pframes_t i = 0; i < nframes; ++i) {
+		ibufs.get_audio (0).data ()[i] = 1.f;
+	}
+
+	GainMatrix matrix;
+	matrix.configure (1, 2);
+
+	/* fade in on the first output */
+	obufs.silence (nframes, 0);
+	matrix.clear_targets ();
+	matrix.set_target (0, 0, 1.f);
+	matrix.apply (ibufs, obufs, nframes);
+
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.f, obufs.get_audio (0).data ()[0], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.f - 1.f / nframes, obufs.get_audio (0).data ()[nframes - 1], 1e-6);
+	CPPUNIT_ASSERT (obufs.get_audio (1).silent ());
+
+	/* steady state */
+	obufs.silence (nframes, 0);
+	matrix.clear_targets ();
+	matrix.set_target (0, 0, 1.f);
+	matrix.apply (ibufs, obufs, nframes);
+
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.f, obufs.get_audio (0).data ()[0], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.f, obufs.get_audio (0).data ()[nframes - 1], 1e-6);
+
+	/* move to the second output: the first one fades out without a target */
+	obufs.silence (nframes, 0);
+	matrix.clear_targets ();
+	matrix.set_target (0, 1, 1.f);
+	matrix.apply (ibufs, obufs, nframes);
+
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.f, obufs.get_audio (0).data ()[0], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.f / nframes, obufs.get_audio (0).data ()[nframes - 1], 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.f, obufs.get_audio (1).data ()[0], 1e-6);
+
+	/* and is not used anymore */
+	obufs.silence (nframes, 0);
+	matrix.clear_targets ();
+	matrix.set_target (0, 1, 1.f);
+	matrix.apply (ibufs, obufs, nframes);
+
+	CPPUNIT_ASSERT (obufs.get_audio (0).silent ());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.f, obufs.get_audio (1).data ()[0], 1e-6);
+}
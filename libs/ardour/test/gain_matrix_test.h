@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+/* Compare GainMatrix (as used by the VBAP panner) with the previous
+ * per-signal distribution. See profiling/gain_matrix_timing.cc for a
+ * benchmark of both.
+ */
+class GainMatrixTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (GainMatrixTest);
+	CPPUNIT_TEST (equivalenceTest);
+	CPPUNIT_TEST (fadeOutTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void equivalenceTest ();
+	void fadeOutTest ();
+};
@@ -0,0 +1,325 @@
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "pbd/compose.h"
+#include "pbd/fpu.h"
+#include "pbd/malign.h"
+#include "pbd/microseconds.h"
+
+#include "libs/ardour/ardour/mix.h"
+#include "mix_functions_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MixFunctionsTest);
+
+void
+MixFunctionsTest::setUp ()
+{
+	_size = 8192;
+	/* room for up to 4 interleaved channels */
+	cache_aligned_malloc ((void**) &_src,      sizeof (float) * _size * 4);
+	cache_aligned_malloc ((void**) &_test,     sizeof (float) * _size * 4);
+	cache_aligned_malloc ((void**) &_comp,     sizeof (float) * _size * 4);
+	cache_aligned_malloc ((void**) &_i16_test, sizeof (int16_t) * _size);
+	cache_aligned_malloc ((void**) &_i16_comp, sizeof (int16_t) * _size);
+	cache_aligned_malloc ((void**) &_i32_test, sizeof (int32_t) * _size);
+	cache_aligned_malloc ((void**) &_i32_comp, sizeof (int32_t) * _size);
+
+	/* include values out of [-1, 1] to test clamping */
+	for (size_t i = 0; i < _size * 4; ++i) {
+		_src[i] = 1.5 * sin (i * .0123) * cos (i * .00071);
+	}
+
+	use_defaults ();
+}
+
+void
+MixFunctionsTest::tearDown ()
+{
+	cache_aligned_free (_src);
+	cache_aligned_free (_test);
+	cache_aligned_free (_comp);
+	cache_aligned_free (_i16_test);
+	cache_aligned_free (_i16_comp);
+	cache_aligned_free (_i32_test);
+	cache_aligned_free (_i32_comp);
+}
+
+void
+MixFunctionsTest::use_defaults ()
+{
+	apply_gain_ramp      = default_apply_gain_ramp;
+	interleave           = default_interleave;
+	deinterleave         = default_deinterleave;
+	float_to_int16       = default_float_to_int16;
+	int16_to_float       = default_int16_to_float;
+	float_to_int24       = default_float_to_int24;
+	int24_to_float       = default_int24_to_float;
+	invert_polarity      = default_invert_polarity;
+	mix_buffers_inverted = default_mix_buffers_inverted;
+	mix_buffers_with_gain_ramp = default_mix_buffers_with_gain_ramp;
+}
+
+void
+MixFunctionsTest::compare (std::string const& msg, float const* a, float const* b, size_t cnt, float max_diff)
+{
+	size_t err = 0;
+	for (size_t i = 0; i < cnt; ++i) {
+		if (fabsf (a[i] - b[i]) > max_diff) {
+			++err;
+		}
+	}
+	CPPUNIT_ASSERT_MESSAGE (msg, err == 0);
+}
+
+void
+MixFunctionsTest::run (size_t align_max)
+{
+	for (size_t off = 0; off < align_max; ++off) {
+		for (size_t cnt = 1; cnt < 2 * align_max; ++cnt) {
+
+			/* gain ramp, fade in and out */
+			for (int dir = 0; dir < 2; ++dir) {
+				float const g0 = dir ? 1.f : 0.f;
+				float const g1 = dir ? 0.f : 1.f;
+				memcpy (_test, _src, sizeof (float) * (off + cnt));
+				memcpy (_comp, _src, sizeof (float) * (off + cnt));
+				float const gt = apply_gain_ramp (&_test[off], cnt, g0, g1, 0.05);
+				float const gc = default_apply_gain_ramp (&_comp[off], cnt, g0, g1, 0.05);
+				compare (string_compose ("Gain ramp off: %1 cnt: %2", off, cnt), _test, _comp, off + cnt, 1e-5);
+				CPPUNIT_ASSERT_MESSAGE (string_compose ("Gain ramp result off: %1 cnt: %2", off, cnt), fabsf (gt - gc) < 1e-5);
+			}
+
+			/* (de)interleave */
+			for (uint32_t n_chn = 1; n_chn <= 4; ++n_chn) {
+				for (uint32_t chn = 0; chn < n_chn; ++chn) {
+					memset (_test, 0, sizeof (float) * (cnt * n_chn + off));
+					memset (_comp, 0, sizeof (float) * (cnt * n_chn + off));
+					interleave (&_test[off], &_src[off], cnt, chn, n_chn);
+					default_interleave (&_comp[off], &_src[off], cnt, chn, n_chn);
+					compare (string_compose ("Interleave off: %1 cnt: %2 chn: %3/%4", off, cnt, chn, n_chn), _test, _comp, cnt * n_chn + off);
+
+					deinterleave (&_test[off], &_src[off], cnt, chn, n_chn);
+					default_deinterleave (&_comp[off], &_src[off], cnt, chn, n_chn);
+					compare (string_compose ("Deinterleave off: %1 cnt: %2 chn: %3/%4", off, cnt, chn, n_chn), &_test[off], &_comp[off], cnt);
+				}
+			}
+
+			/* sample format conversion */
+			float_to_int16 (&_i16_test[off], &_src[off], cnt);
+			default_float_to_int16 (&_i16_comp[off], &_src[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Float to int16 off: %1 cnt: %2", off, cnt), 0 == memcmp (&_i16_test[off], &_i16_comp[off], sizeof (int16_t) * cnt));
+
+			int16_to_float (&_test[off], &_i16_comp[off], cnt);
+			default_int16_to_float (&_comp[off], &_i16_comp[off], cnt);
+			compare (string_compose ("Int16 to float off: %1 cnt: %2", off, cnt), &_test[off], &_comp[off], cnt);
+
+			float_to_int24 (&_i32_test[off], &_src[off], cnt);
+			default_float_to_int24 (&_i32_comp[off], &_src[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Float to int24 off: %1 cnt: %2", off, cnt), 0 == memcmp (&_i32_test[off], &_i32_comp[off], sizeof (int32_t) * cnt));
+
+			int24_to_float (&_test[off], &_i32_comp[off], cnt);
+			default_int24_to_float (&_comp[off], &_i32_comp[off], cnt);
+			compare (string_compose ("Int24 to float off: %1 cnt: %2", off, cnt), &_test[off], &_comp[off], cnt);
+
+			/* polarity */
+			memcpy (_test, _src, sizeof (float) * (off + cnt));
+			memcpy (_comp, _src, sizeof (float) * (off + cnt));
+			invert_polarity (&_test[off], cnt);
+			default_invert_polarity (&_comp[off], cnt);
+			compare (string_compose ("Invert polarity off: %1 cnt: %2", off, cnt), _test, _comp, off + cnt);
+
+			mix_buffers_inverted (&_test[off], &_src[_size], cnt);
+			default_mix_buffers_inverted (&_comp[off], &_src[_size], cnt);
+			compare (string_compose ("Mix inverted off: %1 cnt: %2", off, cnt), _test, _comp, off + cnt);
+
+			/* mix with linear gain ramp */
+			mix_buffers_with_gain_ramp (&_test[off], &_src[_size], cnt, .2f, .9f);
+			default_mix_buffers_with_gain_ramp (&_comp[off], &_src[_size], cnt, .2f, .9f);
+			compare (string_compose ("Mix gain ramp off: %1 cnt: %2", off, cnt), _test, _comp, off + cnt, 1e-5);
+		}
+	}
+
+	/* a long gain ramp that reaches the target */
+	memcpy (_test, _src, sizeof (float) * _size);
+	memcpy (_comp, _src, sizeof (float) * _size);
+	float const gt = apply_gain_ramp (_test, _size, 0.1, 0.9, 0.003);
+	float const gc = default_apply_gain_ramp (_comp, _size, 0.1, 0.9, 0.003);
+	compare ("Gain ramp", _test, _comp, _size, 1e-4);
+	CPPUNIT_ASSERT_MESSAGE ("Gain ramp result", fabsf (gt - gc) < 1e-4);
+}
+
+void
+MixFunctionsTest::benchmark (std::string const& name)
+{
+	int const              n_iter = 2000;
+	uint32_t const         n      = _size;
+	PBD::microseconds_t    t[2];
+	float                  g = 0;
+
+	std::cerr << "\n" << name << " vs default, " << n_iter << " x " << n << " samples [us]:\n";
+
+#define MIX_BENCH(NAME, CALL, DFLT)                             \
+	t[0] = PBD::get_microseconds ();                             \
+	for (int i = 0; i < n_iter; ++i) { CALL; }                   \
+	t[0] = PBD::get_microseconds () - t[0];                      \
+	t[1] = PBD::get_microseconds ();                             \
+	for (int i = 0; i < n_iter; ++i) { DFLT; }                   \
+	t[1] = PBD::get_microseconds () - t[1];                      \
+	std::cerr << "  " << NAME << ": " << t[0] << " / " << t[1] << "\n";
+
+	MIX_BENCH ("gain ramp      ",
+	           g += apply_gain_ramp (_test, n, 0, 1, 1e-4),
+	           g += default_apply_gain_ramp (_comp, n, 0, 1, 1e-4));
+	MIX_BENCH ("interleave     ",
+	           interleave (_test, _src, n, i & 1, 2),
+	           default_interleave (_comp, _src, n, i & 1, 2));
+	MIX_BENCH ("deinterleave   ",
+	           deinterleave (_test, _src, n, i & 1, 2),
+	           default_deinterleave (_comp, _src, n, i & 1, 2));
+	MIX_BENCH ("float -> int16 ",
+	           float_to_int16 (_i16_test, _src, n),
+	           default_float_to_int16 (_i16_comp, _src, n));
+	MIX_BENCH ("int16 -> float ",
+	           int16_to_float (_test, _i16_test, n),
+	           default_int16_to_float (_comp, _i16_comp, n));
+	MIX_BENCH ("float -> int24 ",
+	           float_to_int24 (_i32_test, _src, n),
+	           default_float_to_int24 (_i32_comp, _src, n));
+	MIX_BENCH ("int24 -> float ",
+	           int24_to_float (_test, _i32_test, n),
+	           default_int24_to_float (_comp, _i32_comp, n));
+	MIX_BENCH ("invert polarity",
+	           invert_polarity (_test, n),
+	           default_invert_polarity (_comp, n));
+	MIX_BENCH ("mix inverted   ",
+	           mix_buffers_inverted (_test, _src, n),
+	           default_mix_buffers_inverted (_comp, _src, n));
+	MIX_BENCH ("mix gain ramp  ",
+	           mix_buffers_with_gain_ramp (_test, _src, n, 0, 1),
+	           default_mix_buffers_with_gain_ramp (_comp, _src, n, 0, 1));
+
+#undef MIX_BENCH
+
+	CPPUNIT_ASSERT (!std::isnan (g));
+}
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+
+void
+MixFunctionsTest::avxTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_avx ()) {
+		printf ("AVX is not available at run-time\n");
+		return;
+	}
+
+	apply_gain_ramp      = x86_avx_apply_gain_ramp;
+	interleave           = x86_avx_interleave;
+	deinterleave         = x86_avx_deinterleave;
+	float_to_int16       = x86_avx_float_to_int16;
+	int16_to_float       = x86_avx_int16_to_float;
+	float_to_int24       = x86_avx_float_to_int24;
+	int24_to_float       = x86_avx_int24_to_float;
+	invert_polarity      = x86_avx_invert_polarity;
+	mix_buffers_inverted = x86_avx_mix_buffers_inverted;
+	mix_buffers_with_gain_ramp = x86_avx_mix_buffers_with_gain_ramp;
+
+	run (32);
+	benchmark ("AVX");
+}
+
+void
+MixFunctionsTest::avx512fTest ()
+{
+#ifdef FPU_AVX512F_SUPPORT
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_avx512f ()) {
+		printf ("AVX512F is not available at run-time\n");
+		return;
+	}
+
+	apply_gain_ramp      = x86_avx512f_apply_gain_ramp;
+	interleave           = x86_avx_interleave;
+	deinterleave         = x86_avx_deinterleave;
+	float_to_int16       = x86_avx512f_float_to_int16;
+	int16_to_float       = x86_avx512f_int16_to_float;
+	float_to_int24       = x86_avx512f_float_to_int24;
+	int24_to_float       = x86_avx512f_int24_to_float;
+	invert_polarity      = x86_avx512f_invert_polarity;
+	mix_buffers_inverted = x86_avx512f_mix_buffers_inverted;
+	mix_buffers_with_gain_ramp = x86_avx512f_mix_buffers_with_gain_ramp;
+
+	run (64);
+	benchmark ("AVX512F");
+#else
+	printf ("AVX512F is disabled at compile-time\n");
+#endif
+}
+
+#elif defined ARM_NEON_SUPPORT
+
+void
+MixFunctionsTest::neonTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_neon ()) {
+		printf ("NEON is not available at run-time\n");
+		return;
+	}
+
+	apply_gain_ramp      = arm_neon_apply_gain_ramp;
+	interleave           = arm_neon_interleave;
+	deinterleave         = arm_neon_deinterleave;
+	float_to_int16       = arm_neon_float_to_int16;
+	int16_to_float       = arm_neon_int16_to_float;
+	float_to_int24       = arm_neon_float_to_int24;
+	int24_to_float       = arm_neon_int24_to_float;
+	invert_polarity      = arm_neon_invert_polarity;
+	mix_buffers_inverted = arm_neon_mix_buffers_inverted;
+	mix_buffers_with_gain_ramp = arm_neon_mix_buffers_with_gain_ramp;
+
+	run (32);
+	benchmark ("NEON");
+}
+
+#endif
+
+void
+MixFunctionsTest::defaultTest ()
+{
+	use_defaults ();
+
+	/* sanity check the reference implementation */
+	float    f[4] = { 1.f, -1.f, .5f, -2.f };
+	int16_t  i16[4];
+	int32_t  i32[4];
+
+	default_float_to_int16 (i16, f, 4);
+	CPPUNIT_ASSERT_EQUAL ((int16_t)  32767, i16[0]);
+	CPPUNIT_ASSERT_EQUAL ((int16_t) -32768, i16[1]);
+	CPPUNIT_ASSERT_EQUAL ((int16_t)  16384, i16[2]);
+	CPPUNIT_ASSERT_EQUAL ((int16_t) -32768, i16[3]);
+
+	default_float_to_int24 (i32, f, 4);
+	CPPUNIT_ASSERT_EQUAL ((int32_t)  8388607, i32[0]);
+	CPPUNIT_ASSERT_EQUAL ((int32_t) -8388608, i32[1]);
+	CPPUNIT_ASSERT_EQUAL ((int32_t)  4194304, i32[2]);
+	CPPUNIT_ASSERT_EQUAL ((int32_t) -8388608, i32[3]);
+
+	float g = default_apply_gain_ramp (f, 4, 0.f, 1.f, .5f);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.f, f[0], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-.5f, f[1], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.375f, f[2], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-1.75f, f[3], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.9375f, g, 1e-9);
+
+	float d[4] = { 0.f, 0.f, 0.f, 0.f };
+	float o[4] = { 1.f, 1.f, 1.f, 1.f };
+	default_mix_buffers_with_gain_ramp (d, o, 4, 0.f, 1.f);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.f, d[0], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.25f, d[1], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.5f, d[2], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.75f, d[3], 1e-9);
+}
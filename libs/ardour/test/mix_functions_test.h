@@ -0,0 +1,60 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/runtime_functions.h"
+
+/* Compare the SIMD variants of the gain ramp, (de)interleave, sample format
+ * conversion, polarity and gain ramp mix kernels against the default C implementation
+ * (see also FPUTest for the mix/gain/peak functions).
+ */
+class MixFunctionsTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MixFunctionsTest);
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	CPPUNIT_TEST (avxTest);
+	CPPUNIT_TEST (avx512fTest);
+#elif defined ARM_NEON_SUPPORT
+	CPPUNIT_TEST (neonTest);
+#endif
+	CPPUNIT_TEST (defaultTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	void avxTest ();
+	void avx512fTest ();
+#elif defined ARM_NEON_SUPPORT
+	void neonTest ();
+#endif
+	void defaultTest ();
+
+private:
+	void use_defaults ();
+	void run (size_t align_max);
+	void benchmark (std::string const& name);
+	void compare (std::string const&, float const* a, float const* b, size_t cnt, float max_diff = 0);
+
+	ARDOUR::apply_gain_ramp_t      apply_gain_ramp;
+	ARDOUR::interleave_t           interleave;
+	ARDOUR::deinterleave_t         deinterleave;
+	ARDOUR::float_to_int16_t       float_to_int16;
+	ARDOUR::int16_to_float_t       int16_to_float;
+	ARDOUR::float_to_int24_t       float_to_int24;
+	ARDOUR::int24_to_float_t       int24_to_float;
+	ARDOUR::invert_polarity_t      invert_polarity;
+	ARDOUR::mix_buffers_inverted_t mix_buffers_inverted;
+	ARDOUR::mix_buffers_with_gain_ramp_t mix_buffers_with_gain_ramp;
+
+	size_t _size;
+
+	float*   _src;
+	float*   _test;
+	float*   _comp;
+	int16_t* _i16_test;
+	int16_t* _i16_comp;
+	int32_t* _i32_test;
+	int32_t* _i32_comp;
+};
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "temporal/tempo.h"
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+
+#include "playlist_region_index_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaylistRegionIndexTest);
+
+using namespace std;
+using namespace ARDOUR;
+using namespace Temporal;
+
+static void
+set_tempo (double bpm)
+{
+	TempoMap::WritableSharedPtr tmap (TempoMap::write_copy ());
+	tmap->set_tempo (Tempo (bpm, 4), timepos_t ());
+	TempoMap::update (tmap);
+	TempoMap::fetch ();
+}
+
+void
+PlaylistRegionIndexTest::setUp ()
+{
+	AudioRegionTest::setUp ();
+	_orig_tempo_map = &TempoMap::use ()->get_state ();
+}
+
+void
+PlaylistRegionIndexTest::tearDown ()
+{
+	TempoMap::WritableSharedPtr tmap (TempoMap::write_copy ());
+	tmap->set_state (*_orig_tempo_map, PBD::Stateful::current_state_version);
+	TempoMap::update (tmap);
+	delete _orig_tempo_map;
+
+	AudioRegionTest::tearDown ();
+}
+
+/** A region changed to music-time must be found at its new position
+ * after the tempo-map changed.
+ */
+void
+PlaylistRegionIndexTest::timeDomainTest ()
+{
+	samplecnt_t const sr = get_test_sample_rate ();
+
+	set_tempo (120);
+
+	_playlist->add_region (_r[0], timepos_t (4 * sr));
+	_playlist->add_region (_r[1], timepos_t (20 * sr));
+
+	_r[0]->set_position_time_domain (Temporal::BeatTime);
+
+	/* beat 8 moves from 4 to 8 seconds */
+	set_tempo (60);
+
+	timepos_t const pos (_r[0]->position ());
+	CPPUNIT_ASSERT_EQUAL (samplepos_t (8 * sr), pos.samples ());
+
+	std::shared_ptr<RegionList> rl = _playlist->regions_touched (pos, pos);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), rl->size ());
+	CPPUNIT_ASSERT (rl->front () == _r[0]);
+
+	rl = _playlist->regions_with_start_within (TimeRange (timepos_t (7 * sr), timepos_t (9 * sr)));
+	CPPUNIT_ASSERT_EQUAL (size_t (1), rl->size ());
+	CPPUNIT_ASSERT (rl->front () == _r[0]);
+
+	rl = _playlist->regions_with_end_within (TimeRange (timepos_t (7 * sr), timepos_t (9 * sr)));
+	CPPUNIT_ASSERT_EQUAL (size_t (1), rl->size ());
+	CPPUNIT_ASSERT (rl->front () == _r[0]);
+
+	/* nothing is left at the old position */
+	rl = _playlist->regions_touched (timepos_t (4 * sr), timepos_t (4 * sr + 50));
+	CPPUNIT_ASSERT (rl->empty ());
+
+	CPPUNIT_ASSERT (_playlist->find_next_region (timepos_t (6 * sr), Start, 1) == _r[0]);
+	CPPUNIT_ASSERT (_playlist->find_next_region (timepos_t (10 * sr), Start, -1) == _r[0]);
+	CPPUNIT_ASSERT (_playlist->find_next_region (timepos_t (8 * sr), Start, 1) == _r[1]);
+}
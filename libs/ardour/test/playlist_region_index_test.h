@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2004,2014 Robin Gareus <robin@gareus.org>
+ * Copyright (C) 2024 The Ardour Developers
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -16,20 +16,22 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include <stdint.h>
-#include <sys/select.h>
+#include "audio_region_test.h"
 
-/* select() sleeps _at most_ a given time.
- * (compared to usleep() or nanosleep() which sleep at least a given time)
- */
-static void select_sleep (uint64_t usec) {
-	if (usec <= 10) return;
-	fd_set fd;
-	int max_fd=0;
-	struct timeval tv;
-	tv.tv_sec = usec / 1000000;
-	tv.tv_usec = usec % 1000000;
-	FD_ZERO (&fd);
-	select (max_fd, &fd, NULL, NULL, &tv);
-	// on Linux, tv reflects the actual time slept.
-}
+class XMLNode;
+
+class PlaylistRegionIndexTest : public AudioRegionTest
+{
+	CPPUNIT_TEST_SUITE (PlaylistRegionIndexTest);
+	CPPUNIT_TEST (timeDomainTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void timeDomainTest ();
+
+private:
+	XMLNode* _orig_tempo_map;
+};
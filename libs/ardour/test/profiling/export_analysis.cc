@@ -0,0 +1,188 @@
+#include "test_ui.h"
+#include "test_util.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include <sys/resource.h>
+
+#include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+#include "pbd/xml++.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/export_channel.h"
+#include "ardour/export_channel_configuration.h"
+#include "ardour/export_filename.h"
+#include "ardour/export_format_specification.h"
+#include "ardour/export_handler.h"
+#include "ardour/export_status.h"
+#include "ardour/export_timespan.h"
+#include "ardour/io.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+static const char* const format_spec =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+"<ExportFormatSpecification name=\"PROFILE-NORMALIZED-WAV\" id=\"0d6f1c8e-45a2-4b7c-9e31-5f2a8c7d9b04\">"
+"  <Encoding id=\"F_WAV\" type=\"T_Sndfile\" extension=\"wav\" name=\"WAV\" has-sample-format=\"true\" channel-limit=\"256\"/>"
+"  <SampleRate rate=\"1\"/>"
+"  <SRCQuality quality=\"SRC_SincBest\"/>"
+"  <EncodingOptions>"
+"    <Option name=\"sample-format\" value=\"SF_24\"/>"
+"    <Option name=\"dithering\" value=\"D_None\"/>"
+"    <Option name=\"tag-metadata\" value=\"false\"/>"
+"    <Option name=\"tag-support\" value=\"false\"/>"
+"    <Option name=\"broadcast-info\" value=\"false\"/>"
+"  </EncodingOptions>"
+"  <Processing>"
+"    <Normalize enabled=\"true\" target=\"-1\"/>"
+"    <Silence>"
+"      <Start>"
+"        <Trim enabled=\"false\"/>"
+"        <Add enabled=\"false\">"
+"          <Duration format=\"Timecode\" hours=\"0\" minutes=\"0\" seconds=\"0\" frames=\"0\"/>"
+"        </Add>"
+"      </Start>"
+"      <End>"
+"        <Trim enabled=\"false\"/>"
+"        <Add enabled=\"false\">"
+"          <Duration format=\"Timecode\" hours=\"0\" minutes=\"0\" seconds=\"0\" frames=\"0\"/>"
+"        </Add>"
+"      </End>"
+"    </Silence>"
+"  </Processing>"
+"</ExportFormatSpecification>";
+
+/* Export n_ranges adjacent, normalized ranges of the master-bus and
+ * return the time it took in seconds.
+ */
+static double
+run (Session* session, std::string const& folder, samplecnt_t length, uint32_t n_ranges)
+{
+	std::shared_ptr<ExportHandler> eh = session->get_export_handler ();
+
+	ExportChannelConfigPtr ccp = eh->add_channel_config ();
+	IO* master_out = session->master_out ()->output ().get ();
+	for (uint32_t n = 0; n < master_out->n_ports ().n_audio (); ++n) {
+		PortExportChannel* channel = new PortExportChannel ();
+		channel->add_port (master_out->audio (n));
+		ccp->register_channel (ExportChannelPtr (channel));
+	}
+
+	XMLTree tree;
+	tree.read_buffer (format_spec);
+	ExportFormatSpecPtr fmp = eh->add_format (*tree.root ());
+	fmp->set_soundcloud_upload (false);
+
+	ExportFilenamePtr fnp = eh->add_filename ();
+	fnp->set_folder (folder);
+	fnp->include_label = false;
+
+	for (uint32_t i = 0; i < n_ranges; ++i) {
+		ExportTimespanPtr tsp = eh->add_timespan ();
+		tsp->set_range (i * length, (i + 1) * length);
+		tsp->set_range_id (string_compose ("range-%1", i + 1));
+		tsp->set_name (string_compose ("range-%1", i + 1));
+		eh->add_export_config (tsp, ccp, fmp, fnp, std::shared_ptr<BroadcastInfo> ());
+	}
+
+	microseconds_t const start = get_microseconds ();
+
+	if (eh->do_export ()) {
+		cerr << "Export failed to start\n";
+		exit (EXIT_FAILURE);
+	}
+
+	std::shared_ptr<ExportStatus> status = session->get_export_status ();
+	while (status->running ()) {
+		Glib::usleep (100000);
+	}
+	status->finish (TRS_UI);
+
+	microseconds_t const end = get_microseconds ();
+
+	eh->reset ();
+	return (end - start) / 1e6;
+}
+
+static long
+max_rss_mb ()
+{
+	struct rusage ru;
+	getrusage (RUSAGE_SELF, &ru);
+	return ru.ru_maxrss / 1024;
+}
+
+/* Compare normalized exports using a tmp file for the analysis data
+ * with keeping that data in memory, with a budget that is too small
+ * for all of it (partial spill), and one that is large enough.
+ *
+ * The default is a single one hour range. Since the peak RSS can only
+ * grow, the runs are ordered by the amount of memory they may use.
+ */
+int
+main (int argc, char* argv[])
+{
+	uint32_t seconds  = 3600;
+	uint32_t n_ranges = 1;
+
+	if (argc > 1) {
+		seconds = atoi (argv[1]);
+	}
+	if (argc > 2) {
+		n_ranges = atoi (argv[2]);
+	}
+
+	if (seconds < 1 || n_ranges < 1) {
+		cerr << "Syntax: " << argv[0] << " [seconds [ranges]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI ();
+	create_and_start_dummy_backend ();
+
+	std::string const dir     = Glib::build_filename (new_test_output_dir (), "export_analysis");
+	Session*          session = load_session (dir, "export_analysis");
+
+	samplecnt_t const length = (samplecnt_t) seconds * session->nominal_sample_rate ();
+	uint32_t const    chans  = session->master_out ()->output ()->n_ports ().n_audio ();
+	uint32_t const    needed = (uint32_t) (length * chans * n_ranges * sizeof (Sample) / 1048576) + 1;
+
+	const struct {
+		char const* name;
+		uint32_t    limit; // MB
+	} runs[] = {
+		{ "tmp file", 0 },
+		{ "memory, partial spill", needed / 2 },
+		{ "memory", needed + 64 },
+	};
+
+	Config->set_export_timespans_in_one_pass (true);
+
+	for (size_t n = 0; n < sizeof (runs) / sizeof (runs[0]); ++n) {
+		Config->set_export_analysis_memory_limit (runs[n].limit);
+		double const t = run (session, Glib::build_filename (dir, string_compose ("export-%1", n)), length, n_ranges);
+		cout << string_compose ("%1 x %2 sec, %3 (%4 MB): %5 sec, max RSS %6 MB\n",
+		                        n_ranges, seconds, runs[n].name, runs[n].limit, t, max_rss_mb ());
+	}
+
+	AudioEngine::instance ()->remove_session ();
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
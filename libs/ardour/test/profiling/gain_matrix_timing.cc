@@ -0,0 +1,103 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "pbd/compose.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+
+#include "gain_matrix_reference.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace GainMatrixReference;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare the time used by the VBAP panner's previous per-signal
+ * distribution with the GainMatrix, for n_signals inputs of which half
+ * are moving, across speaker counts.
+ */
+static void
+run (uint32_t n_signals, uint32_t n_cycles)
+{
+	pframes_t const nframes = 512;
+
+	BufferSet ibufs;
+	ibufs.ensure_buffers (DataType::AUDIO, n_signals, nframes);
+	fill_inputs (ibufs, n_signals, nframes, 0);
+
+	cout << string_compose ("VBAP distribution, %1 signals, %2 x %3 samples, half of them moving [us]\n", n_signals, n_cycles, nframes);
+	cout << "speakers: per-signal / matrix\n";
+
+	static const uint32_t speakers[] = { 8, 16, 24, 32, 64 };
+
+	for (size_t s = 0; s < sizeof (speakers) / sizeof (uint32_t); ++s) {
+		uint32_t const n_speakers = speakers[s];
+
+		BufferSet obufs;
+		obufs.ensure_buffers (DataType::AUDIO, n_speakers, nframes);
+
+		vector<RefSignal> signals (n_signals, RefSignal (n_speakers));
+		GainMatrix        matrix;
+		matrix.configure (n_signals, n_speakers);
+
+		PBD::microseconds_t t[2] = { 0, 0 };
+
+		for (int pass = 0; pass < 2; ++pass) {
+			for (uint32_t n = 0; n < n_signals; ++n) {
+				signals[n] = RefSignal (n_speakers);
+			}
+			matrix.reset ();
+
+			for (uint32_t cycle = 0; cycle < n_cycles; ++cycle) {
+				for (uint32_t n = 0; n < n_signals; ++n) {
+					double const speed = (n & 1) ? .001 : 0;
+					place (signals[n], n / (double)n_signals + speed * cycle, n_speakers);
+				}
+
+				obufs.silence (nframes, 0);
+
+				PBD::microseconds_t const t0 = PBD::get_microseconds ();
+				if (pass == 0) {
+					for (uint32_t n = 0; n < n_signals; ++n) {
+						ref_distribute_one (signals[n], ibufs.get_audio (n).data (), obufs, 1.0, nframes);
+					}
+				} else {
+					set_targets (matrix, signals, 1.0);
+					matrix.apply (ibufs, obufs, nframes);
+				}
+				t[pass] += PBD::get_microseconds () - t0;
+			}
+		}
+
+		cout << string_compose ("%1: %2 / %3\n", n_speakers, t[0], t[1]);
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	uint32_t n_signals = 100;
+	uint32_t n_cycles  = 500;
+
+	if (argc > 1) {
+		n_signals = atoi (argv[1]);
+	}
+	if (argc > 2) {
+		n_cycles = atoi (argv[2]);
+	}
+
+	if (n_signals == 0 || n_cycles == 0) {
+		cerr << argv[0] << ": [signals] [cycles]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+
+	run (n_signals, n_cycles);
+
+	ARDOUR::cleanup ();
+
+	return 0;
+}
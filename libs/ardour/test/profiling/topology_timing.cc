@@ -0,0 +1,142 @@
+#include "test_ui.h"
+#include "test_util.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audio_port.h"
+#include "ardour/audioengine.h"
+#include "ardour/graph_edges.h"
+#include "ardour/io.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare a complete topological sort of the route graph with an
+ * incremental update after changing a single connection.
+ *
+ * n_routes busses are created, n_groups of them are sub-groups which
+ * are fed by all other busses. Then one bus at a time is moved to a
+ * different sub-group.
+ */
+static void
+run (Session* session, uint32_t n_routes, uint32_t n_groups, uint32_t n_changes)
+{
+	RouteList busses = session->new_audio_route (1, 1, 0, n_routes, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	assert (busses.size () == n_routes);
+
+	vector<std::shared_ptr<Route> > rl (busses.begin (), busses.end ());
+
+	for (uint32_t i = 0; i < n_routes; ++i) {
+		rl[i]->output ()->disconnect (0);
+	}
+	for (uint32_t i = n_groups; i < n_routes; ++i) {
+		std::shared_ptr<Route> g (rl[i % n_groups]);
+		rl[i]->output ()->connect (rl[i]->output ()->audio (0), g->input ()->audio (0)->name (), 0);
+	}
+
+	GraphNodeList nodes;
+	for (auto const& r : *session->get_routes ()) {
+		nodes.push_back (r);
+	}
+
+	GraphEdges edges;
+	GraphNodeList gnl (nodes);
+	if (!topological_sort (gnl, edges)) {
+		cerr << "Initial sort failed\n";
+		exit (EXIT_FAILURE);
+	}
+
+	TimingStats full;
+	TimingStats incremental;
+
+	srand (n_routes);
+
+	for (uint32_t c = 0; c < n_changes; ++c) {
+		uint32_t const         i    = n_groups + rand () % (n_routes - n_groups);
+		std::shared_ptr<Route> from = rl[i % n_groups];
+		std::shared_ptr<Route> to   = rl[rand () % n_groups];
+
+		rl[i]->output ()->disconnect (0);
+		rl[i]->output ()->connect (rl[i]->output ()->audio (0), to->input ()->audio (0)->name (), 0);
+
+		/* complete re-sort */
+		GraphEdges e_full;
+		gnl = nodes;
+		full.start ();
+		bool ok_full = topological_sort (gnl, e_full);
+		full.update ();
+
+		/* update the previous graph, both ends of the connection are dirty */
+		std::set<GraphVertex> dirty;
+		dirty.insert (rl[i]);
+		dirty.insert (from);
+		dirty.insert (to);
+
+		gnl = nodes;
+		incremental.start ();
+		bool ok_incr = topological_sort (gnl, edges, dirty);
+		incremental.update ();
+
+		if (!ok_full || !ok_incr || !edges.same_edges (e_full)) {
+			cerr << "Incremental and complete sort differ\n";
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	microseconds_t f_min, f_max, i_min, i_max;
+	double         f_avg, f_dev, i_avg, i_dev;
+
+	if (full.get_stats (f_min, f_max, f_avg, f_dev) && incremental.get_stats (i_min, i_max, i_avg, i_dev)) {
+		cout << string_compose ("%1 routes: full %2us (max %3us), incremental %4us (max %5us), speedup %6\n",
+		                        nodes.size (), f_avg, f_max, i_avg, i_max, i_avg > 0 ? f_avg / i_avg : 0);
+	}
+
+	std::shared_ptr<RouteList> rm (new RouteList (busses));
+	session->remove_routes (rm);
+}
+
+int
+main (int argc, char* argv[])
+{
+	uint32_t n_changes = 100;
+
+	if (argc > 1) {
+		n_changes = atoi (argv[1]);
+	}
+
+	if (n_changes < 1) {
+		cerr << "Syntax: " << argv[0] << " [changes]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI ();
+	create_and_start_dummy_backend ();
+
+	Session* session = load_session (Glib::build_filename (new_test_output_dir (), "topology_timing"), "topology_timing");
+
+	static const uint32_t n_routes[] = { 32, 64, 128, 256, 512 };
+
+	for (size_t n = 0; n < sizeof (n_routes) / sizeof (uint32_t); ++n) {
+		run (session, n_routes[n], n_routes[n] / 8, n_changes);
+	}
+
+	AudioEngine::instance ()->remove_session ();
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include "evoral/EventList.h"
+#include "evoral/midi_events.h"
+
+#include "ardour/rt_midibuffer.h"
+
+#include "rt_midibuffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RTMidiBufferTest);
+
+using namespace ARDOUR;
+
+static void
+note_on (Evoral::EventSink<samplepos_t>& dst, samplepos_t t, uint8_t note)
+{
+	uint8_t buf[3] = { MIDI_CMD_NOTE_ON, note, 100 };
+	dst.write (t, Evoral::MIDI_EVENT, 3, buf);
+}
+
+static void
+clear_list (Evoral::EventList<samplepos_t>& l)
+{
+	for (Evoral::EventList<samplepos_t>::iterator i = l.begin (); i != l.end (); ++i) {
+		delete *i;
+	}
+	l.clear ();
+}
+
+void
+RTMidiBufferTest::spliceTest ()
+{
+	RTMidiBuffer rtm;
+
+	for (samplepos_t t = 0; t < 50; t += 10) {
+		note_on (rtm, t, 60 + t / 10);
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 5, rtm.size ());
+
+	/* replace 10 and 20 by 15 and a sysex at 25 */
+	Evoral::EventList<samplepos_t> events;
+	uint8_t sysex[6] = { MIDI_CMD_COMMON_SYSEX, 0x7e, 0x01, 0x02, 0x03, MIDI_CMD_COMMON_SYSEX_END };
+
+	note_on (events, 15, 80);
+	events.write (25, Evoral::MIDI_EVENT, sizeof (sysex), sysex);
+
+	rtm.splice (10, 30, events);
+	clear_list (events);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 5, rtm.size ());
+
+	samplepos_t const times[] = { 0, 15, 25, 30, 40 };
+	for (size_t n = 0; n < 5; ++n) {
+		CPPUNIT_ASSERT_EQUAL (times[n], rtm[n].timestamp);
+	}
+
+	uint32_t       size;
+	uint8_t const* data = rtm.bytes (rtm[1], size);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 3, size);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 80, data[1]);
+
+	data = rtm.bytes (rtm[2], size);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) sizeof (sysex), size);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x7e, data[1]);
+
+	data = rtm.bytes (rtm[3], size);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 63, data[1]);
+
+	/* remove events without replacement */
+	rtm.splice (0, 20, events);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, rtm.size ());
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 25, rtm[0].timestamp);
+
+	/* insert into an empty range at the end */
+	note_on (events, 100, 90);
+	rtm.splice (50, 200, events);
+	clear_list (events);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 4, rtm.size ());
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 40, rtm[2].timestamp);
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 100, rtm[3].timestamp);
+}
+
+void
+RTMidiBufferTest::spliceGrowTest ()
+{
+	RTMidiBuffer rtm;
+
+	note_on (rtm, 0, 60);
+	note_on (rtm, 100000, 61);
+
+	/* more than the buffer's capacity */
+	Evoral::EventList<samplepos_t> events;
+	for (samplepos_t t = 1; t < 5000; ++t) {
+		note_on (events, t * 10, t % 128);
+	}
+
+	rtm.splice (1, 100000, events);
+	clear_list (events);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 5001, rtm.size ());
+
+	for (size_t n = 1; n < rtm.size (); ++n) {
+		CPPUNIT_ASSERT (rtm[n - 1].timestamp < rtm[n].timestamp);
+	}
+
+	uint32_t       size;
+	uint8_t const* data = rtm.bytes (rtm[5000], size);
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 100000, rtm[5000].timestamp);
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 61, data[1]);
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class RTMidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (RTMidiBufferTest);
+	CPPUNIT_TEST (spliceTest);
+	CPPUNIT_TEST (spliceGrowTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void spliceTest ();
+	void spliceGrowTest ();
+};
@@ -567,6 +567,12 @@ Track::seek (samplepos_t p, bool complete_refill)
 	return _disk_writer->seek (p, complete_refill);
 }
 
+void
+Track::read_ahead (ReadAhead& ra, boost::optional<samplepos_t> seek_to)
+{
+	_disk_reader->read_ahead (ra, seek_to);
+}
+
 bool
 Track::can_internal_playback_seek (samplecnt_t p)
 {
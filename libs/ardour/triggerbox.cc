@@ -1798,10 +1798,8 @@ AudioTrigger::setup_stretcher ()
 void
 AudioTrigger::drop_data ()
 {
-	for (auto& d : data) {
-		delete [] d;
-	}
 	data.clear ();
+	data.refs.clear ();
 }
 
 int
@@ -1809,22 +1807,23 @@ AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
 {
 	const uint32_t nchans = ar->n_channels();
 
-	data.length = ar->length_samples();
 	drop_data ();
+	data.length = ar->length_samples();
 
-	try {
-		for (uint32_t n = 0; n < nchans; ++n) {
-			data.push_back (new Sample[data.length]);
-			ar->read (data[n], 0, data.length, n);
-		}
-
-		set_name (ar->name());
+	/* many slots often use the same clip, share the data with them */
 
-	} catch (...) {
-		drop_data ();
-		return -1;
+	for (uint32_t n = 0; n < nchans; ++n) {
+		ClipSampleCache::EntryPtr e = ClipSampleCache::instance ().get (ar, n);
+		if (!e) {
+			drop_data ();
+			return -1;
+		}
+		data.refs.push_back (e);
+		data.push_back (e->data ());
 	}
 
+	set_name (ar->name());
+
 	return 0;
 }
 
@@ -1978,7 +1977,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 					 * the end of the region
 					 */
 
-					std::vector<Sample*> in(nchans);
+					std::vector<Sample const*> in(nchans);
 
 					for (uint32_t chn = 0; chn < nchans; ++chn) {
 						in[chn] = data[chn] + read_index;
@@ -2071,7 +2070,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 				uint32_t channel = chn %  data.size();
 				AudioBuffer& buf (bufs.get_audio (chn));
-				Sample* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				Sample const* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
 
 				gain_t gain;
 
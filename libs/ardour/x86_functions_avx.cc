@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/mix.h"
+
+#include <immintrin.h>
+
+#ifndef __AVX__
+#error "__AVX__ must be enabled for this module to work"
+#endif
+
+/**
+ * @brief x86-64 AVX optimized 1-pole gain ramp
+ *
+ * Same as default_apply_gain_ramp(): the distance to the target decays
+ * by (1 - coeff) every sample, so 8 consecutive gain values can be
+ * computed from a vector of powers of (1 - coeff).
+ *
+ * @param buf Pointer to buffer
+ * @param nframes Number of frames to process
+ * @param gain Initial gain
+ * @param target Target gain
+ * @param coeff Low pass filter coefficient
+ * @return float gain after the last sample
+ */
+float
+x86_avx_apply_gain_ramp(float *buf, uint32_t nframes, float gain, float target, float coeff)
+{
+	const float r = 1.f - coeff;
+	float delta = gain - target;
+
+	if (nframes >= 8) {
+		float pw[8];
+		pw[0] = 1.f;
+		for (int i = 1; i < 8; ++i) {
+			pw[i] = pw[i - 1] * r;
+		}
+
+		const __m256 vtarget = _mm256_set1_ps(target);
+		const __m256 vr8 = _mm256_set1_ps(pw[7] * r);
+		__m256 vdelta = _mm256_mul_ps(_mm256_set1_ps(delta), _mm256_loadu_ps(pw));
+
+		while (nframes >= 8) {
+			__m256 x = _mm256_loadu_ps(buf);
+			x = _mm256_mul_ps(x, _mm256_add_ps(vtarget, vdelta));
+			_mm256_storeu_ps(buf, x);
+			vdelta = _mm256_mul_ps(vdelta, vr8);
+
+			buf += 8;
+			nframes -= 8;
+		}
+
+		delta = _mm256_cvtss_f32(vdelta);
+	}
+
+	_mm256_zeroupper();
+
+	return default_apply_gain_ramp(buf, nframes, target + delta, target, coeff);
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to write one channel of an
+ * interleaved buffer. Only stereo is vectorized.
+ */
+void
+x86_avx_interleave(float *dst, const float *src, uint32_t nframes, uint32_t chn, uint32_t n_chn)
+{
+	if (n_chn != 2) {
+		default_interleave(dst, src, nframes, chn, n_chn);
+		return;
+	}
+
+	float *out = dst;
+
+	if (chn == 0) {
+		while (nframes >= 4) {
+			__m128 s = _mm_loadu_ps(src);
+			__m128 d0 = _mm_loadu_ps(out);
+			__m128 d1 = _mm_loadu_ps(out + 4);
+			d0 = _mm_blend_ps(d0, _mm_unpacklo_ps(s, s), 0x5);
+			d1 = _mm_blend_ps(d1, _mm_unpackhi_ps(s, s), 0x5);
+			_mm_storeu_ps(out, d0);
+			_mm_storeu_ps(out + 4, d1);
+			src += 4;
+			out += 8;
+			nframes -= 4;
+		}
+	} else {
+		while (nframes >= 4) {
+			__m128 s = _mm_loadu_ps(src);
+			__m128 d0 = _mm_loadu_ps(out);
+			__m128 d1 = _mm_loadu_ps(out + 4);
+			d0 = _mm_blend_ps(d0, _mm_unpacklo_ps(s, s), 0xA);
+			d1 = _mm_blend_ps(d1, _mm_unpackhi_ps(s, s), 0xA);
+			_mm_storeu_ps(out, d0);
+			_mm_storeu_ps(out + 4, d1);
+			src += 4;
+			out += 8;
+			nframes -= 4;
+		}
+	}
+
+	_mm256_zeroupper();
+
+	default_interleave(out, src, nframes, chn, n_chn);
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to read one channel of an
+ * interleaved buffer. Only stereo is vectorized.
+ */
+void
+x86_avx_deinterleave(float *dst, const float *src, uint32_t nframes, uint32_t chn, uint32_t n_chn)
+{
+	if (n_chn != 2) {
+		default_deinterleave(dst, src, nframes, chn, n_chn);
+		return;
+	}
+
+	if (chn == 0) {
+		while (nframes >= 4) {
+			__m128 s0 = _mm_loadu_ps(src);
+			__m128 s1 = _mm_loadu_ps(src + 4);
+			_mm_storeu_ps(dst, _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0)));
+			src += 8;
+			dst += 4;
+			nframes -= 4;
+		}
+	} else {
+		while (nframes >= 4) {
+			__m128 s0 = _mm_loadu_ps(src);
+			__m128 s1 = _mm_loadu_ps(src + 4);
+			_mm_storeu_ps(dst, _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3, 1, 3, 1)));
+			src += 8;
+			dst += 4;
+			nframes -= 4;
+		}
+	}
+
+	_mm256_zeroupper();
+
+	default_deinterleave(dst, src, nframes, chn, n_chn);
+}
+
+/**
+ * @brief x86-64 AVX optimized float to clamped int16 conversion,
+ * rounding to nearest (like lrintf)
+ */
+void
+x86_avx_float_to_int16(int16_t *dst, const float *src, uint32_t nframes)
+{
+	const __m256 scale = _mm256_set1_ps(32768.f);
+	const __m256 vmin = _mm256_set1_ps(-32768.f);
+	const __m256 vmax = _mm256_set1_ps(32767.f);
+
+	while (nframes >= 8) {
+		__m256 x = _mm256_mul_ps(_mm256_loadu_ps(src), scale);
+		x = _mm256_min_ps(_mm256_max_ps(x, vmin), vmax);
+		__m256i i32 = _mm256_cvtps_epi32(x);
+		__m128i i16 = _mm_packs_epi32(_mm256_castsi256_si128(i32), _mm256_extractf128_si256(i32, 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), i16);
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper();
+
+	default_float_to_int16(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX optimized int16 to float conversion
+ */
+void
+x86_avx_int16_to_float(float *dst, const int16_t *src, uint32_t nframes)
+{
+	const __m256 scale = _mm256_set1_ps(1.f / 32768.f);
+
+	while (nframes >= 8) {
+		__m128i i16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+		__m128i lo = _mm_cvtepi16_epi32(i16);
+		__m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(i16, 8));
+		__m256i i32 = _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		_mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_cvtepi32_ps(i32), scale));
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper();
+
+	default_int16_to_float(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX optimized float to clamped (right-aligned) int24
+ * conversion, rounding to nearest (like lrintf)
+ */
+void
+x86_avx_float_to_int24(int32_t *dst, const float *src, uint32_t nframes)
+{
+	const __m256 scale = _mm256_set1_ps(8388608.f);
+	const __m256 vmin = _mm256_set1_ps(-8388608.f);
+	const __m256 vmax = _mm256_set1_ps(8388607.f);
+
+	while (nframes >= 8) {
+		__m256 x = _mm256_mul_ps(_mm256_loadu_ps(src), scale);
+		x = _mm256_min_ps(_mm256_max_ps(x, vmin), vmax);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_cvtps_epi32(x));
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper();
+
+	default_float_to_int24(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX optimized (right-aligned) int24 to float conversion
+ */
+void
+x86_avx_int24_to_float(float *dst, const int32_t *src, uint32_t nframes)
+{
+	const __m256 scale = _mm256_set1_ps(1.f / 8388608.f);
+
+	while (nframes >= 8) {
+		__m256i i32 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+		_mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_cvtepi32_ps(i32), scale));
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper();
+
+	default_int24_to_float(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX optimized polarity inversion (flips the sign bit)
+ */
+void
+x86_avx_invert_polarity(float *buf, uint32_t nframes)
+{
+	const __m256 sign = _mm256_set1_ps(-0.f);
+
+	while (nframes >= 16) {
+		__m256 x0 = _mm256_loadu_ps(buf);
+		__m256 x1 = _mm256_loadu_ps(buf + 8);
+		_mm256_storeu_ps(buf, _mm256_xor_ps(x0, sign));
+		_mm256_storeu_ps(buf + 8, _mm256_xor_ps(x1, sign));
+		buf += 16;
+		nframes -= 16;
+	}
+
+	while (nframes >= 8) {
+		_mm256_storeu_ps(buf, _mm256_xor_ps(_mm256_loadu_ps(buf), sign));
+		buf += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper();
+
+	default_invert_polarity(buf, nframes);
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to mix a polarity inverted buffer
+ * (dst -= src)
+ */
+void
+x86_avx_mix_buffers_inverted(float *dst, const float *src, uint32_t nframes)
+{
+	while (nframes >= 16) {
+		__m256 d0 = _mm256_loadu_ps(dst);
+		__m256 d1 = _mm256_loadu_ps(dst + 8);
+		d0 = _mm256_sub_ps(d0, _mm256_loadu_ps(src));
+		d1 = _mm256_sub_ps(d1, _mm256_loadu_ps(src + 8));
+		_mm256_storeu_ps(dst, d0);
+		_mm256_storeu_ps(dst + 8, d1);
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	while (nframes >= 8) {
+		_mm256_storeu_ps(dst, _mm256_sub_ps(_mm256_loadu_ps(dst), _mm256_loadu_ps(src)));
+		src += 8;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper();
+
+	default_mix_buffers_inverted(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to mix a buffer with a linear gain ramp
+ * @see default_mix_buffers_with_gain_ramp
+ */
+void
+x86_avx_mix_buffers_with_gain_ramp(float *dst, const float *src, uint32_t nframes, float gain, float target)
+{
+	if (nframes == 0) {
+		return;
+	}
+
+	const float delta = (target - gain) / nframes;
+	uint32_t i = 0;
+
+	if (nframes >= 8) {
+		const __m256 vdelta8 = _mm256_set1_ps(8.f * delta);
+		__m256 vgain = _mm256_add_ps(_mm256_set1_ps(gain),
+		                             _mm256_mul_ps(_mm256_set1_ps(delta), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7)));
+
+		for (; i + 8 <= nframes; i += 8) {
+			__m256 d = _mm256_loadu_ps(dst + i);
+			d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(src + i), vgain));
+			_mm256_storeu_ps(dst + i, d);
+			vgain = _mm256_add_ps(vgain, vdelta8);
+		}
+	}
+
+	_mm256_zeroupper();
+
+	for (; i < nframes; ++i) {
+		dst[i] += src[i] * (gain + i * delta);
+	}
+}
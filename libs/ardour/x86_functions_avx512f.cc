@@ -1139,4 +1139,209 @@ x86_avx512f_copy_vector(float *dst, const float *src, uint32_t nframes)
 	_mm256_zeroupper(); // zeros the upper portion of YMM register
 }
 
+
+/**
+ * @brief x86-64 AVX-512F optimized 1-pole gain ramp
+ * @see x86_avx_apply_gain_ramp
+ */
+float
+x86_avx512f_apply_gain_ramp(float *buf, uint32_t nframes, float gain, float target, float coeff)
+{
+	const float r = 1.f - coeff;
+	float delta = gain - target;
+
+	if (nframes >= 16) {
+		float pw[16];
+		pw[0] = 1.f;
+		for (int i = 1; i < 16; ++i) {
+			pw[i] = pw[i - 1] * r;
+		}
+
+		const __m512 vtarget = _mm512_set1_ps(target);
+		const __m512 vr16 = _mm512_set1_ps(pw[15] * r);
+		__m512 vdelta = _mm512_mul_ps(_mm512_set1_ps(delta), _mm512_loadu_ps(pw));
+
+		while (nframes >= 16) {
+			__m512 x = _mm512_loadu_ps(buf);
+			x = _mm512_mul_ps(x, _mm512_add_ps(vtarget, vdelta));
+			_mm512_storeu_ps(buf, x);
+			vdelta = _mm512_mul_ps(vdelta, vr16);
+
+			buf += 16;
+			nframes -= 16;
+		}
+
+		delta = _mm512_cvtss_f32(vdelta);
+	}
+
+	_mm256_zeroupper();
+
+	return default_apply_gain_ramp(buf, nframes, target + delta, target, coeff);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized float to clamped int16 conversion
+ */
+void
+x86_avx512f_float_to_int16(int16_t *dst, const float *src, uint32_t nframes)
+{
+	const __m512 scale = _mm512_set1_ps(32768.f);
+	const __m512 vmin = _mm512_set1_ps(-32768.f);
+	const __m512 vmax = _mm512_set1_ps(32767.f);
+
+	while (nframes >= 16) {
+		__m512 x = _mm512_mul_ps(_mm512_loadu_ps(src), scale);
+		x = _mm512_min_ps(_mm512_max_ps(x, vmin), vmax);
+		__m256i i16 = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(x));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), i16);
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper();
+
+	default_float_to_int16(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized int16 to float conversion
+ */
+void
+x86_avx512f_int16_to_float(float *dst, const int16_t *src, uint32_t nframes)
+{
+	const __m512 scale = _mm512_set1_ps(1.f / 32768.f);
+
+	while (nframes >= 16) {
+		__m256i i16 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+		__m512 x = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(i16));
+		_mm512_storeu_ps(dst, _mm512_mul_ps(x, scale));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper();
+
+	default_int16_to_float(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized float to clamped int24 conversion
+ */
+void
+x86_avx512f_float_to_int24(int32_t *dst, const float *src, uint32_t nframes)
+{
+	const __m512 scale = _mm512_set1_ps(8388608.f);
+	const __m512 vmin = _mm512_set1_ps(-8388608.f);
+	const __m512 vmax = _mm512_set1_ps(8388607.f);
+
+	while (nframes >= 16) {
+		__m512 x = _mm512_mul_ps(_mm512_loadu_ps(src), scale);
+		x = _mm512_min_ps(_mm512_max_ps(x, vmin), vmax);
+		_mm512_storeu_si512(dst, _mm512_cvtps_epi32(x));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper();
+
+	default_float_to_int24(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized int24 to float conversion
+ */
+void
+x86_avx512f_int24_to_float(float *dst, const int32_t *src, uint32_t nframes)
+{
+	const __m512 scale = _mm512_set1_ps(1.f / 8388608.f);
+
+	while (nframes >= 16) {
+		__m512 x = _mm512_cvtepi32_ps(_mm512_loadu_si512(src));
+		_mm512_storeu_ps(dst, _mm512_mul_ps(x, scale));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper();
+
+	default_int24_to_float(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized polarity inversion
+ */
+void
+x86_avx512f_invert_polarity(float *buf, uint32_t nframes)
+{
+	const __m512i sign = _mm512_set1_epi32(static_cast<int>(0x80000000));
+
+	while (nframes >= 16) {
+		__m512i x = _mm512_castps_si512(_mm512_loadu_ps(buf));
+		_mm512_storeu_ps(buf, _mm512_castsi512_ps(_mm512_xor_si512(x, sign)));
+		buf += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper();
+
+	default_invert_polarity(buf, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized routine to mix a polarity inverted buffer
+ */
+void
+x86_avx512f_mix_buffers_inverted(float *dst, const float *src, uint32_t nframes)
+{
+	while (nframes >= 16) {
+		__m512 d = _mm512_sub_ps(_mm512_loadu_ps(dst), _mm512_loadu_ps(src));
+		_mm512_storeu_ps(dst, d);
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	_mm256_zeroupper();
+
+	default_mix_buffers_inverted(dst, src, nframes);
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized routine to mix a buffer with a linear gain ramp
+ * @see default_mix_buffers_with_gain_ramp
+ */
+void
+x86_avx512f_mix_buffers_with_gain_ramp(float *dst, const float *src, uint32_t nframes, float gain, float target)
+{
+	if (nframes == 0) {
+		return;
+	}
+
+	const float delta = (target - gain) / nframes;
+	uint32_t i = 0;
+
+	if (nframes >= 16) {
+		const __m512 vdelta16 = _mm512_set1_ps(16.f * delta);
+		const __m512 vidx = _mm512_setr_ps(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+		__m512 vgain = _mm512_fmadd_ps(_mm512_set1_ps(delta), vidx, _mm512_set1_ps(gain));
+
+		for (; i + 16 <= nframes; i += 16) {
+			__m512 d = _mm512_loadu_ps(dst + i);
+			d = _mm512_fmadd_ps(_mm512_loadu_ps(src + i), vgain, d);
+			_mm512_storeu_ps(dst + i, d);
+			vgain = _mm512_add_ps(vgain, vdelta16);
+		}
+	}
+
+	_mm256_zeroupper();
+
+	for (; i < nframes; ++i) {
+		dst[i] += src[i] * (gain + i * delta);
+	}
+}
+
 #endif // FPU_AVX512F_SUPPORT
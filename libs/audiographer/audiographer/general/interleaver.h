@@ -5,6 +5,7 @@
 #include "audiographer/types.h"
 #include "audiographer/sink.h"
 #include "audiographer/exception.h"
+#include "audiographer/routines.h"
 #include "audiographer/throwing.h"
 #include "audiographer/utils/listed_source.h"
 
@@ -112,9 +113,7 @@ class /*LIBAUDIOGRAPHER_API*/ Interleaver
 			throw Exception (*this, "Too many samples given to an input");
 		}
 
-		for (unsigned int i = 0; i < c.samples(); ++i) {
-			buffer[channel + (channels * i)] = c.data()[i];
-		}
+		interleave_into (buffer, c.data(), c.samples(), channel);
 
 		samplecnt_t const ready_samples = ready_to_output();
 		if (ready_samples) {
@@ -124,6 +123,19 @@ class /*LIBAUDIOGRAPHER_API*/ Interleaver
 		}
 	}
 
+	void interleave_into (float * dst, float const * src, samplecnt_t samples, unsigned int channel)
+	{
+		Routines::interleave (dst, src, samples, channel, channels);
+	}
+
+	template<typename S>
+	void interleave_into (S * dst, S const * src, samplecnt_t samples, unsigned int channel)
+	{
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			dst[channel + (channels * i)] = src[i];
+		}
+	}
+
 	samplecnt_t ready_to_output()
 	{
 		samplecnt_t ready_samples = inputs[0]->samples();
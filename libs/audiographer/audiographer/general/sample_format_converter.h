@@ -63,6 +63,7 @@ class LIBAUDIOGRAPHER_API SampleFormatConverter
 	TOut *       data_out;
 
 	bool         clip_floats;
+	bool         direct_int16; // undithered 16 bit, use Routines::float_to_int16
 
 };
 
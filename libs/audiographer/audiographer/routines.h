@@ -18,9 +18,15 @@ class LIBAUDIOGRAPHER_API Routines
 
 	typedef float (*compute_peak_t)          (float const *, uint_type, float);
 	typedef void  (*apply_gain_to_buffer_t)  (float *, uint_type, float);
+	typedef void  (*interleave_t)            (float *, float const *, uint_type, uint_type, uint_type);
+	typedef void  (*deinterleave_t)          (float *, float const *, uint_type, uint_type, uint_type);
+	typedef void  (*float_to_int16_t)        (int16_t *, float const *, uint_type);
 
 	static void override_compute_peak         (compute_peak_t func)         { _compute_peak = func; }
 	static void override_apply_gain_to_buffer (apply_gain_to_buffer_t func) { _apply_gain_to_buffer = func; }
+	static void override_interleave           (interleave_t func)           { _interleave = func; }
+	static void override_deinterleave         (deinterleave_t func)         { _deinterleave = func; }
+	static void override_float_to_int16       (float_to_int16_t func)       { _float_to_int16 = func; }
 
 	/** Computes peak in float buffer
 	  * \n RT safe
@@ -45,6 +51,43 @@ class LIBAUDIOGRAPHER_API Routines
 		(*_apply_gain_to_buffer) (data, samples, gain);
 	}
 
+	/** Writes one channel of an interleaved buffer
+	 * \n RT safe
+	 * \param dst interleaved buffer holding \a samples * \a n_channels values
+	 * \param src non-interleaved channel data
+	 * \param samples number of samples per channel
+	 * \param channel channel index in \a dst
+	 * \param n_channels total number of channels in \a dst
+	 */
+	static inline void interleave (float * dst, float const * src, uint_type samples, uint_type channel, uint_type n_channels)
+	{
+		(*_interleave) (dst, src, samples, channel, n_channels);
+	}
+
+	/** Reads one channel from an interleaved buffer
+	 * \n RT safe
+	 * \param dst non-interleaved channel data
+	 * \param src interleaved buffer holding \a samples * \a n_channels values
+	 * \param samples number of samples per channel
+	 * \param channel channel index in \a src
+	 * \param n_channels total number of channels in \a src
+	 */
+	static inline void deinterleave (float * dst, float const * src, uint_type samples, uint_type channel, uint_type n_channels)
+	{
+		(*_deinterleave) (dst, src, samples, channel, n_channels);
+	}
+
+	/** Converts float to clamped int16, rounding to nearest, without dither
+	 * \n RT safe
+	 * \param dst output buffer
+	 * \param src input buffer
+	 * \param samples number of samples to convert
+	 */
+	static inline void float_to_int16 (int16_t * dst, float const * src, uint_type samples)
+	{
+		(*_float_to_int16) (dst, src, samples);
+	}
+
   private:
 	static inline float default_compute_peak (float const * data, uint_type samples, float current_peak)
 	{
@@ -62,8 +105,35 @@ class LIBAUDIOGRAPHER_API Routines
 		}
 	}
 
+	static inline void default_interleave (float * dst, float const * src, uint_type samples, uint_type channel, uint_type n_channels)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			dst[i * n_channels + channel] = src[i];
+		}
+	}
+
+	static inline void default_deinterleave (float * dst, float const * src, uint_type samples, uint_type channel, uint_type n_channels)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			dst[i] = src[i * n_channels + channel];
+		}
+	}
+
+	static inline void default_float_to_int16 (int16_t * dst, float const * src, uint_type samples)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			float v = src[i] * 32768.f;
+			if (v > 32767.f) { v = 32767.f; }
+			if (v < -32768.f) { v = -32768.f; }
+			dst[i] = (int16_t) lrintf (v);
+		}
+	}
+
 	static compute_peak_t          _compute_peak;
 	static apply_gain_to_buffer_t  _apply_gain_to_buffer;
+	static interleave_t            _interleave;
+	static deinterleave_t          _deinterleave;
+	static float_to_int16_t        _float_to_int16;
 };
 
 } // namespace
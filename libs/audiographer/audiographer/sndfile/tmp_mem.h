@@ -0,0 +1,280 @@
+#ifndef AUDIOGRAPHER_TMP_MEM_H
+#define AUDIOGRAPHER_TMP_MEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "pbd/signals.h"
+
+#include "audiographer/flag_debuggable.h"
+#include "audiographer/sink.h"
+#include "audiographer/throwing.h"
+#include "audiographer/types.h"
+#include "audiographer/utils/listed_source.h"
+
+#include "tmp_file_sync.h"
+
+namespace AudioGrapher
+{
+
+/** Amount of memory that may be used by a group of TmpMem instances.
+ *
+ * All TmpMem that share a budget together never keep more than the
+ * given number of bytes in RAM. Memory is returned to the budget when
+ * a TmpMem is destroyed.
+ */
+class TmpMemBudget
+{
+  public:
+	TmpMemBudget (size_t bytes) : _available (bytes) {}
+
+	/// Take \a bytes from the budget, \return false if not enough is left
+	bool reserve (size_t bytes)
+	{
+		size_t available = _available.load ();
+		do {
+			if (available < bytes) {
+				return false;
+			}
+		} while (!_available.compare_exchange_weak (available, available - bytes));
+		return true;
+	}
+
+	void release (size_t bytes) { _available.fetch_add (bytes); }
+
+	size_t available () const { return _available.load (); }
+
+  private:
+	std::atomic<size_t> _available;
+};
+
+/** In-memory replacement for a TmpFile.
+ *
+ * Data is kept in RAM blocks which are allocated on demand, as long as
+ * the shared \a budget allows for it. Once the budget is used up (or
+ * memory cannot be allocated), the remainder is spilled to a temporary
+ * file, so arbitrarily long input can be stored.
+ *
+ * process() allocates memory, this class is not realtime safe.
+ */
+template<typename T = DefaultSampleType>
+class TmpMem
+	: public Sink<T>
+	, public ListedSource<T>
+	, public Throwing<>
+	, public FlagDebuggable<>
+{
+  public:
+
+	static const samplecnt_t default_block_size = 1048576; // samples
+
+	/** \a spill_template must match the requirements for mkstemp, i.e. end in "XXXXXX".
+	 * If it is empty, an anonymous temporary file is used for spilling.
+	 * Memory is taken from \a budget in blocks of \a block_samples (interleaved) samples.
+	 */
+	TmpMem (ChannelCount channels, samplecnt_t samplerate, std::shared_ptr<TmpMemBudget> budget,
+	        std::string const & spill_template = std::string (), int spill_format = SF_FORMAT_RAW | SF_FORMAT_FLOAT,
+	        samplecnt_t block_samples = default_block_size)
+		: _channels (channels)
+		, _samplerate (samplerate)
+		, _block_size (std::max<samplecnt_t> (channels, block_samples - (block_samples % channels)))
+		, _budget (budget)
+		, _full (!budget)
+		, _spill_template (spill_template)
+		, _spill_format (spill_format)
+		, _samples_written (0)
+		, _samples_in_memory (0)
+		, _read_position (0)
+	{
+		add_supported_flag (ProcessContext<T>::EndOfInput);
+	}
+
+	~TmpMem ()
+	{
+		for (typename std::vector<T*>::iterator i = _blocks.begin (); i != _blocks.end (); ++i) {
+			delete [] *i;
+		}
+		if (_budget) {
+			_budget->release (_blocks.size () * _block_size * sizeof (T));
+		}
+	}
+
+	/// Stores data, emits FileWritten and FileFlushed at the end of input
+	void process (ProcessContext<T> const & c)
+	{
+		check_flags (*this, c);
+
+		if (throw_level (ThrowStrict) && c.channels () != _channels) {
+			throw Exception (*this, boost::str (boost::format
+				("Wrong number of channels given to process(), %1% instead of %2%")
+				% c.channels () % _channels));
+		}
+
+		samplecnt_t const stored = store (c.data (), c.samples ());
+
+		if (stored < c.samples ()) {
+			spill (c.data () + stored, c.samples () - stored);
+		}
+
+		_samples_written += c.samples ();
+
+		if (c.has_flag (ProcessContext<T>::EndOfInput)) {
+			if (_spill) {
+				_spill->writeSync ();
+			}
+			FileWritten ();
+			FileFlushed ();
+		}
+	}
+
+	using Sink<T>::process;
+
+	/** Read data into buffer in \a context, only the data is modified (not sample count)
+	 *  Note that the data read is output to the outputs, as well as read into the context
+	 *  \return number of samples read
+	 */
+	samplecnt_t read (ProcessContext<T> & context)
+	{
+		if (throw_level (ThrowStrict) && context.channels () != _channels) {
+			throw Exception (*this, boost::str (boost::format
+				("Wrong number of channels given to process(), %1% instead of %2%")
+				% context.channels () % _channels));
+		}
+
+		T*          dst        = context.data ();
+		samplecnt_t to_read    = context.samples ();
+		samplecnt_t samples_read = 0;
+
+		while (to_read > 0 && _read_position < _samples_in_memory) {
+			size_t const      block  = _read_position / _block_size;
+			samplecnt_t const offset = _read_position % _block_size;
+			samplecnt_t const n      = std::min (to_read, std::min (_block_size - offset, _samples_in_memory - _read_position));
+
+			memcpy (dst + samples_read, _blocks[block] + offset, n * sizeof (T));
+
+			samples_read   += n;
+			to_read        -= n;
+			_read_position += n;
+		}
+
+		if (to_read > 0 && _spill) {
+			SndfileHandle& sf = *_spill;
+			samplecnt_t const n = sf.read (dst + samples_read, to_read);
+			samples_read   += n;
+			_read_position += n;
+		}
+
+		ProcessContext<T> c_out = context.beginning (samples_read);
+
+		if (samples_read < context.samples ()) {
+			c_out.set_flag (ProcessContext<T>::EndOfInput);
+		}
+		this->output (c_out);
+		return samples_read;
+	}
+
+	/// Restart reading from the beginning
+	void rewind ()
+	{
+		_read_position = 0;
+		if (_spill) {
+			_spill->seek (0, SEEK_SET);
+		}
+	}
+
+	samplecnt_t get_samples_written () const { return _samples_written; }
+
+	/// true if some data did not fit in memory and was written to disk
+	bool spilled () const { return (bool) _spill; }
+
+	/* Same semantics as TmpFile's signals, both are emitted from process() */
+	PBD::Signal0<void> FileWritten;
+	PBD::Signal0<void> FileFlushed;
+
+  private:
+	samplecnt_t store (T const * data, samplecnt_t samples)
+	{
+		samplecnt_t stored = 0;
+
+		/* once data was spilled, everything that follows has to go
+		 * to the file as well, to keep the order for read()
+		 */
+		while (stored < samples && !_full) {
+			size_t const block = _samples_in_memory / _block_size;
+
+			if (block == _blocks.size ()) {
+				size_t const bytes = _block_size * sizeof (T);
+				if (!_budget->reserve (bytes)) {
+					_full = true;
+					break;
+				}
+				T* b = new (std::nothrow) T[_block_size];
+				if (!b) {
+					_budget->release (bytes);
+					_full = true;
+					break;
+				}
+				_blocks.push_back (b);
+			}
+
+			samplecnt_t const offset = _samples_in_memory % _block_size;
+			samplecnt_t const n      = std::min (samples - stored, _block_size - offset);
+
+			memcpy (_blocks[block] + offset, data + stored, n * sizeof (T));
+
+			stored             += n;
+			_samples_in_memory += n;
+		}
+		return stored;
+	}
+
+	void spill (T const * data, samplecnt_t samples)
+	{
+		if (!_spill) {
+			if (_spill_template.empty ()) {
+				_spill.reset (new TmpFileSync<T> (_spill_format, _channels, _samplerate));
+			} else {
+				std::vector<char> path (_spill_template.begin (), _spill_template.end ());
+				path.push_back ('\0');
+				_spill.reset (new TmpFileSync<T> (&path[0], _spill_format, _channels, _samplerate));
+			}
+		}
+
+		SndfileHandle& sf = *_spill;
+		samplecnt_t const written = sf.write (data, samples);
+
+		if (throw_level (ThrowProcess) && written != samples) {
+			throw Exception (*this, boost::str (boost::format
+				("Could not write data to temporary file (%1%)")
+				% sf.strError ()));
+		}
+	}
+
+	ChannelCount   _channels;
+	samplecnt_t    _samplerate;
+	samplecnt_t    _block_size;
+
+	std::shared_ptr<TmpMemBudget> _budget;
+	bool           _full;
+
+	std::string    _spill_template;
+	int            _spill_format;
+
+	std::vector<T*> _blocks;
+	std::shared_ptr<TmpFileSync<T> > _spill;
+
+	samplecnt_t    _samples_written;
+	samplecnt_t    _samples_in_memory;
+	samplecnt_t    _read_position;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_TMP_MEM_H
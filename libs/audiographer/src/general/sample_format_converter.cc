@@ -22,6 +22,7 @@
 #include "audiographer/general/sample_format_converter.h"
 
 #include "audiographer/exception.h"
+#include "audiographer/routines.h"
 #include "audiographer/type_utils.h"
 #include "private/gdither/gdither.h"
 
@@ -36,7 +37,8 @@ SampleFormatConverter<TOut>::SampleFormatConverter (ChannelCount channels) :
   dither (0),
   data_out_size (0),
   data_out (0),
-  clip_floats (false)
+  clip_floats (false),
+  direct_int16 (false)
 {
 }
 
@@ -78,6 +80,7 @@ SampleFormatConverter<int16_t>::init (samplecnt_t max_samples, int type, int dat
 	}
 	init_common (max_samples);
 	dither = gdither_new ((GDitherType) type, channels, GDither16bit, data_width);
+	direct_int16 = ((GDitherType) type == GDitherNone && data_width == 16);
 }
 
 template <>
@@ -127,6 +130,7 @@ SampleFormatConverter<TOut>::reset()
 	data_out = 0;
 
 	clip_floats = false;
+	direct_int16 = false;
 }
 
 /* Basic const version of process() */
@@ -150,6 +154,28 @@ SampleFormatConverter<TOut>::process (ProcessContext<float> const & c_in)
 	this->output (c_out);
 }
 
+/* template specialization for int16_t, without dither all channels
+ * are converted alike, and can be processed in one go */
+template<>
+void
+SampleFormatConverter<int16_t>::process (ProcessContext<float> const & c_in)
+{
+	float const * const data = c_in.data();
+
+	check_sample_and_channel_count (c_in.samples (), c_in.channels ());
+
+	if (direct_int16) {
+		Routines::float_to_int16 (data_out, data, c_in.samples ());
+	} else {
+		for (uint32_t chn = 0; chn < c_in.channels(); ++chn) {
+			gdither_runf (dither, chn, c_in.samples_per_channel (), data, data_out);
+		}
+	}
+
+	ProcessContext<int16_t> c_out(c_in, data_out);
+	this->output (c_out);
+}
+
 /* Basic non-const version of process(), calls the const one */
 template<typename TOut>
 void
@@ -0,0 +1,105 @@
+#include "tests/utils.h"
+#include "audiographer/sndfile/tmp_mem.h"
+
+using namespace AudioGrapher;
+
+class TmpMemTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (TmpMemTest);
+  CPPUNIT_TEST (testProcess);
+  CPPUNIT_TEST (testSpill);
+  CPPUNIT_TEST (testSharedBudget);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		samples = 128;
+		random_data = TestUtils::init_random_data(samples);
+	}
+
+	void tearDown()
+	{
+		delete [] random_data;
+	}
+
+	void testProcess()
+	{
+		uint32_t channels = 2;
+		std::shared_ptr<TmpMemBudget> budget (new TmpMemBudget (samples * sizeof (float)));
+		mem.reset (new TmpMem<float>(channels, 44100, budget, std::string (), SF_FORMAT_RAW | SF_FORMAT_FLOAT, samples));
+		AllocatingProcessContext<float> c (random_data, samples, channels);
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		mem->process (c);
+
+		CPPUNIT_ASSERT (!mem->spilled ());
+		CPPUNIT_ASSERT_EQUAL (samples, mem->get_samples_written ());
+
+		TypeUtils<float>::zero_fill (c.data (), c.samples());
+
+		mem->rewind ();
+		CPPUNIT_ASSERT_EQUAL (samples, mem->read (c));
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, c.data(), c.samples()));
+	}
+
+	void testSpill()
+	{
+		uint32_t channels = 2;
+		/* only the first quarter fits in memory */
+		std::shared_ptr<TmpMemBudget> budget (new TmpMemBudget (samples / 4 * sizeof (float)));
+		mem.reset (new TmpMem<float>(channels, 44100, budget, std::string (), SF_FORMAT_RAW | SF_FORMAT_FLOAT, samples / 4));
+		AllocatingProcessContext<float> c (random_data, samples / 2, channels);
+		mem->process (c);
+		ConstProcessContext<float> c2 (random_data + samples / 2, samples / 2, channels);
+		c2().set_flag (ProcessContext<float>::EndOfInput);
+		mem->process (c2);
+
+		CPPUNIT_ASSERT (mem->spilled ());
+		CPPUNIT_ASSERT_EQUAL (samples, mem->get_samples_written ());
+
+		AllocatingProcessContext<float> out (samples, channels);
+		mem->rewind ();
+		CPPUNIT_ASSERT_EQUAL (samples, mem->read (out));
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, out.data(), samples));
+
+		/* reading again continues after the end of data */
+		CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 0, mem->read (out));
+	}
+
+	void testSharedBudget()
+	{
+		uint32_t channels = 2;
+		size_t const bytes = samples * sizeof (float);
+		std::shared_ptr<TmpMemBudget> budget (new TmpMemBudget (bytes));
+
+		/* the first one uses up the budget, the second has to spill */
+		mem.reset (new TmpMem<float>(channels, 44100, budget, std::string (), SF_FORMAT_RAW | SF_FORMAT_FLOAT, samples));
+		std::shared_ptr<TmpMem<float> > other (new TmpMem<float>(channels, 44100, budget, std::string (), SF_FORMAT_RAW | SF_FORMAT_FLOAT, samples));
+
+		ConstProcessContext<float> c (random_data, samples, channels);
+		c().set_flag (ProcessContext<float>::EndOfInput);
+		mem->process (c);
+		other->process (c);
+
+		CPPUNIT_ASSERT (!mem->spilled ());
+		CPPUNIT_ASSERT (other->spilled ());
+		CPPUNIT_ASSERT_EQUAL ((size_t) 0, budget->available ());
+
+		AllocatingProcessContext<float> out (samples, channels);
+		other->rewind ();
+		CPPUNIT_ASSERT_EQUAL (samples, other->read (out));
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, out.data(), samples));
+
+		/* memory is returned when the data is no longer needed */
+		mem.reset ();
+		CPPUNIT_ASSERT_EQUAL (bytes, budget->available ());
+	}
+
+  private:
+	std::shared_ptr<TmpMem<float> > mem;
+
+	float * random_data;
+	samplecnt_t samples;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TmpMemTest);
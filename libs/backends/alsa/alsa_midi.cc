@@ -16,14 +16,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cerrno>
 #include <unistd.h>
 
 #include <glibmm.h>
 
 #include "alsa_midi.h"
+#include "alsa_midi_reactor.h"
 
 #include "pbd/error.h"
-#include "pbd/pthread_utils.h"
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -43,9 +44,6 @@ AlsaMidiIO::AlsaMidiIO ()
 	, _samples_per_period (1024)
 	, _rb (0)
 {
-	pthread_mutex_init (&_notify_mutex, 0);
-	pthread_cond_init (&_notify_ready, 0);
-
 	// MIDI (hw port) 31.25 kbaud
 	// worst case here is  8192 SPP and 8KSPS for which we'd need
 	// 4000 bytes sans MidiEventHeader.
@@ -55,60 +53,32 @@ AlsaMidiIO::AlsaMidiIO ()
 
 AlsaMidiIO::~AlsaMidiIO ()
 {
+	assert (!_running);
 	delete _rb;
-	pthread_mutex_destroy (&_notify_mutex);
-	pthread_cond_destroy (&_notify_ready);
 	free (_pfds);
 }
 
-static void * pthread_process (void *arg)
-{
-	AlsaMidiIO *d = static_cast<AlsaMidiIO *>(arg);
-	pthread_set_name ("AlsaMidiIO");
-	d->main_process_thread ();
-	pthread_exit (0);
-	return 0;
-}
-
 int
 AlsaMidiIO::start ()
 {
-	if (pbd_realtime_pthread_create (PBD_SCHED_FIFO, PBD_RT_PRI_MIDI, PBD_RT_STACKSIZE_HELP,
-				&_main_thread, pthread_process, this))
-	{
-		if (pbd_pthread_create (PBD_RT_STACKSIZE_HELP, &_main_thread, pthread_process, this)) {
-			PBD::error << _("AlsaMidiIO: Failed to create process thread.") << endmsg;
-			return -1;
-		} else {
-			PBD::warning << _("AlsaMidiIO: Cannot acquire realtime permissions.") << endmsg;
-		}
-	}
-	int timeout = 5000;
-	while (!_running && --timeout > 0) { Glib::usleep (1000); }
-	if (timeout == 0 || !_running) {
+	if (AlsaMidiReactor::instance ().add (this)) {
+		PBD::error << _("AlsaMidiIO: Failed to start device.") << endmsg;
 		return -1;
 	}
+	_running = true;
+	/* flush events that were queued before the device was started */
+	AlsaMidiReactor::instance ().wakeup ();
 	return 0;
 }
 
 int
 AlsaMidiIO::stop ()
 {
-	void *status;
 	if (!_running) {
 		return 0;
 	}
-
+	AlsaMidiReactor::instance ().remove (this);
 	_running = false;
-
-	pthread_mutex_lock (&_notify_mutex);
-	pthread_cond_signal (&_notify_ready);
-	pthread_mutex_unlock (&_notify_mutex);
-
-	if (pthread_join (_main_thread, &status)) {
-		PBD::error << _("AlsaMidiIO: Failed to terminate.") << endmsg;
-		return -1;
-	}
 	return 0;
 }
 
@@ -136,10 +106,35 @@ AlsaMidiIO::sync_time (const uint64_t tme)
 	_clock_monotonic = tme;
 }
 
+/** Read the header of the next event without removing it from the ringbuffer */
+bool
+AlsaMidiIO::peek_event_header (MidiEventHeader& h) const
+{
+	if (_rb->read_space() <= sizeof(MidiEventHeader)) {
+		return false;
+	}
+
+	PBD::RingBuffer<uint8_t>::rw_vector vector;
+	_rb->get_read_vector(&vector);
+	if (vector.len[0] >= sizeof(MidiEventHeader)) {
+		memcpy((uint8_t*)&h, vector.buf[0], sizeof(MidiEventHeader));
+	} else {
+		if (vector.len[0] > 0) {
+			memcpy ((uint8_t*)&h, vector.buf[0], vector.len[0]);
+		}
+		assert(vector.buf[1]);
+		memcpy (((uint8_t*)&h) + vector.len[0], vector.buf[1], sizeof(MidiEventHeader) - vector.len[0]);
+	}
+	return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 AlsaMidiOut::AlsaMidiOut ()
 	: AlsaMidiIO ()
+	, _pending (false)
+	, _pending_written (0)
+	, _pending_event (0, 0)
 {
 }
 
@@ -155,13 +150,76 @@ AlsaMidiOut::send_event (const pframes_t time, const uint8_t *data, const size_t
 	_rb->write ((uint8_t*) &h, sizeof(MidiEventHeader));
 	_rb->write (data, size);
 
-	if (pthread_mutex_trylock (&_notify_mutex) == 0) {
-		pthread_cond_signal (&_notify_ready);
-		pthread_mutex_unlock (&_notify_mutex);
-	}
+	AlsaMidiReactor::instance ().wakeup ();
 	return 0;
 }
 
+bool
+AlsaMidiOut::dequeue_event ()
+{
+	struct MidiEventHeader h (0, 0);
+
+	while (peek_event_header (h)) {
+		if (_rb->read_space () < sizeof (MidiEventHeader) + h.size) {
+			/* the event is still being written */
+			return false;
+		}
+		_rb->increment_read_idx (sizeof (MidiEventHeader));
+
+		if (h.size > MaxAlsaMidiEventSize) {
+			_rb->increment_read_idx (h.size);
+			_DEBUGPRINT("AlsaMidiOut: MIDI event too large!\n");
+			continue;
+		}
+		if (_rb->read (_pending_data, h.size) != h.size) {
+			_DEBUGPRINT("AlsaMidiOut: Garbled MIDI EVENT DATA!!\n");
+			return false;
+		}
+
+		_pending_event   = h;
+		_pending_written = 0;
+		_pending         = true;
+		return true;
+	}
+	return false;
+}
+
+int
+AlsaMidiOut::flush_output (const uint64_t now, uint64_t& next)
+{
+	next = 0;
+
+	while (_pending || dequeue_event ()) {
+		if (_pending_event.time > now + AlsaMidiOutputSlack) {
+			next = _pending_event.time - AlsaMidiOutputSlack;
+			break;
+		}
+
+		ssize_t rv = write_event (&_pending_data[_pending_written], _pending_event.size - _pending_written);
+
+#if EAGAIN != EWOULDBLOCK
+		if ((rv == -EAGAIN) || (rv == -EWOULDBLOCK))  {
+#else
+		if (rv == -EAGAIN) {
+#endif
+			drain_output ();
+			return 1;
+		}
+		if (rv < 0) {
+			return -1;
+		}
+
+		_pending_written += rv;
+		if (_pending_written < _pending_event.size) {
+			/* short write, the device's buffer is full */
+			return 1;
+		}
+		_pending = false;
+	}
+
+	return drain_output ();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 AlsaMidiIn::AlsaMidiIn ()
@@ -172,25 +230,12 @@ AlsaMidiIn::AlsaMidiIn ()
 size_t
 AlsaMidiIn::recv_event (pframes_t &time, uint8_t *data, size_t &size)
 {
-	const uint32_t read_space = _rb->read_space();
 	struct MidiEventHeader h(0,0);
 
-	if (read_space <= sizeof(MidiEventHeader)) {
+	if (!peek_event_header (h)) {
 		return 0;
 	}
 
-	PBD::RingBuffer<uint8_t>::rw_vector vector;
-	_rb->get_read_vector(&vector);
-	if (vector.len[0] >= sizeof(MidiEventHeader)) {
-		memcpy((uint8_t*)&h, vector.buf[0], sizeof(MidiEventHeader));
-	} else {
-		if (vector.len[0] > 0) {
-			memcpy ((uint8_t*)&h, vector.buf[0], vector.len[0]);
-		}
-		assert(vector.buf[1]);
-		memcpy (((uint8_t*)&h) + vector.len[0], vector.buf[1], sizeof(MidiEventHeader) - vector.len[0]);
-	}
-
 	if (h.time >= _clock_monotonic + _period_length_us ) {
 #ifdef DEBUG_TIMING
 		printf("AlsaMidiIn DEBUG: POSTPONE EVENT TO NEXT CYCLE: %.1f spl\n", ((h.time - _clock_monotonic) / _sample_length_us));
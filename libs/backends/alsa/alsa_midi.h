@@ -21,7 +21,7 @@
 
 #include <stdint.h>
 #include <poll.h>
-#include <pthread.h>
+#include <sys/types.h>
 
 #include "pbd/ringbuffer.h"
 #include "ardour/types.h"
@@ -30,6 +30,9 @@
  * events larger than this are ignored */
 #define MaxAlsaMidiEventSize (256)
 
+/* output events are written up to this many usec early */
+#define AlsaMidiOutputSlack (50)
+
 namespace ARDOUR {
 
 class AlsaMidiIO {
@@ -44,15 +47,28 @@ public:
 	void setup_timing (const size_t samples_per_period, const float samplerate);
 	void sync_time(uint64_t);
 
-	virtual void* main_process_thread () = 0;
-
 	const std::string & name () const { return _name; }
 
-protected:
-	pthread_t _main_thread;
-	pthread_mutex_t _notify_mutex;
-	pthread_cond_t _notify_ready;
+	/* the following are called from the AlsaMidiReactor thread */
+
+	int n_pfds () const { return _npfds; }
+	struct pollfd const* pfds () const { return _pfds; }
+
+	virtual bool is_output () const { return false; }
+
+	/** Handle events of the device's poll descriptors.
+	 * @param now time when the reactor woke up
+	 * @return 0 on success, -1 on error (the device is disabled)
+	 */
+	virtual int handle_io (const uint64_t now) = 0;
 
+	/** Write all events that are due at \a now.
+	 * @param next set to the time of the next queued event, 0 if there is none
+	 * @return 0 on success, 1 if the device is busy, -1 on error
+	 */
+	virtual int flush_output (const uint64_t now, uint64_t& next) { next = 0; return 0; }
+
+protected:
 	int  _state;
 	bool  _running;
 
@@ -74,6 +90,8 @@ protected:
 
 	PBD::RingBuffer<uint8_t>* _rb;
 
+	bool peek_event_header (MidiEventHeader&) const;
+
 	std::string _name;
 
 	virtual void init (const char *device_name, const bool input) = 0;
@@ -86,6 +104,27 @@ public:
 	AlsaMidiOut ();
 
 	int send_event (const pframes_t, const uint8_t *, const size_t);
+
+	bool is_output () const { return true; }
+	int flush_output (const uint64_t, uint64_t&);
+
+protected:
+	/** Write (a part of) an event to the device, non-blocking.
+	 * @return number of bytes written, or a negative error code
+	 */
+	virtual ssize_t write_event (const uint8_t *, const size_t) = 0;
+
+	/** Flush buffered output, 1 if the device is busy */
+	virtual int drain_output () { return 0; }
+
+private:
+	bool dequeue_event ();
+
+	/* event taken from the ringbuffer, waiting to be written */
+	bool            _pending;
+	size_t          _pending_written;
+	MidiEventHeader _pending_event;
+	uint8_t         _pending_data[MaxAlsaMidiEventSize];
 };
 
 class AlsaMidiIn : virtual public AlsaMidiIO
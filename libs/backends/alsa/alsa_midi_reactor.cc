@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include <glibmm.h>
+
+#include "alsa_midi.h"
+#include "alsa_midi_reactor.h"
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+
+AlsaMidiReactor&
+AlsaMidiReactor::instance ()
+{
+	static AlsaMidiReactor reactor;
+	return reactor;
+}
+
+AlsaMidiReactor::AlsaMidiReactor ()
+	: _running (false)
+	, _epfd (-1)
+	, _timerfd (-1)
+	, _eventfd (-1)
+	, _timer (0)
+	, _wakeup_pending (0)
+{
+	pthread_mutex_init (&_ctrl_lock, 0);
+	pthread_mutex_init (&_lock, 0);
+}
+
+AlsaMidiReactor::~AlsaMidiReactor ()
+{
+	assert (_devices.empty ());
+	stop ();
+	pthread_mutex_destroy (&_ctrl_lock);
+	pthread_mutex_destroy (&_lock);
+}
+
+int
+AlsaMidiReactor::add (AlsaMidiIO* io)
+{
+	pthread_mutex_lock (&_ctrl_lock);
+
+	if (!_running && start ()) {
+		pthread_mutex_unlock (&_ctrl_lock);
+		return -1;
+	}
+
+	pthread_mutex_lock (&_lock);
+
+	struct pollfd const* pfds = io->pfds ();
+	int n;
+	for (n = 0; n < io->n_pfds (); ++n) {
+		struct epoll_event ev;
+		memset (&ev, 0, sizeof (ev));
+		/* outputs are only watched for POLLOUT while they are busy */
+		ev.events   = io->is_output () ? 0 : EPOLLIN;
+		ev.data.ptr = io;
+		if (epoll_ctl (_epfd, EPOLL_CTL_ADD, pfds[n].fd, &ev)) {
+			break;
+		}
+	}
+
+	if (n < io->n_pfds ()) {
+		while (n-- > 0) {
+			epoll_ctl (_epfd, EPOLL_CTL_DEL, pfds[n].fd, 0);
+		}
+		pthread_mutex_unlock (&_lock);
+		if (_devices.empty ()) {
+			stop ();
+		}
+		pthread_mutex_unlock (&_ctrl_lock);
+		PBD::error << string_compose (_("AlsaMidiReactor: cannot watch device '%1'."), io->name ()) << endmsg;
+		return -1;
+	}
+
+	_devices.push_back (Device (io));
+
+	pthread_mutex_unlock (&_lock);
+	pthread_mutex_unlock (&_ctrl_lock);
+	return 0;
+}
+
+void
+AlsaMidiReactor::remove (AlsaMidiIO* io)
+{
+	pthread_mutex_lock (&_ctrl_lock);
+	pthread_mutex_lock (&_lock);
+
+	for (std::vector<Device>::iterator i = _devices.begin (); i != _devices.end (); ++i) {
+		if (i->io != io) {
+			continue;
+		}
+		if (!i->failed) {
+			for (int n = 0; n < io->n_pfds (); ++n) {
+				epoll_ctl (_epfd, EPOLL_CTL_DEL, io->pfds ()[n].fd, 0);
+			}
+		}
+		_devices.erase (i);
+		break;
+	}
+
+	bool const last = _devices.empty ();
+	pthread_mutex_unlock (&_lock);
+
+	if (last) {
+		stop ();
+	}
+	pthread_mutex_unlock (&_ctrl_lock);
+}
+
+void
+AlsaMidiReactor::wakeup ()
+{
+	/* only notify once until the reactor has processed the previous wakeup */
+	if (_wakeup_pending.exchange (1) == 0) {
+		uint64_t one = 1;
+		if (write (_eventfd, &one, sizeof (one)) != sizeof (one)) {
+			_wakeup_pending = 0;
+		}
+	}
+}
+
+int
+AlsaMidiReactor::start ()
+{
+	assert (!_running);
+
+	_epfd    = epoll_create1 (EPOLL_CLOEXEC);
+	_timerfd = timerfd_create (CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	_eventfd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (_epfd < 0 || _timerfd < 0 || _eventfd < 0) {
+		PBD::error << _("AlsaMidiReactor: cannot create event descriptors.") << endmsg;
+		stop ();
+		return -1;
+	}
+
+	struct epoll_event ev;
+	memset (&ev, 0, sizeof (ev));
+	ev.events   = EPOLLIN;
+	ev.data.ptr = &_timerfd;
+	if (epoll_ctl (_epfd, EPOLL_CTL_ADD, _timerfd, &ev)) {
+		stop ();
+		return -1;
+	}
+	ev.data.ptr = &_eventfd;
+	if (epoll_ctl (_epfd, EPOLL_CTL_ADD, _eventfd, &ev)) {
+		stop ();
+		return -1;
+	}
+
+	_timer          = 0;
+	_wakeup_pending = 0;
+	_running        = true;
+
+	if (pbd_realtime_pthread_create (PBD_SCHED_FIFO, PBD_RT_PRI_MIDI, PBD_RT_STACKSIZE_HELP,
+				&_thread, _main_thread, this))
+	{
+		if (pbd_pthread_create (PBD_RT_STACKSIZE_HELP, &_thread, _main_thread, this)) {
+			PBD::error << _("AlsaMidiReactor: Failed to create process thread.") << endmsg;
+			_running = false;
+			stop ();
+			return -1;
+		} else {
+			PBD::warning << _("AlsaMidiReactor: Cannot acquire realtime permissions.") << endmsg;
+		}
+	}
+	return 0;
+}
+
+void
+AlsaMidiReactor::stop ()
+{
+	if (_running) {
+		_running = false;
+		uint64_t one = 1;
+		if (write (_eventfd, &one, sizeof (one)) != sizeof (one)) {
+			PBD::error << _("AlsaMidiReactor: Failed to notify thread.") << endmsg;
+		}
+		void* status;
+		if (pthread_join (_thread, &status)) {
+			PBD::error << _("AlsaMidiReactor: Failed to terminate.") << endmsg;
+		}
+	}
+
+	if (_epfd >= 0) {
+		close (_epfd);
+		_epfd = -1;
+	}
+	if (_timerfd >= 0) {
+		close (_timerfd);
+		_timerfd = -1;
+	}
+	if (_eventfd >= 0) {
+		close (_eventfd);
+		_eventfd = -1;
+	}
+}
+
+void*
+AlsaMidiReactor::_main_thread (void* arg)
+{
+	AlsaMidiReactor* self = static_cast<AlsaMidiReactor*> (arg);
+	pthread_set_name ("AlsaMidiIO");
+	self->main_thread ();
+	pthread_exit (0);
+	return 0;
+}
+
+AlsaMidiReactor::Device*
+AlsaMidiReactor::find (AlsaMidiIO* io)
+{
+	for (std::vector<Device>::iterator i = _devices.begin (); i != _devices.end (); ++i) {
+		if (i->io == io) {
+			return &(*i);
+		}
+	}
+	return 0;
+}
+
+void
+AlsaMidiReactor::disable (Device& d)
+{
+	d.failed = true;
+	for (int n = 0; n < d.io->n_pfds (); ++n) {
+		epoll_ctl (_epfd, EPOLL_CTL_DEL, d.io->pfds ()[n].fd, 0);
+	}
+}
+
+void
+AlsaMidiReactor::set_pollout (Device& d, bool yn)
+{
+	if (d.pollout == yn) {
+		return;
+	}
+	d.pollout = yn;
+	for (int n = 0; n < d.io->n_pfds (); ++n) {
+		struct epoll_event ev;
+		memset (&ev, 0, sizeof (ev));
+		ev.events   = yn ? EPOLLOUT : 0;
+		ev.data.ptr = d.io;
+		epoll_ctl (_epfd, EPOLL_CTL_MOD, d.io->pfds ()[n].fd, &ev);
+	}
+}
+
+void
+AlsaMidiReactor::arm_timer (uint64_t when)
+{
+	if (when == _timer) {
+		return;
+	}
+	_timer = when;
+
+	/* all zero disarms the timer */
+	struct itimerspec its;
+	memset (&its, 0, sizeof (its));
+	its.it_value.tv_sec  = when / 1000000;
+	its.it_value.tv_nsec = (when % 1000000) * 1000;
+	timerfd_settime (_timerfd, TFD_TIMER_ABSTIME, &its, 0);
+}
+
+void
+AlsaMidiReactor::service_outputs (uint64_t now)
+{
+	uint64_t next = 0;
+
+	for (std::vector<Device>::iterator i = _devices.begin (); i != _devices.end (); ++i) {
+		if (i->failed || !i->io->is_output ()) {
+			continue;
+		}
+		uint64_t t = 0;
+		int rv = i->io->flush_output (now, t);
+		if (rv < 0) {
+			disable (*i);
+			continue;
+		}
+		set_pollout (*i, rv > 0);
+		if (t > 0 && (next == 0 || t < next)) {
+			next = t;
+		}
+	}
+
+	arm_timer (next);
+}
+
+void
+AlsaMidiReactor::main_thread ()
+{
+	const int max_events = 64;
+	struct epoll_event events[max_events];
+
+	while (_running) {
+		int n = epoll_wait (_epfd, events, max_events, -1);
+
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			PBD::error << _("AlsaMidiReactor: epoll error. Terminating Midi Thread.") << endmsg;
+			break;
+		}
+
+		if (!_running) {
+			break;
+		}
+
+		pthread_mutex_lock (&_lock);
+
+		uint64_t const now = g_get_monotonic_time ();
+		uint64_t       val;
+
+		for (int e = 0; e < n; ++e) {
+			void* ptr = events[e].data.ptr;
+			if (ptr == &_eventfd) {
+				_wakeup_pending = 0;
+				while (read (_eventfd, &val, sizeof (val)) > 0) ;
+			} else if (ptr == &_timerfd) {
+				_timer = 0;
+				while (read (_timerfd, &val, sizeof (val)) > 0) ;
+			} else {
+				/* the device may have been removed meanwhile */
+				Device* d = find (static_cast<AlsaMidiIO*> (ptr));
+				if (d && !d->failed && d->io->handle_io (now)) {
+					disable (*d);
+				}
+			}
+		}
+
+		/* write pending output, and schedule the next wakeup */
+		service_outputs (now);
+
+		pthread_mutex_unlock (&_lock);
+	}
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __libbackend_alsa_midi_reactor_h__
+#define __libbackend_alsa_midi_reactor_h__
+
+#include <atomic>
+#include <vector>
+
+#include <stdint.h>
+#include <pthread.h>
+
+namespace ARDOUR {
+
+class AlsaMidiIO;
+
+/** A single thread that services all ALSA MIDI devices.
+ *
+ * The poll descriptors of all devices are watched using epoll.
+ * Input is read as soon as it arrives, output is written when it is due,
+ * using a timerfd that is armed for the earliest pending event of all
+ * devices. Output devices are only watched for POLLOUT while they
+ * are busy.
+ *
+ * Events are exchanged with the process thread using the per-device
+ * ringbuffers of AlsaMidiIO, the process thread only calls wakeup()
+ * after queuing output.
+ */
+class AlsaMidiReactor
+{
+public:
+	static AlsaMidiReactor& instance ();
+
+	/* add, remove a device, the thread is started with the first,
+	 * and stopped when the last device is removed.
+	 */
+	int  add (AlsaMidiIO*);
+	void remove (AlsaMidiIO*);
+
+	/** notify the reactor about new output, realtime safe */
+	void wakeup ();
+
+private:
+	AlsaMidiReactor ();
+	~AlsaMidiReactor ();
+
+	struct Device {
+		Device (AlsaMidiIO* d)
+			: io (d)
+			, pollout (false)
+			, failed (false)
+		{}
+
+		AlsaMidiIO* io;
+		bool        pollout;
+		bool        failed;
+	};
+
+	int  start ();
+	void stop ();
+
+	static void* _main_thread (void*);
+	void         main_thread ();
+
+	Device* find (AlsaMidiIO*);
+	void    disable (Device&);
+	void    set_pollout (Device&, bool);
+	void    service_outputs (uint64_t now);
+	void    arm_timer (uint64_t when);
+
+	pthread_t       _thread;
+	pthread_mutex_t _ctrl_lock; // serializes add/remove
+	pthread_mutex_t _lock;      // protects _devices
+	bool            _running;
+
+	int _epfd;
+	int _timerfd;
+	int _eventfd;
+
+	uint64_t            _timer;
+	std::atomic<int>    _wakeup_pending;
+	std::vector<Device> _devices;
+};
+
+} // namespace
+
+#endif
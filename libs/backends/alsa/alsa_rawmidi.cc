@@ -18,10 +18,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cerrno>
 #include <unistd.h>
 #include <glibmm.h>
 
-#include "select_sleep.h"
 #include "alsa_rawmidi.h"
 
 #include "pbd/error.h"
@@ -103,6 +103,16 @@ initerr:
 	return;
 }
 
+/** Query the events of the device's poll descriptors, non-blocking */
+int
+AlsaRawMidiIO::poll_revents (unsigned short& revents)
+{
+	if (poll (_pfds, _npfds, 0) < 0) {
+		return -1;
+	}
+	return snd_rawmidi_poll_descriptors_revents (_device, _pfds, _npfds, &revents);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 AlsaRawMidiOut::AlsaRawMidiOut (const std::string &name, const char *device)
@@ -111,123 +121,42 @@ AlsaRawMidiOut::AlsaRawMidiOut (const std::string &name, const char *device)
 {
 }
 
-void *
-AlsaRawMidiOut::main_process_thread ()
+int
+AlsaRawMidiOut::handle_io (const uint64_t)
 {
-	_running = true;
-	pthread_mutex_lock (&_notify_mutex);
-	unsigned int need_drain = 0;
-	while (_running) {
-		bool have_data = false;
-		struct MidiEventHeader h(0,0);
-		uint8_t data[MaxAlsaMidiEventSize];
-
-		const uint32_t read_space = _rb->read_space();
-
-		if (read_space > sizeof(MidiEventHeader)) {
-			if (_rb->read ((uint8_t*)&h, sizeof(MidiEventHeader)) != sizeof(MidiEventHeader)) {
-				_DEBUGPRINT("AlsaRawMidiOut: Garbled MIDI EVENT HEADER!!\n");
-				break;
-			}
-			assert (read_space >= h.size);
-			if (h.size > MaxAlsaMidiEventSize) {
-				_rb->increment_read_idx (h.size);
-				_DEBUGPRINT("AlsaRawMidiOut: MIDI event too large!\n");
-				continue;
-			}
-			if (_rb->read (&data[0], h.size) != h.size) {
-				_DEBUGPRINT("AlsaRawMidiOut: Garbled MIDI EVENT DATA!!\n");
-				break;
-			}
-			have_data = true;
-		}
+	unsigned short revents = 0;
 
-		if (!have_data) {
-			if (need_drain > 0) {
-				snd_rawmidi_drain (_device);
-				need_drain = 0;
-			}
-			pthread_cond_wait (&_notify_ready, &_notify_mutex);
-			continue;
-		}
-
-		uint64_t now = g_get_monotonic_time();
-		while (h.time > now + 500) {
-			if (need_drain > 0) {
-				snd_rawmidi_drain (_device);
-				need_drain = 0;
-			} else {
-				select_sleep(h.time - now);
-			}
-			now = g_get_monotonic_time();
-		}
-
-retry:
-		int perr = poll (_pfds, _npfds, 10 /* ms */);
-		if (perr < 0) {
-			PBD::error << _("AlsaRawMidiOut: Error polling device. Terminating Midi Thread.") << endmsg;
-			break;
-		}
-		if (perr == 0) {
-			_DEBUGPRINT("AlsaRawMidiOut: poll() timed out.\n");
-			goto retry;
-		}
-
-		unsigned short revents = 0;
-		if (snd_rawmidi_poll_descriptors_revents (_device, _pfds, _npfds, &revents)) {
-			PBD::error << _("AlsaRawMidiOut: Failed to poll device. Terminating Midi Thread.") << endmsg;
-			break;
-		}
+	if (poll_revents (revents)) {
+		PBD::error << _("AlsaRawMidiOut: Failed to poll device. Disabling device.") << endmsg;
+		return -1;
+	}
 
-		if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
-			PBD::error << _("AlsaRawMidiOut: poll error. Terminating Midi Thread.") << endmsg;
-			break;
-		}
+	if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+		PBD::error << _("AlsaRawMidiOut: poll error. Disabling device.") << endmsg;
+		return -1;
+	}
 
-		if (!(revents & POLLOUT)) {
-			_DEBUGPRINT("AlsaRawMidiOut: POLLOUT not ready.\n");
-			select_sleep (1000);
-			goto retry;
-		}
+	/* pending data is written by flush_output() */
+	return 0;
+}
 
-		ssize_t err = snd_rawmidi_write (_device, data, h.size);
+ssize_t
+AlsaRawMidiOut::write_event (const uint8_t *data, const size_t size)
+{
+	ssize_t err = snd_rawmidi_write (_device, data, size);
 
 #if 0 // DEBUG -- not rt-safe
-		printf("TX [%ld | %ld]", h.size, err);
-		for (size_t i = 0; i < h.size; ++i) {
-			printf (" %02x", data[i]);
-		}
-		printf ("\n");
+	printf("TX [%ld | %ld]", size, err);
+	for (size_t i = 0; i < size; ++i) {
+		printf (" %02x", data[i]);
+	}
+	printf ("\n");
 #endif
 
-		if (err == -EAGAIN) {
-			snd_rawmidi_drain (_device);
-			goto retry;
-		}
-		if (err == -EWOULDBLOCK) {
-			select_sleep (1000);
-			goto retry;
-		}
-		if (err < 0) {
-			PBD::error << _("AlsaRawMidiOut: write failed. Terminating Midi Thread.") << endmsg;
-			break;
-		}
-		if ((size_t) err < h.size) {
-			_DEBUGPRINT("AlsaRawMidiOut: short write\n");
-			memmove(&data[0], &data[err], err);
-			h.size -= err;
-			goto retry;
-		}
-
-		if ((need_drain += h.size) >= 64) {
-			snd_rawmidi_drain (_device);
-			need_drain = 0;
-		}
+	if (err < 0 && err != -EAGAIN && err != -EWOULDBLOCK) {
+		PBD::error << _("AlsaRawMidiOut: write failed. Disabling device.") << endmsg;
 	}
-
-	pthread_mutex_unlock (&_notify_mutex);
-	_DEBUGPRINT("AlsaRawMidiOut: MIDI OUT THREAD STOPPED\n");
-	return 0;
+	return err;
 }
 
 
@@ -245,40 +174,27 @@ AlsaRawMidiIn::AlsaRawMidiIn (const std::string &name, const char *device)
 {
 }
 
-void *
-AlsaRawMidiIn::main_process_thread ()
+int
+AlsaRawMidiIn::handle_io (const uint64_t time)
 {
-	_running = true;
-	while (_running) {
-		unsigned short revents = 0;
-
-		int perr = poll (_pfds, _npfds, 100 /* ms */);
-		if (perr < 0) {
-			PBD::error << _("AlsaRawMidiIn: Error polling device. Terminating Midi Thread.") << endmsg;
-			break;
-		}
-		if (perr == 0) {
-			continue;
-		}
+	unsigned short revents = 0;
 
-		if (snd_rawmidi_poll_descriptors_revents (_device, _pfds, _npfds, &revents)) {
-			PBD::error << _("AlsaRawMidiIn: Failed to poll device. Terminating Midi Thread.") << endmsg;
-			break;
-		}
+	if (poll_revents (revents)) {
+		PBD::error << _("AlsaRawMidiIn: Failed to poll device. Disabling device.") << endmsg;
+		return -1;
+	}
 
-		if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
-			PBD::error << _("AlsaRawMidiIn: poll error. Terminating Midi Thread.") << endmsg;
-			break;
-		}
+	if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+		PBD::error << _("AlsaRawMidiIn: poll error. Disabling device.") << endmsg;
+		return -1;
+	}
 
-		if (!(revents & POLLIN)) {
-			_DEBUGPRINT("AlsaRawMidiOut: POLLIN not ready.\n");
-			select_sleep (1000);
-			continue;
-		}
+	if (!(revents & POLLIN)) {
+		return 0;
+	}
 
+	while (true) {
 		uint8_t data[MaxAlsaMidiEventSize];
-		uint64_t time = g_get_monotonic_time();
 		ssize_t err = snd_rawmidi_read (_device, data, sizeof(data));
 
 #if EAGAIN != EWOULDBLOCK
@@ -286,15 +202,15 @@ AlsaRawMidiIn::main_process_thread ()
 #else
 		if (err == -EAGAIN) {
 #endif
-		    continue;
+			return 0;
 		}
 		if (err < 0) {
-			PBD::error << _("AlsaRawMidiIn: read error. Terminating Midi") << endmsg;
-			break;
+			PBD::error << _("AlsaRawMidiIn: read error. Disabling device.") << endmsg;
+			return -1;
 		}
 		if (err == 0) {
 			_DEBUGPRINT("AlsaRawMidiIn: zero read\n");
-			continue;
+			return 0;
 		}
 
 #if 0
@@ -303,9 +219,6 @@ AlsaRawMidiIn::main_process_thread ()
 		parse_events (time, data, err);
 #endif
 	}
-
-	_DEBUGPRINT("AlsaRawMidiIn: MIDI IN THREAD STOPPED\n");
-	return 0;
 }
 
 int
@@ -39,6 +39,8 @@ public:
 protected:
 	snd_rawmidi_t *_device;
 
+	int poll_revents (unsigned short&);
+
 private:
 	void init (const char *device_name, const bool input);
 };
@@ -47,7 +49,11 @@ class AlsaRawMidiOut : public AlsaRawMidiIO, public AlsaMidiOut
 {
 public:
 	AlsaRawMidiOut (const std::string &name, const char *device);
-	void* main_process_thread ();
+
+	int handle_io (const uint64_t);
+
+protected:
+	ssize_t write_event (const uint8_t *, const size_t);
 };
 
 class AlsaRawMidiIn : public AlsaRawMidiIO, public AlsaMidiIn
@@ -55,7 +61,7 @@ class AlsaRawMidiIn : public AlsaRawMidiIO, public AlsaMidiIn
 public:
 	AlsaRawMidiIn (const std::string &name, const char *device);
 
-	void* main_process_thread ();
+	int handle_io (const uint64_t);
 
 protected:
 	int queue_event (const uint64_t, const uint8_t *, const size_t);
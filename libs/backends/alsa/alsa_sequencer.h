@@ -38,8 +38,11 @@ public:
 
 protected:
 	snd_seq_t *_seq;
+	snd_midi_event_t *_codec;
 	int _port;
 
+	int poll_revents (unsigned short&);
+
 private:
 	void init (const char *device_name, const bool input);
 };
@@ -48,7 +51,12 @@ class AlsaSeqMidiOut : public AlsaSeqMidiIO, public AlsaMidiOut
 {
 public:
 	AlsaSeqMidiOut (const std::string &name, const char *port_name);
-	void* main_process_thread ();
+
+	int handle_io (const uint64_t);
+
+protected:
+	ssize_t write_event (const uint8_t *, const size_t);
+	int drain_output ();
 };
 
 class AlsaSeqMidiIn : public AlsaSeqMidiIO, public AlsaMidiIn
@@ -56,7 +64,7 @@ class AlsaSeqMidiIn : public AlsaSeqMidiIO, public AlsaMidiIn
 public:
 	AlsaSeqMidiIn (const std::string &name, const char *port_name);
 
-	void* main_process_thread ();
+	int handle_io (const uint64_t);
 };
 
 } // namespace
@@ -1598,6 +1598,143 @@ ControlList::unlocked_eval (timepos_t const& xtime) const
 	return _desc.normal;
 }
 
+void
+ControlList::unlocked_eval_block (timepos_t const& start, timepos_t const& end, float* vec, uint32_t veclen) const
+{
+	if (veclen == 0) {
+		return;
+	}
+
+	if (_events.empty () || _events.size () == 1) {
+		const float val = _events.empty () ? _desc.normal : _events.front ()->value;
+		for (uint32_t i = 0; i < veclen; ++i) {
+			vec[i] = val;
+		}
+		return;
+	}
+
+	timepos_t s (start);
+	timepos_t e (end);
+	s.set_time_domain (time_domain ());
+	e.set_time_domain (time_domain ());
+
+	/* position of sample i is x0 + i * dx */
+	const double x0 = s.val ();
+	const double dx = (e.val () - x0) / veclen;
+
+	if (_interpolation == Curved) {
+		/* only used for x-fade curves, which use Curve::get_vector() */
+		for (uint32_t i = 0; i < veclen; ++i) {
+			const double x = x0 + i * dx;
+			vec[i] = unlocked_eval (s.is_beats () ? timepos_t::from_ticks (x) : timepos_t::from_superclock (x));
+		}
+		return;
+	}
+
+	if (dx <= 0) {
+		const float val = unlocked_eval (s);
+		for (uint32_t i = 0; i < veclen; ++i) {
+			vec[i] = val;
+		}
+		return;
+	}
+
+	/* first event after the start position */
+	const ControlEvent cp (s, 0);
+	const_iterator     u = upper_bound (_events.begin (), _events.end (), &cp, time_comparator);
+
+	uint32_t i = 0;
+
+	while (i < veclen) {
+
+		const double x = x0 + i * dx;
+
+		while (u != _events.end () && (*u)->when.val () <= x) {
+			++u;
+		}
+
+		if (u == _events.end ()) {
+			/* after the last point */
+			const float val = _events.back ()->value;
+			for (; i < veclen; ++i) {
+				vec[i] = val;
+			}
+			break;
+		}
+
+		/* all samples up to the next point use the same segment */
+		const double   upos = (*u)->when.val ();
+		const uint32_t n    = std::max (i + 1, (uint32_t) std::min ((double) veclen, ceil ((upos - x0) / dx)));
+
+		if (u == _events.begin ()) {
+			/* before the first point */
+			const float val = _events.front ()->value;
+			for (; i < n; ++i) {
+				vec[i] = val;
+			}
+			continue;
+		}
+
+		const_iterator lo = u;
+		--lo;
+
+		const double lpos = (*lo)->when.val ();
+		const double lval = (*lo)->value;
+		const double uval = (*u)->value;
+
+		/* fraction of the segment at sample i, and per sample */
+		const double f0 = (x - lpos) / (upos - lpos);
+		const double df = dx / (upos - lpos);
+
+		switch (_interpolation) {
+			case Discrete:
+				for (uint32_t k = i; k < n; ++k) {
+					vec[k] = lval;
+				}
+				break;
+			case Exponential:
+				{
+					/* see interpolate_gain() */
+					const double from = lval + TINY_NUMBER;
+					const double to   = uval + TINY_NUMBER;
+					if (fabs (to - from) < TINY_NUMBER) {
+						for (uint32_t k = i; k < n; ++k) {
+							vec[k] = to;
+						}
+						break;
+					}
+					const double g0   = gain_to_position (from * 2. / _desc.upper);
+					const double diff = gain_to_position (to * 2. / _desc.upper) - g0;
+					for (uint32_t k = i; k < n; ++k) {
+						vec[k] = position_to_gain (g0 + (f0 + (k - i) * df) * diff) * _desc.upper / 2.;
+					}
+				}
+				break;
+			case Logarithmic:
+				if (lval > 0 && uval > 0) {
+					/* see interpolate_logarithmic() */
+					const double lr = log (uval / lval);
+					for (uint32_t k = i; k < n; ++k) {
+						vec[k] = lval * exp ((f0 + (k - i) * df) * lr);
+					}
+					break;
+				}
+				/* invalid log-scale range, interpolate linearly */
+				/* fallthrough */
+			default: // Linear
+				{
+					const double d = uval - lval;
+					for (uint32_t k = i; k < n; ++k) {
+						vec[k] = lval + (f0 + (k - i) * df) * d;
+					}
+				}
+				break;
+		}
+
+		i = n;
+	}
+}
+
 double
 ControlList::multipoint_eval (timepos_t const& xtime) const
 {
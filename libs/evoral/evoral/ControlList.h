@@ -282,6 +282,33 @@ public:
 		}
 	}
 
+	/** Evaluate the list at @p veclen equidistant positions in [start, end)
+	 * and write the values to @p vec (takes a read-lock, not safe while
+	 * writing automation).
+	 *
+	 * Unlike repeated calls to eval(), each control point segment is only
+	 * looked up once, and the values of a segment are computed in a
+	 * single pass.
+	 */
+	void eval_block (Temporal::timepos_t const & start, Temporal::timepos_t const & end, float* vec, uint32_t veclen) const {
+		Glib::Threads::RWLock::ReaderLock lm (_lock);
+		unlocked_eval_block (start, end, vec, veclen);
+	}
+
+	/** Realtime safe version of eval_block(). This may fail if a read-lock
+	 * cannot be taken, in which case @p vec is left untouched.
+	 *
+	 * @returns true if @p vec was filled
+	 */
+	bool rt_safe_eval_block (Temporal::timepos_t const & start, Temporal::timepos_t const & end, float* vec, uint32_t veclen) const {
+		Glib::Threads::RWLock::ReaderLock lm (_lock, Glib::Threads::TRY_LOCK);
+		if (!lm.locked()) {
+			return false;
+		}
+		unlocked_eval_block (start, end, vec, veclen);
+		return true;
+	}
+
 	static inline bool time_comparator (const ControlEvent* a, const ControlEvent* b) {
 		return a->when < b->when;
 	}
@@ -314,6 +341,7 @@ public:
 	 * FIXME: Should this be private?  Curve needs it..
 	 */
 	double unlocked_eval (Temporal::timepos_t const & x) const;
+	void unlocked_eval_block (Temporal::timepos_t const & start, Temporal::timepos_t const & end, float* vec, uint32_t veclen) const;
 
 	bool rt_safe_earliest_event_discrete_unlocked (Temporal::timepos_t const & start, Temporal::timepos_t & x, double& y, bool inclusive) const;
 	bool rt_safe_earliest_event_linear_unlocked (Temporal::timepos_t const & start, Temporal::timepos_t & x, double& y, bool inclusive, Temporal::timecnt_t min_x_delta = Temporal::timecnt_t::max()) const;
@@ -342,6 +342,49 @@ CurveTest::ctrlListEval ()
 	CPPUNIT_ASSERT_EQUAL(9.0, cl->unlocked_eval(t999));
 }
 
+void
+CurveTest::ctrlListEvalBlock ()
+{
+	float vec[450];
+
+	std::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+
+	/* empty list */
+	cl->eval_block (timepos_t (0), timepos_t (100), vec, 100);
+	for (int i = 0; i < 100; ++i) {
+		CPPUNIT_ASSERT_EQUAL (0.0f, vec[i]);
+	}
+
+	cl->fast_simple_add (timepos_t (50), 0.5);
+	cl->fast_simple_add (timepos_t (100), 1.0);
+	cl->fast_simple_add (timepos_t (200), 0.25);
+	cl->fast_simple_add (timepos_t (301), 0.8);
+
+	ControlList::InterpolationStyle const styles[] = {
+		ControlList::Discrete, ControlList::Linear, ControlList::Logarithmic, ControlList::Exponential
+	};
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+		cl->set_interpolation (styles[s]);
+
+		/* whole range incl. before the first and after the last point */
+		cl->eval_block (timepos_t (0), timepos_t (450), vec, 450);
+		for (int i = 0; i < 450; ++i) {
+			char msg[64];
+			snprintf (msg, 64, "style %d at %d", (int) styles[s], i);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (msg, cl->unlocked_eval (timepos_t (i)), vec[i], 1e-5);
+		}
+
+		/* a cycle starting in the middle of a segment */
+		CPPUNIT_ASSERT (cl->rt_safe_eval_block (timepos_t (123), timepos_t (251), vec, 128));
+		for (int i = 0; i < 128; ++i) {
+			char msg[64];
+			snprintf (msg, 64, "style %d at %d", (int) styles[s], 123 + i);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (msg, cl->unlocked_eval (timepos_t (123 + i)), vec[i], 1e-5);
+		}
+	}
+}
+
 void
 CurveTest::constrainedCubic ()
 {
@@ -15,6 +15,7 @@ class CurveTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (threePointDiscete);
 	CPPUNIT_TEST (constrainedCubic);
 	CPPUNIT_TEST (ctrlListEval);
+	CPPUNIT_TEST (ctrlListEvalBlock);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -25,6 +26,7 @@ public:
 	void threePointDiscete ();
 	void constrainedCubic ();
 	void ctrlListEval ();
+	void ctrlListEvalBlock ();
 
 private:
 	std::shared_ptr<Evoral::ControlList> TestCtrlList() {
@@ -268,7 +268,7 @@ Panner1in2out::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
 
 	/* fetch positional data */
 
-	if (!_pannable->pan_azimuth_control->list ()->curve ().rt_safe_get_vector (timepos_t (start), timepos_t (end), position, nframes)) {
+	if (!_pannable->pan_azimuth_control->list ()->rt_safe_eval_block (timepos_t (start), timepos_t (end), position, nframes)) {
 		/* fallback */
 		distribute_one (srcbuf, obufs, 1.0, nframes, which);
 		return;
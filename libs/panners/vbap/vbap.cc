@@ -27,10 +27,6 @@
 #include <iostream>
 #include <string>
 
-#ifdef COMPILER_MSVC
-#include <malloc.h>
-#endif
-
 #include "pbd/cartesian.h"
 #include "pbd/compose.h"
 
@@ -65,21 +61,12 @@ panner_descriptor ()
 	return &_descriptor;
 }
 
-VBAPanner::Signal::Signal (VBAPanner&, uint32_t, uint32_t n_speakers)
+VBAPanner::Signal::Signal ()
 {
-	resize_gains (n_speakers);
-
 	desired_gains[0] = desired_gains[1] = desired_gains[2] = 0;
-	outputs[0] = outputs[1] = outputs[2] = -1;
 	desired_outputs[0] = desired_outputs[1] = desired_outputs[2] = -1;
 }
 
-void
-VBAPanner::Signal::resize_gains (uint32_t n)
-{
-	gains.assign (n, 0.0);
-}
-
 VBAPanner::VBAPanner (std::shared_ptr<Pannable> p, std::shared_ptr<Speakers> s)
 	: Panner (p)
 	, _speakers (new VBAPSpeakers (s))
@@ -116,10 +103,12 @@ VBAPanner::configure_io (ChanCount in, ChanCount /* ignored - we use Speakers */
 	clear_signals ();
 
 	for (uint32_t i = 0; i < n; ++i) {
-		Signal* s = new Signal (*this, i, _speakers->n_speakers ());
+		Signal* s = new Signal ();
 		_signals.push_back (s);
 	}
 
+	_matrix.configure (n, _speakers->n_speakers ());
+
 	update ();
 }
 
@@ -230,130 +219,38 @@ VBAPanner::compute_gains (double gains[3], int speaker_ids[3], int azi, int ele)
 void
 VBAPanner::distribute (BufferSet& inbufs, BufferSet& obufs, gain_t gain_coefficient, pframes_t nframes)
 {
-	uint32_t                  n;
-	vector<Signal*>::iterator s;
-
 	assert (inbufs.count ().n_audio () == _signals.size ());
+	assert (_matrix.n_outputs () == obufs.count ().n_audio ());
 
-	for (s = _signals.begin (), n = 0; s != _signals.end (); ++s, ++n) {
-		Signal* signal (*s);
-
-		distribute_one (inbufs.get_audio (n), obufs, gain_coefficient, nframes, n);
-
-		memcpy (signal->outputs, signal->desired_outputs, sizeof (signal->outputs));
-	}
-}
-
-void
-VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_coefficient, pframes_t nframes, uint32_t which)
-{
-	Sample* const src = srcbuf.data ();
-	Signal*       signal (_signals[which]);
-
-	/* VBAP may distribute the signal across up to 3 speakers depending on
+	/* VBAP may distribute each signal across up to 3 speakers depending on
 	 * the configuration of the speakers.
 	 *
-	 * But the set of speakers in use "this time" may be different from
-	 * the set of speakers "the last time". So we have up to 6 speakers
-	 * involved, and we have to interpolate so that those no longer
-	 * in use are rapidly faded to silence and those newly in use
-	 * are rapidly faded to their correct level. This prevents clicks
-	 * as we change the set of speakers used to put the signal in
-	 * a given position.
+	 * The set of speakers in use "this time" may be different from the set
+	 * used "last time". The gain matrix interpolates from the gains used
+	 * last time to the current ones, so that speakers which are no longer
+	 * in use are rapidly faded to silence and those newly in use are
+	 * rapidly faded to their correct level. This prevents clicks as we
+	 * change the set of speakers used to put a signal in a given position.
 	 *
-	 * However, the speakers are represented by output buffers, and other
-	 * speakers may write to the same buffers, so we cannot use
-	 * anything here that will simply assign new (sample) values
-	 * to the output buffers - everything must be done via mixing
-	 * functions and not assignment/copying.
+	 * Other panners may write to the same output buffers, so the matrix
+	 * only ever mixes into them.
 	 */
 
-	vector<double>::size_type sz = signal->gains.size ();
-
-	assert (sz == obufs.count ().n_audio ());
-
-	int8_t* outputs = (int8_t*)alloca (sz); // on the stack, no malloc
+	_matrix.clear_targets ();
 
-	/* set initial state of each output "record"
-         */
-
-	for (uint32_t o = 0; o < sz; ++o) {
-		outputs[o] = 0;
-	}
-
-	/* for all outputs used this time and last time,
-				 * change the output record to show what has
-				 * happened.
-				 */
-
-	for (int o = 0; o < 3; ++o) {
-		if (signal->outputs[o] != -1) {
-			/* used last time */
-			outputs[signal->outputs[o]] |= 1;
-		}
+	for (uint32_t n = 0; n < _signals.size (); ++n) {
+		Signal const* signal (_signals[n]);
 
-		if (signal->desired_outputs[o] != -1) {
-			/* used this time */
-			outputs[signal->desired_outputs[o]] |= 1 << 1;
-		}
-	}
-
-	/* at this point, we can test a speaker's status:
-	 *
-	 * (*outputs[o] & 1)      <= in use before
-	 * (*outputs[o] & 2)      <= in use this time
-	 * (*outputs[o] & 3) == 3 <= in use both times
-	 * *outputs[o] == 0      <= not in use either time
-	 *
-	 */
-
-	for (int o = 0; o < 3; ++o) {
-		pan_t pan;
-		int   output = signal->desired_outputs[o];
-
-		if (output == -1) {
-			continue;
-		}
-
-		pan = gain_coefficient * signal->desired_gains[o];
-
-		if (pan == 0.0 && signal->gains[output] == 0.0) {
-			/* nothing deing delivered to this output */
-
-			signal->gains[output] = 0.0;
-
-		} else if (fabs (pan - signal->gains[output]) > 0.00001) {
-			/* signal to this output but the gain coefficient has changed, so
-			 * interpolate between them.
-			 */
-
-			AudioBuffer& buf (obufs.get_audio (output));
-			buf.accumulate_with_ramped_gain_from (srcbuf.data (), nframes, signal->gains[output], pan, 0);
-			signal->gains[output] = pan;
-
-		} else {
-			/* signal to this output, same gain as before so just copy with gain */
-
-			mix_buffers_with_gain (obufs.get_audio (output).data (), src, nframes, pan);
-			signal->gains[output] = pan;
-		}
-	}
-
-	/* clean up the outputs that were used last time but not this time */
-
-	for (uint32_t o = 0; o < sz; ++o) {
-		if (outputs[o] == 1) {
-			/* take signal and deliver with a rapid fade out */
-			AudioBuffer& buf (obufs.get_audio (o));
-			buf.accumulate_with_ramped_gain_from (srcbuf.data (), nframes, signal->gains[o], 0.0, 0);
-			signal->gains[o] = 0.0;
+		for (int o = 0; o < 3; ++o) {
+			int const output = signal->desired_outputs[o];
+			if (output == -1) {
+				continue;
+			}
+			_matrix.set_target (n, output, gain_coefficient * signal->desired_gains[o]);
 		}
 	}
 
-	/* note that the output buffers were all silenced at some point
-	 * so anything we didn't write to with this signal (or any others)
-	 * is just as it should be.
-	 */
+	_matrix.apply (inbufs, obufs, nframes);
 }
 
 void
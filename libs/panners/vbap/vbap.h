@@ -25,6 +25,7 @@
 
 #include "pbd/cartesian.h"
 
+#include "ardour/gain_matrix.h"
 #include "ardour/panner.h"
 #include "ardour/panner_shell.h"
 
@@ -67,24 +68,21 @@ public:
 private:
 	struct Signal {
 		PBD::AngularVector  direction;
-		std::vector<double> gains; /* most recently used gain for all speakers */
 
-		int    outputs[3];         /* most recent set of outputs used (2 or 3, depending on dimension) */
 		int    desired_outputs[3]; /* outputs to use the next time we distribute */
 		double desired_gains[3];   /* target gains for desired_outputs */
 
-		Signal (VBAPanner&, uint32_t which, uint32_t n_speakers);
-		void resize_gains (uint32_t n_speakers);
+		Signal ();
 	};
 
 	std::vector<Signal*>            _signals;
 	std::shared_ptr<VBAPSpeakers> _speakers;
+	GainMatrix                      _matrix; /* signals x speakers, holds the gains used last time */
 
 	void compute_gains (double g[3], int ls[3], int azi, int ele);
 	void update ();
 	void clear_signals ();
 
-	void distribute_one (AudioBuffer& src, BufferSet& obufs, gain_t gain_coeff, pframes_t nframes, uint32_t which);
 	void distribute_one_automated (AudioBuffer& src, BufferSet& obufs,
 	                               samplepos_t start, samplepos_t end, pframes_t nframes,
 	                               pan_t** buffers, uint32_t which);
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2024 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _pbd_ws_deque_h_
+#define _pbd_ws_deque_h_
+
+#include <atomic>
+#include <cassert>
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace PBD {
+
+/* Bounded lock free work-stealing deque (Chase-Lev).
+ *
+ * A single owner thread may push() and pop() at the bottom,
+ * any number of other threads may steal() from the top.
+ *
+ * The buffer is not grown on demand. push() fails if the deque
+ * is full, the caller is expected to fall back to a shared queue.
+ * reserve() and clear() must only be called while the deque is
+ * not in use by any thread.
+ *
+ * see D. Chase, Y. Lev, "Dynamic Circular Work-Stealing Deque", SPAA 2005
+ * and N.M. Le et al, "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013
+ */
+template <typename T>
+class /*LIBPBD_API*/ WSDeque
+{
+public:
+	WSDeque (size_t buffer_size = 8)
+		: _buffer (0)
+		, _buffer_mask (0)
+	{
+		reserve (buffer_size);
+	}
+
+	~WSDeque ()
+	{
+		delete[] _buffer;
+	}
+
+	size_t capacity () const {
+		return _buffer_mask + 1;
+	}
+
+	void
+	reserve (size_t buffer_size)
+	{
+		size_t sz = 2;
+		while (sz < buffer_size) {
+			sz <<= 1;
+		}
+		if (_buffer_mask >= sz - 1) {
+			return;
+		}
+		delete[] _buffer;
+		_buffer      = new std::atomic<T>[sz];
+		_buffer_mask = sz - 1;
+		clear ();
+	}
+
+	void
+	clear ()
+	{
+		_top.store (0, std::memory_order_relaxed);
+		_bottom.store (0, std::memory_order_relaxed);
+	}
+
+	/** approximate number of queued items */
+	size_t
+	size () const
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed);
+		int64_t t = _top.load (std::memory_order_relaxed);
+		return b > t ? (size_t)(b - t) : 0;
+	}
+
+	/** add an item at the bottom, must only be called by the owner */
+	bool
+	push (T const& data)
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed);
+		int64_t t = _top.load (std::memory_order_acquire);
+		if (b - t > (int64_t)_buffer_mask) {
+			return false;
+		}
+		_buffer[b & _buffer_mask].store (data, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+		_bottom.store (b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/** take the most recently pushed item, must only be called by the owner */
+	bool
+	pop (T& data)
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed) - 1;
+		_bottom.store (b, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		int64_t t = _top.load (std::memory_order_relaxed);
+
+		if (t > b) {
+			/* empty */
+			_bottom.store (b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		data = _buffer[b & _buffer_mask].load (std::memory_order_relaxed);
+
+		if (t == b) {
+			/* last item, race against thieves */
+			bool ok = _top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			_bottom.store (b + 1, std::memory_order_relaxed);
+			return ok;
+		}
+		return true;
+	}
+
+	/** take the oldest item, may be called by any thread */
+	bool
+	steal (T& data)
+	{
+		int64_t t = _top.load (std::memory_order_acquire);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		int64_t b = _bottom.load (std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		data = _buffer[t & _buffer_mask].load (std::memory_order_relaxed);
+		return _top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+private:
+	char                 _pad0[64];
+	std::atomic<T>*      _buffer;
+	size_t               _buffer_mask;
+	char                 _pad1[64 - sizeof (std::atomic<T>*) - sizeof (size_t)];
+	std::atomic<int64_t> _top;
+	char                 _pad2[64 - sizeof (int64_t)];
+	std::atomic<int64_t> _bottom;
+	char                 _pad3[64 - sizeof (int64_t)];
+};
+
+} // namespace PBD
+
+#endif
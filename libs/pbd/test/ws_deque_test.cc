@@ -0,0 +1,100 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ws_deque_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (WSDequeTest);
+
+void
+WSDequeTest::order ()
+{
+	PBD::WSDeque<intptr_t> q (8);
+	intptr_t                v;
+
+	CPPUNIT_ASSERT (!q.pop (v));
+	CPPUNIT_ASSERT (!q.steal (v));
+
+	for (intptr_t i = 0; i < 4; ++i) {
+		CPPUNIT_ASSERT (q.push (i));
+	}
+	CPPUNIT_ASSERT_EQUAL ((size_t)4, q.size ());
+
+	/* owner takes newest, thieves take oldest */
+	CPPUNIT_ASSERT (q.pop (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)3, v);
+	CPPUNIT_ASSERT (q.steal (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)0, v);
+	CPPUNIT_ASSERT (q.steal (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)1, v);
+	CPPUNIT_ASSERT (q.pop (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)2, v);
+	CPPUNIT_ASSERT (!q.pop (v));
+	CPPUNIT_ASSERT_EQUAL ((size_t)0, q.size ());
+}
+
+void
+WSDequeTest::overflow ()
+{
+	PBD::WSDeque<intptr_t> q (4);
+	intptr_t                v;
+
+	CPPUNIT_ASSERT_EQUAL ((size_t)4, q.capacity ());
+	for (intptr_t i = 0; i < 4; ++i) {
+		CPPUNIT_ASSERT (q.push (i));
+	}
+	CPPUNIT_ASSERT (!q.push (4));
+	CPPUNIT_ASSERT (q.steal (v));
+	CPPUNIT_ASSERT (q.push (4));
+}
+
+void
+WSDequeTest::race ()
+{
+	const int                     n_items = 200000;
+	PBD::WSDeque<intptr_t>        q (64);
+	std::vector<std::atomic<int>> seen (n_items);
+	std::atomic<bool>             done (false);
+	std::vector<std::thread>      thieves;
+
+	for (int i = 0; i < n_items; ++i) {
+		seen[i].store (0);
+	}
+
+	for (int t = 0; t < 3; ++t) {
+		thieves.push_back (std::thread ([&] {
+			intptr_t v;
+			while (!done.load ()) {
+				if (q.steal (v)) {
+					seen[v].fetch_add (1);
+				}
+			}
+		}));
+	}
+
+	int      pushed = 0;
+	intptr_t v;
+	while (pushed < n_items) {
+		if (q.push (pushed)) {
+			++pushed;
+		} else if (q.pop (v)) {
+			seen[v].fetch_add (1);
+		}
+		if ((pushed % 3) == 0 && q.pop (v)) {
+			seen[v].fetch_add (1);
+		}
+	}
+	while (q.pop (v)) {
+		seen[v].fetch_add (1);
+	}
+
+	done.store (true);
+	for (auto& t : thieves) {
+		t.join ();
+	}
+
+	/* every item must have been taken exactly once */
+	for (int i = 0; i < n_items; ++i) {
+		CPPUNIT_ASSERT_EQUAL (1, seen[i].load ());
+	}
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "pbd/ws_deque.h"
+
+class WSDequeTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (WSDequeTest);
+	CPPUNIT_TEST (order);
+	CPPUNIT_TEST (overflow);
+	CPPUNIT_TEST (race);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void order ();
+	void overflow ();
+	void race ();
+};
@@ -120,6 +120,7 @@ OSC::OSC (Session& s, uint32_t port)
 	, default_send_size (0)
 	, default_plugin_size (0)
 	, tick (true)
+	, _feedback_stats_time (0)
 	, bank_dirty (false)
 	, observer_busy (true)
 	, scrub_speed (0)
@@ -329,6 +330,9 @@ OSC::stop ()
 	}
 	_surface.clear();
 
+	flush_feedback ();
+	drop_feedback ();
+
 	/* stop main loop */
 	if (local_server) {
 		g_source_destroy (local_server);
@@ -433,6 +437,8 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, X_("/group/list"), "f", group_list);
 		REGISTER_CALLBACK (serv, X_("/surface/list"), "", surface_list);
 		REGISTER_CALLBACK (serv, X_("/surface/list"), "f", surface_list);
+		REGISTER_CALLBACK (serv, X_("/surface/stats"), "", surface_stats);
+		REGISTER_CALLBACK (serv, X_("/surface/stats"), "f", surface_stats);
 		REGISTER_CALLBACK (serv, X_("/add_marker"), "", add_marker);
 		REGISTER_CALLBACK (serv, X_("/add_marker"), "f", add_marker);
 		REGISTER_CALLBACK (serv, X_("/add_marker"), "s", add_marker_name);
@@ -1145,6 +1151,36 @@ OSC::surface_list (lo_message msg)
 		get_surfaces ();
 }
 
+void
+OSC::surface_stats (lo_message msg)
+{
+	/* Feedback statistics for each client, averaged over the last
+	 * second. Printed like /surface/list, and also sent back as
+	 * /surface/stats url messages/s bytes/s packets/s coalesced/s
+	 */
+	lo_address addr = get_address (msg);
+
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
+
+	PBD::info << string_compose ("\nOSC feedback statistics (%1 clients):\n", _feedback_clients.size ());
+
+	for (FeedbackClients::const_iterator i = _feedback_clients.begin (); i != _feedback_clients.end (); ++i) {
+		FeedbackClient const & fc (i->second);
+		PBD::info << string_compose ("  %1: %2 msg/s, %3 bytes/s, %4 packets/s, %5 coalesced/s\n",
+		                             i->first, fc.messages_ps, fc.bytes_ps, fc.packets_ps, fc.coalesced_ps);
+
+		lo_message reply = lo_message_new ();
+		lo_message_add_string (reply, i->first.c_str ());
+		lo_message_add_float (reply, fc.messages_ps);
+		lo_message_add_float (reply, fc.bytes_ps);
+		lo_message_add_float (reply, fc.packets_ps);
+		lo_message_add_float (reply, fc.coalesced_ps);
+		lo_send_message (addr, X_("/surface/stats"), reply);
+		lo_message_free (reply);
+	}
+	PBD::info << endmsg;
+}
+
 void
 OSC::get_surfaces ()
 {
@@ -5989,6 +6025,7 @@ bool
 OSC::periodic (void)
 {
 	if (observer_busy) {
+		flush_feedback ();
 		return true;
 	}
 	if (!tick) {
@@ -6006,6 +6043,7 @@ OSC::periodic (void)
 			bank_dirty = false;
 			tick = true;
 		}
+		flush_feedback ();
 		return true;
 	}
 
@@ -6050,6 +6088,7 @@ OSC::periodic (void)
 			x++;
 		}
 	}
+	flush_feedback ();
 	return true;
 }
 
@@ -6616,9 +6655,7 @@ OSC::float_message (string path, float val, lo_address addr)
 	reply = lo_message_new ();
 	lo_message_add_float (reply, (float) val);
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
+	queue_feedback (addr, path, path, reply);
 	_lo_lock.unlock ();
 
 	return 0;
@@ -6629,16 +6666,17 @@ OSC::float_message_with_id (std::string path, uint32_t ssid, float value, bool i
 {
 	_lo_lock.lock ();
 	lo_message msg = lo_message_new ();
+	std::string key;
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
+		key = path;
 	} else {
 		lo_message_add_int32 (msg, ssid);
+		key = string_compose ("%1 %2", path, ssid);
 	}
 	lo_message_add_float (msg, value);
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
+	queue_feedback (addr, path, key, msg);
 	_lo_lock.unlock ();
 	return 0;
 }
@@ -6652,9 +6690,7 @@ OSC::int_message (string path, int val, lo_address addr)
 	reply = lo_message_new ();
 	lo_message_add_int32 (reply, (float) val);
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
+	queue_feedback (addr, path, path, reply);
 	_lo_lock.unlock ();
 
 	return 0;
@@ -6665,16 +6701,17 @@ OSC::int_message_with_id (std::string path, uint32_t ssid, int value, bool in_li
 {
 	_lo_lock.lock ();
 	lo_message msg = lo_message_new ();
+	std::string key;
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
+		key = path;
 	} else {
 		lo_message_add_int32 (msg, ssid);
+		key = string_compose ("%1 %2", path, ssid);
 	}
 	lo_message_add_int32 (msg, value);
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
+	queue_feedback (addr, path, key, msg);
 	_lo_lock.unlock ();
 	return 0;
 }
@@ -6688,9 +6725,7 @@ OSC::text_message (string path, string val, lo_address addr)
 	reply = lo_message_new ();
 	lo_message_add_string (reply, val.c_str());
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
+	queue_feedback (addr, path, path, reply);
 	_lo_lock.unlock ();
 
 	return 0;
@@ -6701,21 +6736,168 @@ OSC::text_message_with_id (std::string path, uint32_t ssid, std::string val, boo
 {
 	_lo_lock.lock ();
 	lo_message msg = lo_message_new ();
+	std::string key;
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
+		key = path;
 	} else {
 		lo_message_add_int32 (msg, ssid);
+		key = string_compose ("%1 %2", path, ssid);
 	}
 
 	lo_message_add_string (msg, val.c_str());
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
+	queue_feedback (addr, path, key, msg);
 	_lo_lock.unlock ();
 	return 0;
 }
 
+/* feedback queue, the caller must hold _lo_lock */
+void
+OSC::queue_feedback (lo_address addr, std::string const & path, std::string const & key, lo_message msg)
+{
+	char* u = lo_address_get_url (addr);
+	std::string url (u);
+	free (u);
+
+	FeedbackClient& fc (_feedback_clients[url]);
+	if (!fc.addr) {
+		fc.addr = lo_address_new_from_url (url.c_str ());
+	}
+
+	std::map<std::string, size_t>::const_iterator i = fc.index.find (key);
+	if (i != fc.index.end ()) {
+		/* only the last value is sent */
+		FeedbackMessage& fm (fc.queue[i->second]);
+		lo_message_free (fm.msg);
+		fm.msg = msg;
+		++fc.coalesced;
+		return;
+	}
+
+	fc.index[key] = fc.queue.size ();
+	fc.queue.push_back (FeedbackMessage (path, msg));
+}
+
+bool
+OSC::bundle_feedback (std::string const & url) const
+{
+	for (Surface::const_iterator s = _surface.begin (); s != _surface.end (); ++s) {
+		if (s->remote_url == url) {
+			return !s->feedback[17];
+		}
+	}
+	return true;
+}
+
+void
+OSC::send_feedback (FeedbackClient& fc, bool bundle)
+{
+	/* UDP payload of a 1500 byte ethernet frame */
+	static const size_t max_bundle_size = 1472;
+	/* "#bundle" and time tag */
+	static const size_t bundle_header_size = 16;
+
+	lo_bundle b = 0;
+	size_t size = 0;
+
+	for (std::vector<FeedbackMessage>::const_iterator m = fc.queue.begin (); m != fc.queue.end (); ++m) {
+		size_t const len = lo_message_length (m->msg, m->path.c_str ());
+
+		if (!bundle) {
+			lo_send_message (fc.addr, m->path.c_str (), m->msg);
+			++fc.packets;
+			fc.bytes += len;
+			Glib::usleep (1);
+			continue;
+		}
+
+		if (b && size + len + 4 > max_bundle_size) {
+			lo_send_bundle (fc.addr, b);
+			lo_bundle_free_recursive (b);
+			++fc.packets;
+			b = 0;
+		}
+		if (!b) {
+			b = lo_bundle_new (LO_TT_IMMEDIATE);
+			size = bundle_header_size;
+		}
+		/* the bundle takes its own reference to the message */
+		lo_bundle_add_message (b, m->path.c_str (), m->msg);
+		size += len + 4;
+		fc.bytes += len + 4;
+	}
+
+	if (b) {
+		lo_send_bundle (fc.addr, b);
+		lo_bundle_free_recursive (b);
+		++fc.packets;
+	}
+
+	fc.messages += fc.queue.size ();
+
+	for (std::vector<FeedbackMessage>::const_iterator m = fc.queue.begin (); m != fc.queue.end (); ++m) {
+		lo_message_free (m->msg);
+	}
+	fc.queue.clear ();
+	fc.index.clear ();
+}
+
+void
+OSC::flush_feedback ()
+{
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
+
+	int64_t const now = PBD::get_microseconds ();
+	float const elapsed = (now - _feedback_stats_time) / 1e6f;
+	bool const update_stats = elapsed >= 1.f;
+
+	for (FeedbackClients::iterator i = _feedback_clients.begin (); i != _feedback_clients.end ();) {
+		FeedbackClient& fc (i->second);
+
+		if (!fc.queue.empty ()) {
+			send_feedback (fc, bundle_feedback (i->first));
+		}
+
+		if (!update_stats) {
+			++i;
+			continue;
+		}
+
+		if (fc.messages == 0 && fc.coalesced == 0) {
+			/* idle for a while, forget about it */
+			lo_address_free (fc.addr);
+			_feedback_clients.erase (i++);
+			continue;
+		}
+
+		fc.messages_ps  = fc.messages / elapsed;
+		fc.bytes_ps     = fc.bytes / elapsed;
+		fc.packets_ps   = fc.packets / elapsed;
+		fc.coalesced_ps = fc.coalesced / elapsed;
+		fc.messages = fc.bytes = fc.packets = fc.coalesced = 0;
+		++i;
+	}
+
+	if (update_stats) {
+		_feedback_stats_time = now;
+	}
+}
+
+void
+OSC::drop_feedback ()
+{
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
+
+	for (FeedbackClients::iterator i = _feedback_clients.begin (); i != _feedback_clients.end (); ++i) {
+		for (std::vector<FeedbackMessage>::const_iterator m = i->second.queue.begin (); m != i->second.queue.end (); ++m) {
+			lo_message_free (m->msg);
+		}
+		lo_address_free (i->second.addr);
+	}
+	_feedback_clients.clear ();
+}
+
 // we have to have a sorted list of stripables that have sends pointed at our aux
 // we can use the one in osc.cc to get an aux list
 OSC::Sorted
@@ -26,6 +26,7 @@
 #define ardour_osc_h
 
 #include <bitset>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -191,6 +192,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 		 * [14] - use OSC 1.0 only (#reply -> /reply)
 		 * [15] - report 8x8 trigger grid status
 		 * [16] - report mixer scene status
+		 * [17] - send feedback as individual messages instead of bundles
 		 *
 		 * Strip_type bits:
 		 * [0] - Audio Tracks
@@ -298,6 +300,48 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	uint32_t default_send_size;
 	uint32_t default_plugin_size;
 	bool tick;
+
+	/* Feedback sent via float_message () and friends is queued per client.
+	 * Only the last value per path (and ssid) is kept, the queue is
+	 * sent as MTU sized bundles on every periodic tick.
+	 */
+	struct FeedbackMessage {
+		FeedbackMessage (std::string const & p, lo_message m) : path (p), msg (m) {}
+		std::string path;
+		lo_message  msg;
+	};
+
+	struct FeedbackClient {
+		FeedbackClient ()
+			: addr (0)
+			, messages (0), bytes (0), packets (0), coalesced (0)
+			, messages_ps (0), bytes_ps (0), packets_ps (0), coalesced_ps (0)
+		{}
+
+		lo_address                    addr;
+		std::vector<FeedbackMessage>  queue;
+		std::map<std::string, size_t> index; // path + ssid -> position in queue
+
+		/* statistics since the last update, and the resulting rates per second */
+		uint64_t messages;
+		uint64_t bytes;
+		uint64_t packets;
+		uint64_t coalesced;
+		float    messages_ps;
+		float    bytes_ps;
+		float    packets_ps;
+		float    coalesced_ps;
+	};
+
+	typedef std::map<std::string, FeedbackClient> FeedbackClients;
+	FeedbackClients _feedback_clients; // by URL, protected by _lo_lock
+	int64_t         _feedback_stats_time;
+
+	void queue_feedback (lo_address addr, std::string const & path, std::string const & key, lo_message msg);
+	void send_feedback (FeedbackClient& fc, bool bundle);
+	void flush_feedback ();
+	void drop_feedback ();
+	bool bundle_feedback (std::string const & url) const;
 	bool bank_dirty;
 	bool observer_busy;
 	float scrub_speed;		// Current scrub speed
@@ -350,6 +394,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	void routes_list (lo_message msg);
 	int group_list (lo_message msg);
 	void surface_list (lo_message msg);
+	void surface_stats (lo_message msg);
 	void transport_sample (lo_message msg);
 	void transport_speed (lo_message msg);
 	void record_enabled (lo_message msg);
@@ -407,6 +452,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK_MSG(sel_previous);
 	PATH_CALLBACK_MSG(sel_next);
 	PATH_CALLBACK_MSG(surface_list);
+	PATH_CALLBACK_MSG(surface_stats);
 	PATH_CALLBACK_MSG(transport_sample);
 	PATH_CALLBACK_MSG(transport_speed);
 	PATH_CALLBACK_MSG(record_enabled);
@@ -58,6 +58,46 @@ ClientContext::update_state (const NodeState& node_state)
 	_state.insert (node_state);
 }
 
+void
+ClientContext::queue_output (const NodeState& node_state)
+{
+	PendingMap::iterator it = _pending.find (node_state);
+
+	if (it != _pending.end ()) {
+		*it->second = NodeStateMessage (node_state);
+		return;
+	}
+
+	_pending[node_state] = _output_buf.insert (_output_buf.end (), NodeStateMessage (node_state));
+}
+
+void
+ClientContext::take_output (ClientOutputBuffer& out)
+{
+	out.splice (out.end (), _output_buf);
+	_pending.clear ();
+}
+
+NodeStateMessage
+ClientContext::pop_output ()
+{
+	NodeStateMessage msg = _output_buf.front ();
+	_pending.erase (msg.state ());
+	_output_buf.pop_front ();
+	return msg;
+}
+
+bool
+ClientContext::watches (const NodeState& node_state) const
+{
+	/* all strip nodes are addressed by strip id first */
+	if (node_state.n_addr () < 1 || node_state.node ().compare (0, 6, "strip_") != 0) {
+		return true;
+	}
+
+	return watches_strip (node_state.nth_addr (0));
+}
+
 std::string
 ClientContext::debug_str ()
 {
@@ -22,6 +22,8 @@
 #include <set>
 #include <list>
 
+#include <boost/unordered_map.hpp>
+
 #include "message.h"
 #include "state.h"
 
@@ -35,7 +37,8 @@ class ClientContext
 {
 public:
 	ClientContext (Client wsi)
-	    : _wsi (wsi){};
+	    : _wsi (wsi)
+	    , _batch (false){};
 	virtual ~ClientContext (){};
 
 	Client wsi () const
@@ -46,11 +49,43 @@ public:
 	bool has_state (const NodeState&);
 	void update_state (const NodeState&);
 
-	ClientOutputBuffer& output_buf ()
+	/* pending updates, a newer update for the same node and address
+	 * replaces the pending one in place */
+	void queue_output (const NodeState&);
+	void take_output (ClientOutputBuffer&);
+	NodeStateMessage pop_output ();
+
+	bool has_output () const
+	{
+		return !_output_buf.empty ();
+	}
+
+	/* send all pending updates in a single frame (JSON array) */
+	bool batch () const
+	{
+		return _batch;
+	}
+
+	void set_batch (bool yn)
+	{
+		_batch = yn;
+	}
+
+	/* strips this client wants feedback for, all if empty */
+	typedef std::set<uint32_t> StripSet;
+
+	void set_strips (const StripSet& strips)
 	{
-		return _output_buf;
+		_strips = strips;
 	}
 
+	bool watches_strip (uint32_t strip_id) const
+	{
+		return _strips.empty () || _strips.find (strip_id) != _strips.end ();
+	}
+
+	bool watches (const NodeState&) const;
+
 	std::string debug_str ();
 
 private:
@@ -60,6 +95,12 @@ private:
 	ClientState                 _state;
 
 	ClientOutputBuffer _output_buf;
+
+	typedef boost::unordered_map<NodeState, ClientOutputBuffer::iterator> PendingMap;
+	PendingMap _pending;
+
+	bool     _batch;
+	StripSet _strips;
 };
 
 } // namespace ArdourSurface
@@ -38,7 +38,9 @@ WebsocketsDispatcher::NodeMethodMap
 		NODE_METHOD_PAIR (strip_pan)
 		NODE_METHOD_PAIR (strip_mute)
 		NODE_METHOD_PAIR (strip_plugin_enable)
-		NODE_METHOD_PAIR (strip_plugin_param_value);
+		NODE_METHOD_PAIR (strip_plugin_param_value)
+		NODE_METHOD_PAIR (feedback_batch)
+		NODE_METHOD_PAIR (feedback_strips);
 
 void
 WebsocketsDispatcher::dispatch (Client client, const NodeStateMessage& msg)
@@ -267,6 +269,32 @@ WebsocketsDispatcher::strip_plugin_param_value_handler (Client client, const Nod
 	}
 }
 
+void
+WebsocketsDispatcher::feedback_batch_handler (Client client, const NodeStateMessage& msg)
+{
+	const NodeState& state = msg.state ();
+
+	if (msg.is_write () && (state.n_val () > 0)) {
+		server ().set_client_batch (client, state.nth_val (0));
+	}
+}
+
+void
+WebsocketsDispatcher::feedback_strips_handler (Client client, const NodeStateMessage& msg)
+{
+	/* values are the ids of the strips to receive feedback for,
+	 * a message without values restores feedback for all strips */
+	const NodeState& state = msg.state ();
+
+	ClientContext::StripSet strips;
+
+	for (int i = 0; i < state.n_val (); ++i) {
+		strips.insert (static_cast<int> (state.nth_val (i)));
+	}
+
+	server ().set_client_strips (client, strips);
+}
+
 void
 WebsocketsDispatcher::update (Client client, std::string node, TypedValue val1)
 {
@@ -215,6 +215,9 @@ ArdourFeedback::poll () const
 	Glib::Threads::Mutex::Lock lock (mixer ().mutex ());
 
 	for (ArdourMixer::StripMap::iterator it = mixer ().strips ().begin (); it != mixer ().strips ().end (); ++it) {
+		if (!server ().strip_watched (it->first)) {
+			continue;
+		}
 		double db = it->second->meter_level_db ();
 		update_all (Node::strip_meter, it->first, db);
 	}
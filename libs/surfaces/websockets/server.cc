@@ -16,6 +16,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <vector>
+
 #ifndef NDEBUG
 #include <iostream>
 #endif
@@ -213,10 +215,14 @@ WebsocketsServer::update_client (Client wsi, const NodeState& state, bool force)
 		return;
 	}
 
+	if (!it->second.watches (state)) {
+		return;
+	}
+
 	if (force || !it->second.has_state (state)) {
 		/* write to client only if state was updated */
 		it->second.update_state (state);
-		it->second.output_buf ().push_back (NodeStateMessage (state));
+		it->second.queue_output (state);
 		request_write (wsi);
 	}
 }
@@ -229,6 +235,41 @@ WebsocketsServer::update_all_clients (const NodeState& state, bool force)
 	}
 }
 
+void
+WebsocketsServer::set_client_batch (Client wsi, bool yn)
+{
+	ClientContextMap::iterator it = _client_ctx.find (wsi);
+	if (it != _client_ctx.end ()) {
+		it->second.set_batch (yn);
+	}
+}
+
+void
+WebsocketsServer::set_client_strips (Client wsi, const ClientContext::StripSet& strips)
+{
+	ClientContextMap::iterator it = _client_ctx.find (wsi);
+	if (it == _client_ctx.end ()) {
+		return;
+	}
+
+	it->second.set_strips (strips);
+
+	/* newly watched strips may be out of date */
+	dispatcher ().update_all_nodes (wsi);
+}
+
+bool
+WebsocketsServer::strip_watched (uint32_t strip_id) const
+{
+	for (ClientContextMap::const_iterator it = _client_ctx.begin (); it != _client_ctx.end (); ++it) {
+		if (it->second.watches_strip (strip_id)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 int
 WebsocketsServer::add_client (Client wsi)
 {
@@ -282,15 +323,18 @@ WebsocketsServer::write_client (Client wsi)
 		return 1;
 	}
 
-	ClientOutputBuffer& pending = it->second.output_buf ();
-	if (pending.empty ()) {
+	ClientContext& ctx = it->second;
+	if (!ctx.has_output ()) {
 		return 0;
 	}
 
+	if (ctx.batch ()) {
+		return write_client_batch (ctx);
+	}
+
 	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback */
 
-	NodeStateMessage msg = pending.front ();
-	pending.pop_front ();
+	NodeStateMessage msg = ctx.pop_output ();
 
 	unsigned char out_buf[1024];
 	int len = msg.serialize (out_buf + LWS_PRE, 1024 - LWS_PRE);
@@ -306,13 +350,54 @@ WebsocketsServer::write_client (Client wsi)
 		PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
 	}
 
-	if (!pending.empty ()) {
+	if (ctx.has_output ()) {
 		request_write (wsi);
 	}
 
 	return 0;
 }
 
+int
+WebsocketsServer::write_client_batch (ClientContext& ctx)
+{
+	/* all pending updates go out as a single JSON array */
+
+	ClientOutputBuffer pending;
+	ctx.take_output (pending);
+
+	std::vector<unsigned char> frame (LWS_PRE);
+	frame.reserve (LWS_PRE + 64 * pending.size ());
+	frame.push_back ('[');
+
+	for (ClientOutputBuffer::const_iterator it = pending.begin (); it != pending.end (); ++it) {
+		unsigned char msg_buf[1024];
+		int len = it->serialize (msg_buf, sizeof (msg_buf));
+
+		if (len <= 0) {
+			PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
+			continue;
+		}
+#ifdef PRINT_TRAFFIC
+		std::cerr << "TX " << it->state ().debug_str () << std::endl;
+#endif
+		if (frame.size () > LWS_PRE + 1) {
+			frame.push_back (',');
+		}
+
+		frame.insert (frame.end (), msg_buf, msg_buf + len);
+	}
+
+	frame.push_back (']');
+
+	int len = frame.size () - LWS_PRE;
+
+	if (lws_write (ctx.wsi (), &frame[LWS_PRE], len, LWS_WRITE_TEXT) != len) {
+		return 1;
+	}
+
+	return 0;
+}
+
 int
 WebsocketsServer::send_availsurf_hdr (Client wsi)
 {
@@ -53,6 +53,12 @@ public:
 	void update_client (Client, const NodeState&, bool);
 	void update_all_clients (const NodeState&, bool);
 
+	void set_client_batch (Client, bool);
+	void set_client_strips (Client, const ClientContext::StripSet&);
+
+	/* true if at least one client wants feedback for the strip */
+	bool strip_watched (uint32_t) const;
+
 private:
 #if LWS_LIBRARY_VERSION_MAJOR < 3
 	struct lws_protocol_vhost_options _lws_vhost_opt;
@@ -72,6 +78,7 @@ private:
 	int del_client (Client);
 	int recv_client (Client, void*, size_t);
 	int write_client (Client);
+	int write_client_batch (ClientContext&);
 	int send_availsurf_hdr (Client);
 	int send_availsurf_body (Client);
 
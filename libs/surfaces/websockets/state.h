@@ -47,6 +47,8 @@ namespace Node
 	const std::string transport_bbt                  = "transport_bbt";
 	const std::string transport_roll                 = "transport_roll";
 	const std::string transport_record               = "transport_record";
+	const std::string feedback_batch                 = "feedback_batch";
+	const std::string feedback_strips                = "feedback_strips";
 } // namespace Node
 
 typedef std::vector<uint32_t>   AddressVector;
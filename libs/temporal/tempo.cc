@@ -806,6 +806,7 @@ GridIterator::valid_for (TempoMap const & m, superclock_t start, uint32_t bmod,
 /* TEMPOMAP */
 
 TempoMap::TempoMap (Tempo const & initial_tempo, Meter const & initial_meter)
+	: _index_valid (false)
 {
 	TempoPoint* tp = new TempoPoint (*this, initial_tempo, 0, Beats(), BBT_Time());
 	MeterPoint* mp = new MeterPoint (*this, initial_meter, 0, Beats(), BBT_Time());
@@ -822,11 +823,13 @@ TempoMap::~TempoMap()
 }
 
 TempoMap::TempoMap (XMLNode const & node, int version)
+	: _index_valid (false)
 {
 	set_state (node, version);
 }
 
 TempoMap::TempoMap (TempoMap const & other)
+	: _index_valid (false)
 {
 	copy_points (other);
 }
@@ -845,6 +848,8 @@ TempoMap::copy_points (TempoMap const & other)
 	TempoPoint const * tp;
 	MeterPoint const * mp;
 
+	invalidate_index ();
+
 	for (auto const & point : other._points) {
 		if ((mt = dynamic_cast<MusicTimePoint const *> (&point))) {
 			MusicTimePoint* mtp = new MusicTimePoint (*mt);
@@ -1211,6 +1216,8 @@ TempoMap::add_meter (MeterPoint* mp)
 bool
 TempoMap::clear_tempos_before (timepos_t const & t, bool stop_at_music_time)
 {
+	invalidate_index ();
+
 	if (_tempos.size() < 2) {
 		return false;
 	}
@@ -1265,6 +1272,8 @@ TempoMap::clear_tempos_before (timepos_t const & t, bool stop_at_music_time)
 bool
 TempoMap::clear_tempos_after (timepos_t const & t, bool stop_at_music_time)
 {
+	invalidate_index ();
+
 	if (_tempos.size() < 2) {
 		return false;
 	}
@@ -1414,6 +1423,8 @@ TempoMap::core_add_point (Point* pp)
 	Points::iterator p;
 	const Beats beats_limit = pp->beats();
 
+	invalidate_index ();
+
 	for (p = _points.begin(); p != _points.end() && p->beats() < beats_limit; ++p);
 	_points.insert (p, *pp);
 }
@@ -1425,6 +1436,8 @@ TempoMap::core_add_tempo (TempoPoint* tp, bool& replaced)
 	const superclock_t sclock_limit = tp->sclock();
 	const Beats beats_limit = tp->beats ();
 
+	invalidate_index ();
+
 	for (t = _tempos.begin(); t != _tempos.end() && t->beats() < beats_limit; ++t);
 
 	if (t != _tempos.end()) {
@@ -1451,6 +1464,8 @@ TempoMap::core_add_meter (MeterPoint* mp, bool& replaced)
 	const superclock_t sclock_limit = mp->sclock();
 	const Beats beats_limit = mp->beats ();
 
+	invalidate_index ();
+
 	for (m = _meters.begin(); m != _meters.end() && m->beats() < beats_limit; ++m);
 
 	if (m != _meters.end()) {
@@ -1473,6 +1488,8 @@ TempoMap::core_add_bartime (MusicTimePoint* mtp, bool& replaced)
 	MusicTimes::iterator m;
 	const superclock_t sclock_limit = mtp->sclock();
 
+	invalidate_index ();
+
 	for (m = _bartimes.begin(); m != _bartimes.end() && m->sclock() < sclock_limit; ++m);
 
 	if (m != _bartimes.end()) {
@@ -1540,6 +1557,8 @@ TempoMap::core_remove_tempo (TempoPoint const & tp)
 {
 	Tempos::iterator t;
 
+	invalidate_index ();
+
 	/* the argument is likely to be a Point-derived object that doesn't
 	 * actually exist in this TempoMap, since the caller called
 	 * TempoMap::write_copy() in order to perform an RCU operation, but
@@ -1655,6 +1674,8 @@ TempoMap::core_remove_bartime (MusicTimePoint const & mtp)
 {
 	MusicTimes::iterator m;
 
+	invalidate_index ();
+
 	/* the argument is likely to be a Point-derived object that doesn't
 	 * actually exist in this TempoMap, since the caller called
 	 * TempoMap::write_copy() in order to perform an RCU operation, but
@@ -1707,6 +1728,8 @@ TempoMap::remove_point (Point const & point)
 {
 	Points::iterator p;
 
+	invalidate_index ();
+
 	/* Again, we do not allow multiple MusicTimePoints at the same
 	 * location, so if sclock() matches, @param point matches
 	 * the point in the list.
@@ -1724,6 +1747,8 @@ TempoMap::remove_point (Point const & point)
 void
 TempoMap::reset_starting_at (superclock_t sc)
 {
+	invalidate_index ();
+
 	DEBUG_TRACE (DEBUG::MapReset, string_compose ("reset starting at %1\n", sc));
 #ifndef NDEBUG
 	if (DEBUG_ENABLED(DEBUG::MapReset)) {
@@ -1943,6 +1968,8 @@ TempoMap::move_meter (MeterPoint const & mp, timepos_t const & when, bool push)
 	TEMPO_MAP_ASSERT (!_tempos.empty());
 	TEMPO_MAP_ASSERT (!_meters.empty());
 
+	invalidate_index ();
+
 	if (_meters.size() < 2 || mp == _meters.front()) {
 		/* not movable */
 		return false;
@@ -2082,6 +2109,8 @@ TempoMap::move_tempo (TempoPoint const & tp, timepos_t const & when, bool push)
 	TEMPO_MAP_ASSERT (!_tempos.empty());
 	TEMPO_MAP_ASSERT (!_meters.empty());
 
+	invalidate_index ();
+
 	if (_tempos.size() < 2 || tp == _tempos.front()) {
 		/* not movable */
 		return false;
@@ -2281,6 +2310,8 @@ TempoMap::core_remove_meter (MeterPoint const & mp)
 {
 	Meters::iterator m;
 
+	invalidate_index ();
+
 	/* the argument is likely to be a Point-derived object that doesn't
 	 * actually exist in this TempoMap, since the caller called
 	 * TempoMap::write_copy() in order to perform an RCU operation, but
@@ -2488,39 +2519,83 @@ TempoMap::_get_tempo_and_meter (typename const_traits_t::tempo_point_type & tp,
 
 	can_match = (can_match || arg == typename const_traits_t::time_type ());
 
-	/* Set return tempo and meter points by value using the starting tempo
-	 * and meter passed in.
-	 *
-	 * Then advance through all points, resetting either tempo and/or meter
-	 * until we find a point beyond (or equal to, if @p can_match is
-	 * true) the @p arg (end time)
-	 */
+	if (_index_valid) {
 
-	for (tp = tstart, mp = mstart, p = begini; p != endi; ++p) {
+		/* Binary search the tempo and meter tables for the last point
+		 * before (or at, if @p can_match is true) the @p arg (end
+		 * time). This gives the same result as the walk below, since
+		 * both tables are in _points order.
+		 */
 
-		typename const_traits_t::tempo_point_type tpp;
-		typename const_traits_t::meter_point_type mpp;
+		auto usable = [&] (Point const & pt) { return can_match ? !((pt.*method)() > arg) : !((pt.*method)() >= arg); };
 
-		if (!tempo_done && (tpp = dynamic_cast<typename const_traits_t::tempo_point_type> (&(*p))) != 0) {
-			if ((can_match && (((*p).*method)() > arg)) || (!can_match && (((*p).*method)() >= arg))) {
-				tempo_done = true;
-			} else {
-				tp = tpp;
-				last_used = p;
-			}
+		std::vector<IndexedPoint<TempoPoint> >::const_iterator ti =
+			std::partition_point (_tempo_index.begin(), _tempo_index.end(), [&usable] (IndexedPoint<TempoPoint> const & ip) { return usable (*ip.point); });
+		std::vector<IndexedPoint<MeterPoint> >::const_iterator mi =
+			std::partition_point (_meter_index.begin(), _meter_index.end(), [&usable] (IndexedPoint<MeterPoint> const & ip) { return usable (*ip.point); });
+
+		Point*   last = 0;
+		uint32_t last_order = 0;
+
+		if (ti == _tempo_index.begin()) {
+			tp = tstart;
+		} else {
+			--ti;
+			tp = ti->point;
+			last = ti->point;
+			last_order = ti->order;
 		}
 
-		if (!meter_done && (mpp = dynamic_cast<typename const_traits_t::meter_point_type> (&(*p))) != 0) {
-			if ((can_match && (((*p).*method)() > arg)) || (!can_match && (((*p).*method)() >= arg))) {
-				meter_done = true;
-			} else {
-				mp = mpp;
-				last_used = p;
+		if (mi == _meter_index.begin()) {
+			mp = mstart;
+		} else {
+			--mi;
+			mp = mi->point;
+			if (!last || mi->order >= last_order) {
+				last = mi->point;
 			}
 		}
 
-		if (meter_done && tempo_done) {
-			break;
+		if (last) {
+			last_used = Points::s_iterator_to (*last);
+		}
+
+	} else {
+
+		/* Set return tempo and meter points by value using the starting tempo
+		 * and meter passed in.
+		 *
+		 * Then advance through all points, resetting either tempo and/or meter
+		 * until we find a point beyond (or equal to, if @p can_match is
+		 * true) the @p arg (end time)
+		 */
+
+		for (tp = tstart, mp = mstart, p = begini; p != endi; ++p) {
+
+			typename const_traits_t::tempo_point_type tpp;
+			typename const_traits_t::meter_point_type mpp;
+
+			if (!tempo_done && (tpp = dynamic_cast<typename const_traits_t::tempo_point_type> (&(*p))) != 0) {
+				if ((can_match && (((*p).*method)() > arg)) || (!can_match && (((*p).*method)() >= arg))) {
+					tempo_done = true;
+				} else {
+					tp = tpp;
+					last_used = p;
+				}
+			}
+
+			if (!meter_done && (mpp = dynamic_cast<typename const_traits_t::meter_point_type> (&(*p))) != 0) {
+				if ((can_match && (((*p).*method)() > arg)) || (!can_match && (((*p).*method)() >= arg))) {
+					meter_done = true;
+				} else {
+					mp = mpp;
+					last_used = p;
+				}
+			}
+
+			if (meter_done && tempo_done) {
+				break;
+			}
 		}
 	}
 
@@ -3307,6 +3382,8 @@ TempoMap::get_state () const
 int
 TempoMap::set_state (XMLNode const & node, int version)
 {
+	invalidate_index ();
+
 	if (version <= 6000) {
 		return set_state_3x (node);
 	}
@@ -3566,6 +3643,8 @@ TempoMap::n_tempos () const
 bool
 TempoMap::remove_time (timepos_t const & pos, timecnt_t const & duration)
 {
+	invalidate_index ();
+
 	superclock_t start (pos.superclocks());
 	superclock_t end ((pos + duration).superclocks());
 	superclock_t shift (duration.superclocks());
@@ -4247,9 +4326,43 @@ TempoMap::write_copy()
 	return _map_mgr.write_copy();
 }
 
+void
+TempoMap::build_index ()
+{
+	uint32_t order = 0;
+
+	_tempo_index.clear ();
+	_meter_index.clear ();
+	_tempo_index.reserve (_tempos.size());
+	_meter_index.reserve (_meters.size());
+
+	for (Points::iterator p = _points.begin(); p != _points.end(); ++p, ++order) {
+		TempoPoint* tp;
+		MeterPoint* mp;
+
+		if ((tp = dynamic_cast<TempoPoint*> (&(*p))) != 0) {
+			_tempo_index.push_back (IndexedPoint<TempoPoint> (tp, order));
+		}
+		if ((mp = dynamic_cast<MeterPoint*> (&(*p))) != 0) {
+			_meter_index.push_back (IndexedPoint<MeterPoint> (mp, order));
+		}
+	}
+
+	/* _tempos and _meters may contain points that are (wrongly) not
+	 * present in _points; don't trust the index in that case.
+	 */
+
+	_index_valid = (_tempo_index.size() == _tempos.size() && _meter_index.size() == _meters.size());
+}
+
 int
 TempoMap::update (TempoMap::WritableSharedPtr m)
 {
+	/* the map is immutable once published, so this is the one place
+	 * where the lookup index needs to be (re)built.
+	 */
+	m->build_index ();
+
 	if (!_map_mgr.update (m)) {
 		return -1;
 	}
@@ -4501,6 +4614,8 @@ TempoMap::parse_meter_state_3x (const XMLNode& node, LegacyMeterState& lms)
 int
 TempoMap::set_state_3x (const XMLNode& node)
 {
+	invalidate_index ();
+
 	XMLNodeList nlist;
 	XMLNodeConstIterator niter;
 
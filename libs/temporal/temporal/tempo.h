@@ -19,6 +19,7 @@
 #ifndef __temporal_tempo_h__
 #define __temporal_tempo_h__
 
+#include <algorithm>
 #include <list>
 #include <string>
 #include <vector>
@@ -763,7 +764,7 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 	/* and now on with the rest of the show ... */
 
   public:
-	LIBTEMPORAL_API TempoMap () {}
+	LIBTEMPORAL_API TempoMap () : _index_valid (false) {}
 	LIBTEMPORAL_API TempoMap (Tempo const& initial_tempo, Meter const& initial_meter);
 	LIBTEMPORAL_API TempoMap (TempoMap const&);
 	LIBTEMPORAL_API TempoMap (XMLNode const&, int version);
@@ -874,6 +875,15 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 			return _tempos.front();
 		}
 
+		if (_index_valid) {
+			std::vector<IndexedPoint<TempoPoint> >::const_iterator i =
+				std::partition_point (_tempo_index.begin(), _tempo_index.end(), [&cmp, &when] (IndexedPoint<TempoPoint> const & ip) { return cmp (*ip.point, when); });
+			if (i == _tempo_index.begin()) {
+				return _tempos.front();
+			}
+			return *((i - 1)->point);
+		}
+
 		Tempos::const_iterator prev = _tempos.end();
 		for (Tempos::const_iterator t = _tempos.begin(); t != _tempos.end(); ++t) {
 			if (cmp (*t, when)) {
@@ -895,6 +905,15 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 			return _meters.front();
 		}
 
+		if (_index_valid) {
+			std::vector<IndexedPoint<MeterPoint> >::const_iterator i =
+				std::partition_point (_meter_index.begin(), _meter_index.end(), [&cmp, &when] (IndexedPoint<MeterPoint> const & ip) { return cmp (*ip.point, when); });
+			if (i == _meter_index.begin()) {
+				return _meters.front();
+			}
+			return *((i - 1)->point);
+		}
+
 		Meters::const_iterator prev = _meters.end();
 		for (Meters::const_iterator m = _meters.begin(); m != _meters.end(); ++m) {
 			if (cmp (*m, when)) {
@@ -998,6 +1017,27 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 	MusicTimes   _bartimes;
 	Points       _points;
 
+	/* Sorted tables of the tempo and meter points, built by ::update()
+	 * right before a map is published. A published map is never modified,
+	 * so lookups (mostly from RT threads) can binary search these instead
+	 * of walking the lists from the start. The times are always read from
+	 * the points themselves; only the membership and order of the points
+	 * is captured here, and any change to those invalidates the index
+	 * (the linear walks are used until it is rebuilt).
+	 */
+	template<typename T> struct IndexedPoint {
+		IndexedPoint (T* p, uint32_t o) : point (p), order (o) {}
+		T*       point;
+		uint32_t order; /* position in _points */
+	};
+
+	std::vector<IndexedPoint<TempoPoint> > _tempo_index;
+	std::vector<IndexedPoint<MeterPoint> > _meter_index;
+	bool                                   _index_valid;
+
+	void build_index ();
+	void invalidate_index () { _index_valid = false; }
+
 	int set_tempos_from_state (XMLNode const &);
 	int set_meters_from_state (XMLNode const &);
 	int set_music_times_from_state (XMLNode const &);
@@ -0,0 +1,113 @@
+#include <stdlib.h>
+
+#include "pbd/microseconds.h"
+#include "pbd/stateful.h"
+#include "pbd/xml++.h"
+
+#include "temporal/tempo.h"
+
+#include "TempoMapLookupTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TempoMapLookupTest);
+
+using namespace Temporal;
+
+/* number of tempo changes in the test map (a meter change is added for
+ * every 8th tempo)
+ */
+static const int n_tempos = 2000;
+
+void
+TempoMapLookupTest::setUp ()
+{
+	_orig_state = &TempoMap::use()->get_state ();
+
+	TempoMap::WritableSharedPtr tmap (TempoMap::write_copy());
+
+	for (int i = 1; i <= n_tempos; ++i) {
+		(void) tmap->set_tempo (Tempo (90 + (i % 60), 4), BBT_Argument (2 * i + 1, 1, 0));
+		if ((i % 8) == 0) {
+			(void) tmap->set_meter (Meter (3 + (i % 5), 4), BBT_Argument (2 * i + 1, 1, 0));
+		}
+	}
+
+	/* publishing the map builds the lookup index */
+	TempoMap::update (tmap);
+}
+
+void
+TempoMapLookupTest::tearDown ()
+{
+	TempoMap::WritableSharedPtr tmap (TempoMap::write_copy());
+	tmap->set_state (*_orig_state, PBD::Stateful::current_state_version);
+	TempoMap::update (tmap);
+	delete _orig_state;
+}
+
+void
+TempoMapLookupTest::indexedLookupTest ()
+{
+	TempoMap::SharedPtr indexed (TempoMap::use());
+
+	/* a copy is not indexed, and uses the linear walks */
+	TempoMap linear (*indexed);
+
+	CPPUNIT_ASSERT_EQUAL (indexed->n_tempos(), linear.n_tempos());
+	CPPUNIT_ASSERT_EQUAL (indexed->n_meters(), linear.n_meters());
+
+	const superclock_t end = indexed->superclock_at (BBT_Argument (2 * n_tempos + 10, 1, 0));
+	const superclock_t step = end / 10007;
+
+	for (superclock_t sc = 0; sc < end; sc += step) {
+		const timepos_t pos (timepos_t::from_superclock (sc));
+
+		CPPUNIT_ASSERT_EQUAL (indexed->tempo_at (sc).sclock(), linear.tempo_at (sc).sclock());
+		CPPUNIT_ASSERT_EQUAL (indexed->meter_at (sc).sclock(), linear.meter_at (sc).sclock());
+
+		const Beats qn (indexed->quarters_at (pos));
+		CPPUNIT_ASSERT (qn == linear.quarters_at (pos));
+		CPPUNIT_ASSERT_EQUAL (indexed->tempo_at (qn).sclock(), linear.tempo_at (qn).sclock());
+		CPPUNIT_ASSERT_EQUAL (indexed->superclock_at (qn), linear.superclock_at (qn));
+
+		const BBT_Argument bbt (indexed->bbt_at (pos));
+		CPPUNIT_ASSERT (bbt == linear.bbt_at (pos));
+		CPPUNIT_ASSERT_EQUAL (indexed->meter_at (bbt).sclock(), linear.meter_at (bbt).sclock());
+		CPPUNIT_ASSERT (indexed->quarters_at (bbt) == linear.quarters_at (bbt));
+
+		/* exactly at a point, with and without can_match */
+		TempoPoint const & tp (indexed->tempo_at (sc));
+		CPPUNIT_ASSERT_EQUAL (indexed->metric_at (tp.beats(), false).tempo().sclock(), linear.metric_at (tp.beats(), false).tempo().sclock());
+		CPPUNIT_ASSERT_EQUAL (indexed->metric_at (tp.beats(), true).tempo().sclock(), linear.metric_at (tp.beats(), true).tempo().sclock());
+	}
+}
+
+void
+TempoMapLookupTest::lookupBenchmark ()
+{
+	TempoMap::SharedPtr indexed (TempoMap::use());
+	TempoMap linear (*indexed);
+
+	const superclock_t end = indexed->superclock_at (BBT_Argument (2 * n_tempos + 10, 1, 0));
+	const int n_lookups = 100000;
+	const superclock_t step = end / n_lookups;
+
+	Beats sum_indexed;
+	Beats sum_linear;
+
+	PBD::microseconds_t start = PBD::get_microseconds ();
+	for (superclock_t sc = 0; sc < end; sc += step) {
+		sum_indexed += indexed->quarters_at (timepos_t::from_superclock (sc));
+	}
+	const PBD::microseconds_t t_indexed = PBD::get_microseconds () - start;
+
+	start = PBD::get_microseconds ();
+	for (superclock_t sc = 0; sc < end; sc += step) {
+		sum_linear += linear.quarters_at (timepos_t::from_superclock (sc));
+	}
+	const PBD::microseconds_t t_linear = PBD::get_microseconds () - start;
+
+	CPPUNIT_ASSERT (sum_indexed == sum_linear);
+
+	std::cerr << "\nTempoMap lookups (" << n_tempos << " tempos, " << n_lookups << " x quarters_at): "
+	          << "indexed " << t_indexed << " us, linear " << t_linear << " us\n";
+}
@@ -0,0 +1,20 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class TempoMapLookupTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(TempoMapLookupTest);
+	CPPUNIT_TEST(indexedLookupTest);
+	CPPUNIT_TEST(lookupBenchmark);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void indexedLookupTest();
+	void lookupBenchmark();
+
+private:
+	XMLNode* _orig_state;
+};
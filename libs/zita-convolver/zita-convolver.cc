@@ -65,6 +65,7 @@ Convproc::Convproc (void)
 	, _maxpart (0)
 	, _nlevels (0)
 	, _latecnt (0)
+	, _tailthr (1)
 {
 	memset (_inpbuff, 0, MAXINP * sizeof (float*));
 	memset (_outbuff, 0, MAXOUT * sizeof (float*));
@@ -83,6 +84,16 @@ Convproc::set_options (uint32_t options)
 	_options = options;
 }
 
+void
+Convproc::set_tail_threads (uint32_t nthr)
+{
+	/* Must be called before configure (). The partitions of the
+	 * largest size are split into up to nthr consecutive ranges,
+	 * each processed by a thread of its own.
+	 */
+	_tailthr = (nthr < 1) ? 1 : nthr;
+}
+
 int
 Convproc::configure (uint32_t ninp,
                      uint32_t nout,
@@ -152,6 +163,26 @@ Convproc::configure (uint32_t ninp,
 					npar = nmin;
 				}
 			}
+			if ((pind > 0) && (_tailthr > 1) && (offs + size * npar >= maxsize)) {
+				/* last level: spread its partitions over several threads.
+				 * Each split adds one FFT per input, require at least
+				 * two partitions per thread.
+				 */
+				uint32_t nsplit = _tailthr;
+				if (nsplit > npar / 2) {
+					nsplit = npar / 2;
+				}
+				if (nsplit > MAXLEV - pind) {
+					nsplit = MAXLEV - pind;
+				}
+				for (i = 1; i < nsplit; i++, pind++) {
+					uint32_t n = npar / (nsplit - i + 1);
+					_convlev[pind] = new Convlevel ();
+					_convlev[pind]->configure (prio, offs, n, size, _options);
+					offs += size * n;
+					npar -= n;
+				}
+			}
 			_convlev[pind] = new Convlevel ();
 			_convlev[pind]->configure (prio, offs, npar, size, _options);
 			offs += size * npar;
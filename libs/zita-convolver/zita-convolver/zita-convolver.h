@@ -345,7 +345,7 @@ public:
 	enum {
 		MAXINP   = 64,
 		MAXOUT   = 64,
-		MAXLEV   = 8,
+		MAXLEV   = 16,
 		MINPART  = 64,
 		MAXPART  = 8192,
 		MAXDIVIS = 16,
@@ -388,6 +388,8 @@ public:
 
 	void set_options (uint32_t options);
 
+	void set_tail_threads (uint32_t nthr);
+
 	int reset (void);
 
 	int start_process (int abspri, int policy);
@@ -419,6 +421,7 @@ private:
 	uint32_t   _nlevels;         // number of partition sizes
 	uint32_t   _inpsize;         // size of input buffers
 	uint32_t   _latecnt;         // count of cycles ending too late
+	uint32_t   _tailthr;         // max. number of threads for the last partition size
 	Convlevel* _convlev[MAXLEV]; // array of processors
 	void*      _dummy[64];
 
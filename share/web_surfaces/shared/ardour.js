@@ -17,7 +17,7 @@
  */
 
 import { Component } from './base/component.js';
-import { StateNode } from './base/protocol.js';
+import { Message, StateNode } from './base/protocol.js';
 import MessageChannel from './base/channel.js';
 import Mixer from './components/mixer.js';
 import Transport from './components/transport.js';
@@ -40,6 +40,8 @@ export default class ArdourClient extends Component {
 		}
 
 		this._autoReconnect = getOption(options, 'autoReconnect', true);
+		this._batch = getOption(options, 'batch', true);
+		this._strips = [];
 		this._connected = false;
 
 		this.channel.onMessage = (msg, inbound) => this._handleMessage(msg, inbound);
@@ -87,6 +89,17 @@ export default class ArdourClient extends Component {
 		return await this.channel.sendAndReceive(msg);
 	}
 
+	// Only receive feedback for the given strip ids, an empty list means all
+	// strips. Meters of strips nobody watches are not polled by the server.
+
+	watchStrips (stripIds) {
+		this._strips = stripIds || [];
+
+		if (this._connected) {
+			this.send(new Message(StateNode.FEEDBACK_STRIPS, [], this._strips));
+		}
+	}
+
 	// Surface metadata API goes over HTTP
 
 	async getAvailableSurfaces () {
@@ -125,6 +138,15 @@ export default class ArdourClient extends Component {
 
 	async _connect () {
 		await this.channel.open();
+
+		if (this._batch) {
+			this.send(new Message(StateNode.FEEDBACK_BATCH, [], [true]));
+		}
+
+		if (this._strips.length > 0) {
+			this.send(new Message(StateNode.FEEDBACK_STRIPS, [], this._strips));
+		}
+
 		this._setConnected(true);
 	}
 
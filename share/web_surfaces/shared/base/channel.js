@@ -35,13 +35,13 @@ export default class MessageChannel {
 			this._socket.onerror = (error) => this.onError(error);
 
 			this._socket.onmessage = (event) => {
-				const msg = Message.fromJsonText(event.data);
-
-				if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
-					this._pending.resolve(msg);
-					this._pending = null;
-				} else {
-					this.onMessage(msg, true);
+				for (const msg of Message.fromJsonFrame(event.data)) {
+					if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
+						this._pending.resolve(msg);
+						this._pending = null;
+					} else {
+						this.onMessage(msg, true);
+					}
 				}
 			};
 
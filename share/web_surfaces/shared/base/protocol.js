@@ -31,7 +31,9 @@ export const StateNode = Object.freeze({
 	TRANSPORT_TEMPO                : 'transport_tempo',
 	TRANSPORT_TIME                 : 'transport_time',
 	TRANSPORT_ROLL                 : 'transport_roll',
-	TRANSPORT_RECORD               : 'transport_record'
+	TRANSPORT_RECORD               : 'transport_record',
+	FEEDBACK_BATCH                 : 'feedback_batch',
+	FEEDBACK_STRIPS                : 'feedback_strips'
 });
 
 export class Message {
@@ -61,6 +63,17 @@ export class Message {
 		return new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val);
 	}
 
+	// A frame holds either a single message or, in batch mode, an array of them
+	static fromJsonFrame (jsonText) {
+		let rawFrame = JSON.parse(jsonText);
+
+		if (!Array.isArray(rawFrame)) {
+			rawFrame = [rawFrame];
+		}
+
+		return rawFrame.map(rawMsg => new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val || []));
+	}
+
 	toJsonText () {
 		let val = [];
 
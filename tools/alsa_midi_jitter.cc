@@ -0,0 +1,245 @@
+/* g++ -O2 -o alsa_midi_jitter alsa_midi_jitter.cc ../libs/backends/alsa/alsa_midi.cc ../libs/backends/alsa/alsa_midi_reactor.cc ../libs/backends/alsa/alsa_rawmidi.cc ../libs/backends/alsa/alsa_sequencer.cc -I../libs/backends/alsa -I../libs/ardour -I../libs/pbd -I../libs/temporal -I../libs/evoral -I../build/libs/pbd -I../build/libs/ardour -DPACKAGE=\"alsa-backend\" `pkg-config --cflags --libs alsa glibmm-2.4` -L../build/libs/pbd -lpbd -lpthread */
+
+/* Measure the latency and jitter of MIDI events sent and received through
+ * the ALSA backend's MIDI I/O, using a loopback.
+ *
+ * The process callback of the backend is emulated: every period, one
+ * event per output device is queued at a random offset in the period,
+ * and incoming events are collected at the start of the next period.
+ * The difference between scheduled and received time includes
+ * the quantization to audio samples.
+ *
+ * Sequencer loopback (snd-seq-dummy, "Midi Through"):
+ *   alsa_midi_jitter -s -o 14:0 -i 14:0 -n 8
+ *
+ * Raw MIDI loopback (snd-virmidi, connect the two virtual devices):
+ *   modprobe snd-virmidi
+ *   aconnect 'Virtual Raw MIDI 1-0' 'Virtual Raw MIDI 1-1'
+ *   alsa_midi_jitter -o hw:1,0 -i hw:1,1
+ */
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <glib.h>
+
+#include "alsa_rawmidi.h"
+#include "alsa_sequencer.h"
+
+using namespace ARDOUR;
+
+static void
+usage ()
+{
+	fprintf (stderr, "alsa_midi_jitter [ -s ] -o OUTPUT -i INPUT [ -n OUTPUTS ] [ -r RATE ] [ -p PERIOD ] [ -d DURATION ]\n");
+	fprintf (stderr, "  -s           use the ALSA sequencer (default: raw MIDI devices)\n");
+	fprintf (stderr, "  -o OUTPUT    device (raw: hw:X,Y, seq: client:port) to send to\n");
+	fprintf (stderr, "  -i INPUT     device to receive from, connected to OUTPUT\n");
+	fprintf (stderr, "  -n OUTPUTS   number of output devices to open, 1 .. 2032 (default 1)\n");
+	fprintf (stderr, "  -r RATE      emulated sample-rate (default 48000)\n");
+	fprintf (stderr, "  -p PERIOD    emulated period-size (default 256)\n");
+	fprintf (stderr, "  -d DURATION  seconds to run (default 10)\n");
+}
+
+int
+main (int argc, char** argv)
+{
+	bool        seq      = false;
+	const char* out_dev  = 0;
+	const char* in_dev   = 0;
+	uint32_t    n_out    = 1;
+	uint32_t    rate     = 48000;
+	uint32_t    period   = 256;
+	float       duration = 10;
+	int         c;
+
+	while ((c = getopt (argc, argv, "so:i:n:r:p:d:h")) != -1) {
+		switch (c) {
+			case 's':
+				seq = true;
+				break;
+			case 'o':
+				out_dev = optarg;
+				break;
+			case 'i':
+				in_dev = optarg;
+				break;
+			case 'n':
+				n_out = atoi (optarg);
+				break;
+			case 'r':
+				rate = atoi (optarg);
+				break;
+			case 'p':
+				period = atoi (optarg);
+				break;
+			case 'd':
+				duration = atof (optarg);
+				break;
+			case 'h':
+				usage ();
+				return 0;
+			default:
+				usage ();
+				return 1;
+		}
+	}
+
+	if (!out_dev || !in_dev || n_out < 1 || n_out > 16 * 127 || rate < 8000 || period < 16 || duration <= 0) {
+		usage ();
+		return 1;
+	}
+
+	/* like the backend's process thread */
+	struct sched_param sp;
+	sp.sched_priority = sched_get_priority_max (SCHED_FIFO) - 10;
+	if (pthread_setschedparam (pthread_self (), SCHED_FIFO, &sp)) {
+		fprintf (stderr, "Note: cannot use realtime scheduling\n");
+	}
+
+	AlsaMidiIn* in;
+	if (seq) {
+		in = new AlsaSeqMidiIn ("in", in_dev);
+	} else {
+		in = new AlsaRawMidiIn ("in", in_dev);
+	}
+	if (in->state ()) {
+		fprintf (stderr, "Cannot open input '%s'\n", in_dev);
+		return 1;
+	}
+
+	std::vector<AlsaMidiOut*> outs;
+	for (uint32_t n = 0; n < n_out; ++n) {
+		AlsaMidiOut* out;
+		if (seq) {
+			out = new AlsaSeqMidiOut ("out", out_dev);
+		} else {
+			out = new AlsaRawMidiOut ("out", out_dev);
+		}
+		if (out->state ()) {
+			fprintf (stderr, "Cannot open output '%s' (#%d)\n", out_dev, n + 1);
+			return 1;
+		}
+		outs.push_back (out);
+	}
+
+	double const   sample_us = 1e6 / rate;
+	uint64_t const period_us = period * sample_us;
+	uint64_t       now       = g_get_monotonic_time ();
+
+	in->setup_timing (period, rate);
+	in->sync_time (now);
+	if (in->start ()) {
+		fprintf (stderr, "Cannot start input\n");
+		return 1;
+	}
+	for (std::vector<AlsaMidiOut*>::const_iterator o = outs.begin (); o != outs.end (); ++o) {
+		(*o)->setup_timing (period, rate);
+		(*o)->sync_time (now);
+		if ((*o)->start ()) {
+			fprintf (stderr, "Cannot start output\n");
+			return 1;
+		}
+	}
+
+	/* time each event was scheduled for, indexed by [output][note] */
+	std::vector<uint64_t> sched (n_out * 128, 0);
+
+	uint64_t const cycles = duration * 1e6 / period_us;
+	uint64_t       n_sent = 0;
+	uint64_t       n_recv = 0;
+	double         sum    = 0;
+	double         sum2   = 0;
+	double         lmin   = 1e9;
+	double         lmax   = -1e9;
+	uint8_t        note   = 0;
+
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+
+	for (uint64_t cycle = 0; cycle < cycles; ++cycle) {
+		/* wait for the next period */
+		ts.tv_nsec += period_us * 1000;
+		while (ts.tv_nsec >= 1000000000) {
+			ts.tv_nsec -= 1000000000;
+			++ts.tv_sec;
+		}
+		clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+		/* start of the previous and this period */
+		uint64_t const clock1 = (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+		uint64_t const clock0 = clock1 - period_us;
+
+		/* collect input, relative to the start of the previous period */
+		pframes_t time;
+		uint8_t   data[MaxAlsaMidiEventSize];
+		size_t    size = sizeof (data);
+		while (in->recv_event (time, data, size)) {
+			if (size == 3 && (data[0] & 0xf0) == 0x90 && data[2] > 0) {
+				uint32_t const o = (data[0] & 0x0f) + 16 * (data[2] - 1);
+				uint64_t&      t = sched[(o % n_out) * 128 + data[1]];
+				if (t > 0) {
+					double const lat = clock0 + time * sample_us - (double)t;
+					sum  += lat;
+					sum2 += lat * lat;
+					lmin = std::min (lmin, lat);
+					lmax = std::max (lmax, lat);
+					t    = 0;
+					++n_recv;
+				}
+			}
+			size = sizeof (data);
+		}
+		in->sync_time (clock1);
+
+		/* queue output */
+		note = (note + 1) & 0x7f;
+		for (uint32_t o = 0; o < n_out; ++o) {
+			pframes_t const offset = rand () % period;
+			uint8_t const   ev[3]  = { (uint8_t)(0x90 | (o % 16)), note, (uint8_t)(1 + o / 16) };
+
+			outs[o]->sync_time (clock1);
+			if (outs[o]->send_event (offset, ev, 3) == 0) {
+				sched[o * 128 + note] = clock1 + offset * sample_us;
+				++n_sent;
+			}
+		}
+	}
+
+	/* let the reactor write the remaining output before stopping */
+	g_usleep (100000);
+
+	for (std::vector<AlsaMidiOut*>::const_iterator o = outs.begin (); o != outs.end (); ++o) {
+		(*o)->stop ();
+		delete *o;
+	}
+	in->stop ();
+	delete in;
+
+	printf ("# %s, %d output(s), period %d @ %dHz (%.2f ms), sample %.1f us\n",
+	        seq ? "sequencer" : "raw MIDI", n_out, period, rate, period_us / 1e3, sample_us);
+
+	if (n_recv == 0) {
+		printf ("No events received, check the loopback connection.\n");
+		return 1;
+	}
+
+	double const avg = sum / n_recv;
+	double const dev = sqrt (std::max (0.0, sum2 / n_recv - avg * avg));
+
+	printf ("sent: %lu  received: %lu  lost: %lu\n",
+	        (unsigned long)n_sent, (unsigned long)n_recv, (unsigned long)(n_sent - n_recv));
+	printf ("latency [us]  min: %.1f  max: %.1f  avg: %.1f  jitter (stddev): %.1f  (p-p): %.1f\n",
+	        lmin, lmax, avg, dev, lmax - lmin);
+	return 0;
+}
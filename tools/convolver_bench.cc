@@ -0,0 +1,182 @@
+/* g++ -O3 -o convolver_bench convolver_bench.cc ../libs/zita-convolver/zita-convolver.cc -I../libs/zita-convolver -DENABLE_VECTOR_MODE `pkg-config --cflags --libs fftw3f` -lpthread */
+
+/* Benchmark ArdourZita::Convproc over IR lengths, channel counts and
+ * the number of threads used for the longest partitions.
+ *
+ * Audio is processed back-to-back as fast as possible. Since the caller
+ * waits for background partitions that did not complete in time, the
+ * realtime factor is bounded by the slowest thread, while "worst" is the
+ * longest time a single process() call blocked the calling (RT) thread.
+ */
+
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <getopt.h>
+#include <sched.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "zita-convolver/zita-convolver.h"
+
+using namespace ArdourZita;
+
+static double
+now ()
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void
+usage ()
+{
+	fprintf (stderr, "convolver_bench [ -r RATE ] [ -q QUANTUM ] [ -t THREADS ] [ -d DURATION ] [ -x ]\n");
+	fprintf (stderr, "  -r RATE      sample-rate (default 48000)\n");
+	fprintf (stderr, "  -q QUANTUM   head partition size, 64 .. 1024 (default 64)\n");
+	fprintf (stderr, "  -t THREADS   max. number of tail threads to test (default 4)\n");
+	fprintf (stderr, "  -d DURATION  seconds of audio to process per run (default 10)\n");
+	fprintf (stderr, "  -x           full N x N IR matrix instead of one IR per channel\n");
+}
+
+static int
+run (uint32_t rate, uint32_t quantum, uint32_t n_chn, float ir_sec, uint32_t n_thr, float duration, bool matrix)
+{
+	Convproc cp;
+	uint32_t ir_len = ir_sec * rate;
+
+	/* keep running when background threads fall behind */
+	cp.set_options (Convproc::OPT_LATE_CONTIN);
+	cp.set_tail_threads (n_thr);
+
+	if (cp.configure (n_chn, n_chn, ir_len, quantum, quantum, Convproc::MAXPART, 0)) {
+		fprintf (stderr, "Convproc::configure failed\n");
+		return -1;
+	}
+
+	std::vector<float> ir (ir_len);
+	srand (ir_len);
+	for (uint32_t i = 0; i < ir_len; ++i) {
+		/* noise with exponential decay */
+		ir[i] = (rand () / (float)RAND_MAX - .5f) * expf (-6.9f * i / ir_len);
+	}
+
+	for (uint32_t i = 0; i < n_chn; ++i) {
+		for (uint32_t o = 0; o < n_chn; ++o) {
+			if (!matrix && i != o) {
+				continue;
+			}
+			if (cp.impdata_create (i, o, 1, &ir[0], 0, ir_len)) {
+				fprintf (stderr, "Convproc::impdata_create failed\n");
+				return -1;
+			}
+		}
+	}
+
+	/* no realtime privileges required */
+	if (cp.start_process (0, SCHED_OTHER)) {
+		fprintf (stderr, "Convproc::start_process failed\n");
+		return -1;
+	}
+
+	uint64_t const cycles = duration * rate / quantum;
+	double         worst  = 0;
+	uint32_t       late   = 0;
+
+	double const t0 = now ();
+
+	for (uint64_t c = 0; c < cycles; ++c) {
+		for (uint32_t i = 0; i < n_chn; ++i) {
+			float* in = cp.inpdata (i);
+			for (uint32_t s = 0; s < quantum; ++s) {
+				in[s] = rand () / (float)RAND_MAX - .5f;
+			}
+		}
+		double const t1 = now ();
+		if (cp.process () & Convproc::FL_LATE) {
+			++late;
+		}
+		double const dt = now () - t1;
+		if (dt > worst) {
+			worst = dt;
+		}
+	}
+
+	double const elapsed = now () - t0;
+
+	cp.stop_process ();
+	cp.cleanup ();
+
+	double const budget = quantum / (double)rate;
+
+	printf ("%6.1fs  %3d  %3d  %8.2f  %8.3f  %6.1f%%  %6d\n",
+	        ir_sec, n_chn, n_thr,
+	        duration / elapsed,
+	        worst * 1e3, 100. * worst / budget,
+	        late);
+	fflush (stdout);
+	return 0;
+}
+
+int
+main (int argc, char** argv)
+{
+	uint32_t rate     = 48000;
+	uint32_t quantum  = 64;
+	uint32_t max_thr  = 4;
+	float    duration = 10;
+	bool     matrix   = false;
+	int      c;
+
+	while ((c = getopt (argc, argv, "r:q:t:d:xh")) != -1) {
+		switch (c) {
+			case 'r':
+				rate = atoi (optarg);
+				break;
+			case 'q':
+				quantum = atoi (optarg);
+				break;
+			case 't':
+				max_thr = atoi (optarg);
+				break;
+			case 'd':
+				duration = atof (optarg);
+				break;
+			case 'x':
+				matrix = true;
+				break;
+			case 'h':
+				usage ();
+				return 0;
+			default:
+				usage ();
+				return 1;
+		}
+	}
+
+	if (rate < 8000 || quantum < 64 || quantum > 1024 || (quantum & (quantum - 1)) || max_thr < 1 || duration <= 0) {
+		usage ();
+		return 1;
+	}
+
+	static const float    ir_lengths[] = { 0.5, 2, 6, 10 };
+	static const uint32_t channels[]   = { 1, 2, 4, 8 };
+
+	printf ("# rate: %d, quantum: %d (%.2f ms), %s IR\n", rate, quantum, 1e3 * quantum / rate, matrix ? "N x N" : "1 per channel");
+	printf ("#   IR  chn  thr  realtime  worst[ms]  budget    late\n");
+
+	for (size_t l = 0; l < sizeof (ir_lengths) / sizeof (float); ++l) {
+		for (size_t n = 0; n < sizeof (channels) / sizeof (uint32_t); ++n) {
+			for (uint32_t t = 1; t <= max_thr; t *= 2) {
+				if (run (rate, quantum, channels[n], ir_lengths[l], t, duration, matrix)) {
+					return 1;
+				}
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,285 @@
+/* g++ -O2 -o readahead_test readahead_test.cc -lpthread -lm */
+
+/* Measure how long it takes to refill the playback buffers of many tracks
+ * after a locate, with and without read-ahead (see ARDOUR::ReadAhead).
+ *
+ * Every file is one track. For each locate, a random position is chosen,
+ * and the butler's complete refill is emulated: tracks are read one after
+ * another, in chunks. With -a, the ranges of all tracks are first sorted
+ * by file and offset, merged, and passed to posix_fadvise (WILLNEED) by a
+ * pool of threads, before the same reads are done.
+ *
+ * Unless -c is given, the files are evicted from the page-cache before
+ * each locate (POSIX_FADV_DONTNEED, no root permissions needed).
+ *
+ * Test files can be created using run-threadreadtest.sh, e.g.
+ *   ./readahead_test -q /tmp/readtest_1234/testfile_%d
+ *   ./readahead_test -q -a /tmp/readtest_1234/testfile_%d
+ */
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+
+struct File {
+	int      fd;
+	uint64_t ino;
+	off_t    size;
+};
+
+struct Range {
+	int      fd;
+	uint64_t ino;
+	off_t    offset;
+	off_t    len;
+
+	bool operator< (Range const& other) const {
+		if (ino != other.ino) {
+			return ino < other.ino;
+		}
+		return offset < other.offset;
+	}
+};
+
+static double
+now ()
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+advise (std::vector<Range> const& ranges, size_t first, size_t step)
+{
+	for (size_t n = first; n < ranges.size (); n += step) {
+#ifdef __linux__
+		posix_fadvise (ranges[n].fd, ranges[n].offset, ranges[n].len, POSIX_FADV_WILLNEED);
+#elif defined __APPLE__
+		struct radvisory ra;
+		ra.ra_offset = ranges[n].offset;
+		ra.ra_count  = std::min<off_t> (ranges[n].len, INT_MAX);
+		fcntl (ranges[n].fd, F_RDADVISE, &ra);
+#endif
+	}
+}
+
+static void
+read_ahead (std::vector<Range>& ranges, int nthreads)
+{
+	std::sort (ranges.begin (), ranges.end ());
+
+	/* merge nearby ranges, like ReadAhead::commit() */
+	std::vector<Range> merged;
+	for (std::vector<Range>::const_iterator i = ranges.begin (); i != ranges.end (); ++i) {
+		if (!merged.empty () && merged.back ().fd == i->fd && i->offset <= merged.back ().offset + merged.back ().len + 65536) {
+			merged.back ().len = std::max (merged.back ().offset + merged.back ().len, i->offset + i->len) - merged.back ().offset;
+		} else {
+			merged.push_back (*i);
+		}
+	}
+
+	if (nthreads < 2) {
+		advise (merged, 0, 1);
+		return;
+	}
+
+	std::vector<std::thread> threads;
+	for (int n = 0; n < nthreads; ++n) {
+		threads.push_back (std::thread (advise, std::cref (merged), n, nthreads));
+	}
+	for (auto& t : threads) {
+		t.join ();
+	}
+}
+
+static void
+usage ()
+{
+	fprintf (stderr, "readahead_test [ -a ] [ -c ] [ -b BUFSIZE ] [ -k CHUNKSIZE ] [ -n NTHREADS ] [ -r LOCATES ] [ -l FILELIMIT ] [ -q ] filename-template\n");
+	fprintf (stderr, "  -a            use read-ahead\n");
+	fprintf (stderr, "  -c            keep the page-cache between locates\n");
+	fprintf (stderr, "  -b BUFSIZE    bytes to read per track for each locate (default 960000, 5 sec @ 48kHz)\n");
+	fprintf (stderr, "  -k CHUNKSIZE  bytes per read (default 262144)\n");
+	fprintf (stderr, "  -n NTHREADS   read-ahead threads (default 4)\n");
+	fprintf (stderr, "  -r LOCATES    number of locates (default 10)\n");
+	fprintf (stderr, "  -l FILELIMIT  use at most FILELIMIT files\n");
+}
+
+int
+main (int argc, char* argv[])
+{
+	bool        use_read_ahead = false;
+	bool        keep_cache     = false;
+	off_t       buf_size       = 960000;
+	size_t      chunk_size     = 262144;
+	int         nthreads       = 4;
+	int         locates        = 10;
+	int         max_files      = -1;
+	int         quiet          = 0;
+	char const* name_template  = 0;
+	int         c;
+
+	while ((c = getopt (argc, argv, "acb:k:n:r:l:qh")) != -1) {
+		switch (c) {
+			case 'a':
+				use_read_ahead = true;
+				break;
+			case 'c':
+				keep_cache = true;
+				break;
+			case 'b':
+				buf_size = atoll (optarg);
+				break;
+			case 'k':
+				chunk_size = atoi (optarg);
+				break;
+			case 'n':
+				nthreads = atoi (optarg);
+				break;
+			case 'r':
+				locates = atoi (optarg);
+				break;
+			case 'l':
+				max_files = atoi (optarg);
+				break;
+			case 'q':
+				quiet = 1;
+				break;
+			default:
+				usage ();
+				return 0;
+		}
+	}
+
+	if (optind < argc) {
+		name_template = argv[optind];
+	} else {
+		usage ();
+		return 1;
+	}
+
+	if (buf_size <= 0 || chunk_size == 0 || locates < 1) {
+		usage ();
+		return 1;
+	}
+
+	std::vector<File> files;
+
+	while (max_files < 0 || (int)files.size () < max_files) {
+		char path[PATH_MAX + 1];
+		snprintf (path, sizeof (path), name_template, (int)files.size () + 1);
+
+		int fd = open (path, O_RDONLY);
+		if (fd < 0) {
+			break;
+		}
+
+		struct stat s;
+		if (fstat (fd, &s) || s.st_size < buf_size) {
+			fprintf (stderr, "file is shorter than the buffer-size: %s\n", path);
+			return 1;
+		}
+
+		File f;
+		f.fd   = fd;
+		f.ino  = s.st_ino;
+		f.size = s.st_size;
+		files.push_back (f);
+	}
+
+	if (files.empty ()) {
+		fprintf (stderr, "No matching files found for %s\n", name_template);
+		return 1;
+	}
+
+	if (!quiet) {
+		printf ("# Discovered %d files using %s\n", (int)files.size (), name_template);
+		printf ("# %s, %lld bytes per track, %d locates\n", use_read_ahead ? "read-ahead" : "no read-ahead", (long long)buf_size, locates);
+	}
+
+	/* the same locate positions for every run */
+	srand (1);
+
+	char*  data = (char*)malloc (chunk_size);
+	double tmin = 1e9;
+	double tmax = 0;
+	double tsum = 0;
+
+	for (int l = 0; l < locates; ++l) {
+		/* relative position of the locate in all files, as in a session
+		 * where all tracks are recorded at the same time.
+		 */
+		double const pos = rand () / (double)RAND_MAX;
+
+		if (!keep_cache) {
+			for (auto const& f : files) {
+#ifdef __linux__
+				posix_fadvise (f.fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+			}
+		}
+
+		double const start = now ();
+
+		if (use_read_ahead) {
+			std::vector<Range> ranges;
+			for (auto const& f : files) {
+				Range r;
+				r.fd     = f.fd;
+				r.ino    = f.ino;
+				r.offset = (off_t)(pos * (f.size - buf_size));
+				r.len    = buf_size;
+				ranges.push_back (r);
+			}
+			read_ahead (ranges, nthreads);
+		}
+
+		/* the butler's refill: one track after another */
+		for (auto const& f : files) {
+			off_t const offset = (off_t)(pos * (f.size - buf_size));
+			for (off_t o = 0; o < buf_size; o += chunk_size) {
+				size_t const len = std::min<off_t> (chunk_size, buf_size - o);
+				if (pread (f.fd, data, len, offset + o) != (ssize_t)len) {
+					fprintf (stderr, "read error: %s\n", strerror (errno));
+					return 1;
+				}
+			}
+		}
+
+		double const elapsed = now () - start;
+
+		if (!quiet) {
+			printf ("# locate %d to %.3f: %.3f sec, %.2f MB/sec\n", l + 1, pos, elapsed, files.size () * buf_size / 1048576.0 / elapsed);
+		}
+
+		tmin = std::min (tmin, elapsed);
+		tmax = std::max (tmax, elapsed);
+		tsum += elapsed;
+	}
+
+	double const avg = tsum / locates;
+
+	printf ("# Locate time Min: %.3f sec Avg: %.3f sec Max: %.3f sec  || Avg: %.2f MB/sec\n", tmin, avg, tmax, files.size () * buf_size / 1048576.0 / avg);
+	printf ("%d %d %.4f %.4f %.4f\n", (int)files.size (), use_read_ahead ? nthreads : 0, tmin, avg, tmax);
+
+	free (data);
+	for (auto const& f : files) {
+		close (f.fd);
+	}
+	return 0;
+}